@@ -19,6 +19,10 @@
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsManager.h"
 
+// C/C++ include files
+#include <atomic>
+#include <shared_mutex>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -44,6 +48,14 @@ namespace dd4hep {
      *  ConditionResolver interface in order to allow for upgrades of
      *  this implementation which might not be polymorph.
      *
+     *  If the first pass is invoked with more than one thread, the
+     *  dependency graph of the work items is levelled once and the
+     *  callbacks of every level are executed in parallel (using TBB if
+     *  available). In this mode all conditions accessed by a callback
+     *  must be declared as dependencies: access to another item being
+     *  worked on, which is not yet resolved, is an error.
+     *  Circular dependencies are reported as in the serial mode.
+     *
      *  \author  M.Frank
      *  \version 1.0
      */
@@ -105,13 +117,25 @@ namespace dd4hep {
       Work*                       m_block = 0;
       /// Current item of the block
       Work*                       m_currentWork = 0;
+      /// Flag to indicate that the callbacks are executed by several threads
+      bool                        m_parallel = false;
+      /// Lock to protect the user pool while callbacks execute in parallel
+      std::shared_timed_mutex     m_poolLock;
     public:
       /// Number of callbacks to the handler for monitoring
-      mutable size_t              num_callback;
+      mutable std::atomic<size_t> num_callback;
 
     protected:
+      /// Access the item currently worked on by the calling thread
+      Work*& currentWork();
+      /// Check if the calling thread resolves conditions: bulk accesses are allowed
+      bool resolving();
       /// Internal call to trigger update callback
       void do_callback(Work* dep);
+      /// Level the work items according to their declared dependencies
+      bool make_levels(std::vector<std::vector<Work*> >& levels)  const;
+      /// Parallel execution of the first pass
+      void compute_parallel(const std::vector<std::vector<Work*> >& levels, size_t num_threads);
 
     public:
       /// Initializing constructor
@@ -125,7 +149,8 @@ namespace dd4hep {
       /// Access the conditions created during processing
       //const CreatedConditions& created()  const                  { return m_created;         }
       /// 1rst pass: Compute/create the missing conditions
-      void compute();
+      /** If num_threads > 1 independent callbacks are executed in parallel. */
+      void compute(size_t num_threads = 0);
       /// 2nd pass:  Handler callback for the second turn to resolve missing dependencies
       void resolve();
 
@@ -18,7 +18,11 @@
 
 // C/C++ include files
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <vector>
+#include <shared_mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -31,6 +35,28 @@ namespace dd4hep {
      *  Purely internal class to the conditions manager implementation.
      *  Not at all to be accessed by clients!
      *
+     *  The pool elements are protected by a read-write lock:
+     *  the select calls take a shared lock and may run concurrently
+     *  from several threads. The conditions manager takes the exclusive
+     *  lock whenever pools or conditions are added or cleaned.
+     *  User pools, which have to load or compute missing conditions,
+     *  serialize these updates with the update lock and select again
+     *  before doing the work: conditions added by another thread in
+     *  the meantime are then picked up rather than created twice.
+     *  The update lock is not recursive: the update callbacks of derived
+     *  conditions must not load or compute conditions of the same IOV type.
+     *  The user pool refuses such calls from the thread holding the lock.
+     *  With parallel computation a worker thread would deadlock.
+     *
+     *  The IOV selections are served by an interval tree index:
+     *  a balanced binary tree of the elements ordered by their IOV key,
+     *  where every node holds the maximal upper IOV bound of its subtree.
+     *  addElement() inserts in O(log(n)), all pools containing a given
+     *  IOV are found in O(log(n) + k).
+     *  Pools must be added using addElement() to be indexed.
+     *  The aging of pools not selected is accounted lazily: the pool's
+     *  age_value is brought up to date before any cleanup.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -41,17 +67,65 @@ namespace dd4hep {
       typedef std::shared_ptr<ConditionsPool> Element;
       /// Shortcut name for the actual conditions container
       typedef std::map<IOV::Key, Element >    Elements;      
+      /// Read-write lock type protecting the pool elements
+      typedef std::shared_timed_mutex         Mutex;
+      /// Shared lock for read access
+      typedef std::shared_lock<Mutex>         ReadLock;
+      /// Exclusive lock for write access
+      typedef std::unique_lock<Mutex>         WriteLock;
 
       /// Container of IOV dependent conditions pools
       Elements elements;     //! Not ROOT persistent
       /// Reference to the IOV container
       const IOVType* type;   //! Not ROOT persistent
+      /// Read-write lock protecting the elements
+      mutable Mutex  lock;   //! Not ROOT persistent
+      /// Lock serializing user pools adding loaded or derived conditions
+      std::mutex     updateLock; //! Not ROOT persistent
+
+    protected:
+      /// Node of the interval tree index
+      struct IndexNode  {
+        /// Pool element of the node
+        const Elements::value_type* entry;
+        /// Maximal upper IOV bound of the subtree
+        IOV::Key_second_type        upper;
+        /// Left and right subtrees (-1: none)
+        int                         left   = -1, right = -1;
+        /// Height of the subtree
+        int                         height = 1;
+      };
+      /// Nodes of the interval tree index
+      std::vector<IndexNode>                   m_index;      //! Not ROOT persistent
+      /// Root node of the interval tree index (-1: empty)
+      int                                      m_root = -1;  //! Not ROOT persistent
+      /// Number of selections changing the pool age
+      std::atomic<int>                         m_selections; //! Not ROOT persistent
+
+      /// Update height and upper IOV bound of an index node from its subtrees
+      void updateNode(int node);
+      /// Restore the balance of an index subtree. Returns the new subtree root
+      int balanceNode(int node);
+      /// Insert a node into an index subtree. Returns the new subtree root
+      int insertNode(int node, int item);
+      /// Build a balanced index subtree from the key ordered nodes [first, last)
+      int buildTree(int first, int last);
+      /// Collect all elements of an index subtree containing the required IOV key
+      void scanTree(int node, const IOV::Key& req_key, std::vector<const Elements::value_type*>& result)  const;
+      /// Rebuild the full index from the elements
+      void rebuildIndex();
+      /// Bring the aging values of all pools up to date
+      void updateAge();
+      /// Access all elements containing the required IOV key in key order
+      void matching(const IOV::Key& req_key, std::vector<const Elements::value_type*>& result)  const;
       
     public:
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
       /// Default destructor
       virtual ~ConditionsIOVPool();
+      /// Add a new pool element and update the index. Caller must hold the write lock.
+      bool addElement(const IOV::Key& key, Element pool);
       /// Retrieve  a condition set given the key according to their validity
       size_t select(Condition::key_type key, const IOV& req_validity, RangeConditions& result);
       /// Retrieve  a condition set given the key according to their validity
@@ -19,6 +19,7 @@
 #include "DDCond/ConditionsManager.h"
 
 // C/C++ include files
+#include <atomic>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -63,8 +64,10 @@ namespace dd4hep {
       };
       /// The IOV of the conditions hosted
       IOV* iov;
-      /// Aging value
-      int  age_value;
+      /// Aging value. Updated by concurrent readers of the IOV pool
+      std::atomic<int> age_value;  //! Not ROOT persistent
+      /// Selection count of the IOV pool when the aging value was last updated (-1: never)
+      std::atomic<int> age_stamp;  //! Not ROOT persistent
 
     public:
       /// Listener invocation when a condition is registered to the cache
@@ -230,6 +233,11 @@ namespace dd4hep {
                         const Condition::Processor& processor) const = 0;
 
       /// Prepare user pool for usage (load, fill etc.) according to required IOV
+      /** Missing conditions are loaded and computed holding the update lock of the IOV pool.
+       *  The update callbacks must not prepare, load or compute conditions of the same
+       *  IOV type: this would deadlock. On the thread holding the lock it is refused
+       *  with an exception, worker threads of a parallel computation would block.
+       */
       virtual ConditionsManager::Result prepare(const IOV&                  required, 
                                                 ConditionsSlice&            slice,
                                                 ConditionUpdateUserContext* user_param = 0) = 0;
@@ -244,9 +252,13 @@ namespace dd4hep {
                                                 ConditionUpdateUserContext* ctxt=0)  = 0;
       
       /// Evaluate and register all derived conditions from the dependency list
+      /** If num_threads > 1 independent derived conditions are computed in parallel.
+       *  Same as for prepare: the callbacks must not re-enter the user pools of this IOV type.
+       */
       virtual size_t compute(const Dependencies& dependencies,
                              ConditionUpdateUserContext* user_param,
-                             bool force) = 0;
+                             bool force,
+                             size_t num_threads = 0) = 0;
     };
   }        /* End namespace cond                     */
 }          /* End namespace dd4hep                   */
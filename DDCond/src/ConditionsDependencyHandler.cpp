@@ -18,10 +18,61 @@
 #include "DD4hep/Printout.h"
 #include "TTimeStamp.h"
 
+// C/C++ include files
+#include <mutex>
+#include <thread>
+#include <exception>
+#if defined(DD4HEP_USE_TBB)
+#include "tbb/tbb.h"
+#endif
+
 using namespace dd4hep;
 using namespace dd4hep::cond;
 
 namespace {
+  typedef ConditionsDependencyHandler::Work Work;
+
+  /// Item worked on by the executing thread in parallel mode
+  thread_local Work* t_currentWork = 0;
+
+  /// Execute a functor for all items of one dependency level using num_threads threads
+  template <typename FUNC> void execute_level(const std::vector<Work*>& items, size_t num_threads, FUNC func)  {
+    if ( num_threads > items.size() ) num_threads = items.size();
+    if ( num_threads < 2 )  {
+      for( Work* w : items ) func(w);
+      return;
+    }
+#if defined(DD4HEP_USE_TBB)
+    tbb::task_arena arena(int(num_threads));
+    arena.execute([&items, &func]  {
+        tbb::parallel_for(size_t(0), items.size(), [&items, &func](size_t i)  { func(items[i]); });
+      });
+#else
+    std::atomic<size_t>      next(0);
+    std::atomic<bool>        failed(false);
+    std::exception_ptr       error;
+    std::mutex               error_lock;
+    std::vector<std::thread> threads;
+    auto worker = [&]  {
+      try  {
+        for( size_t i = next++; i < items.size() && !failed; i = next++ )
+          func(items[i]);
+      }
+      catch(...)  {
+        std::lock_guard<std::mutex> guard(error_lock);
+        if ( !error ) error = std::current_exception();
+        failed = true;
+      }
+    };
+    threads.reserve(num_threads-1);
+    for( size_t i = 1; i < num_threads; ++i )
+      threads.emplace_back(worker);
+    worker();
+    for( auto& t : threads ) t.join();
+    if ( error ) std::rethrow_exception(error);
+#endif
+  }
+
   std::string dependency_name(const ConditionDependency* d)  {
 #ifdef DD4HEP_CONDITIONS_DEBUG
     return d->target.name;
@@ -87,9 +138,106 @@ Detector& ConditionsDependencyHandler::detectorDescription() const  {
   return m_manager->detectorDescription();
 }
 
+/// Access the item currently worked on by the calling thread
+ConditionsDependencyHandler::Work*& ConditionsDependencyHandler::currentWork()   {
+  return m_parallel ? t_currentWork : m_currentWork;
+}
+
+/// Check if the calling thread resolves conditions (2nd pass or resolution in the parallel 1rst pass)
+bool ConditionsDependencyHandler::resolving()   {
+  Work* current = currentWork();
+  return m_state == RESOLVED || (current && current->state == RESOLVED);
+}
+
+/// Level the work items according to their declared dependencies
+bool ConditionsDependencyHandler::make_levels(std::vector<std::vector<Work*> >& levels)  const   {
+  size_t num_work = m_todo.size(), num_levelled = 0;
+  std::vector<size_t> num_deps(num_work, 0);
+  std::vector<std::vector<Work*> > users(num_work);
+  std::vector<Work*> current;
+
+  levels.clear();
+  for( const auto& i : m_todo )   {
+    Work* w = i.second;
+    for( const auto& k : w->context.dependency->dependencies )   {
+      auto j = m_todo.find(k.hash);
+      if ( j != m_todo.end() )   {
+        users[j->second - m_block].emplace_back(w);
+        ++num_deps[w - m_block];
+      }
+    }
+  }
+  for( const auto& i : m_todo )   {
+    if ( 0 == num_deps[i.second - m_block] ) current.emplace_back(i.second);
+  }
+  while( !current.empty() )   {
+    std::vector<Work*> next;
+    for( Work* w : current )   {
+      for( Work* u : users[w - m_block] )   {
+        if ( 0 == --num_deps[u - m_block] ) next.emplace_back(u);
+      }
+    }
+    num_levelled += current.size();
+    levels.emplace_back(std::move(current));
+    current = std::move(next);
+  }
+  // Items left over are part of a dependency cycle
+  return num_levelled == num_work;
+}
+
+/// Parallel execution of the first pass
+void ConditionsDependencyHandler::compute_parallel(const std::vector<std::vector<Work*> >& levels,
+                                                   size_t num_threads)
+{
+  std::vector<char> has_users(m_todo.size(), 0);
+  for( const auto& i : m_todo )   {
+    for( const auto& k : i.second->context.dependency->dependencies )   {
+      auto j = m_todo.find(k.hash);
+      if ( j != m_todo.end() ) has_users[j->second - m_block] = 1;
+    }
+  }
+  m_parallel = true;
+  try  {
+    for( const auto& level : levels )   {
+      execute_level(level, num_threads, [this, &has_users](Work* w)  {
+          Work*& current = t_currentWork;
+          current = 0;
+          if ( !w->condition )  {
+            do_callback(w);
+          }
+          // Items needed by the next levels are resolved right away, exactly like
+          // the serial pass does on first access. Hence the next level only reads.
+          if ( w->condition && w->state == CREATED && has_users[w - m_block] )  {
+            current = w;
+            w->resolve(current);
+            current = 0;
+          }
+        });
+    }
+  }
+  catch(...)  {
+    m_parallel = false;
+    throw;
+  }
+  m_parallel = false;
+}
+
 /// 1rst pass: Compute/create the missing conditions
-void ConditionsDependencyHandler::compute()   {
+void ConditionsDependencyHandler::compute(size_t num_threads)   {
   m_state = CREATED;
+  if ( num_threads > 1 && m_todo.size() > 1 )   {
+    std::vector<std::vector<Work*> > levels;
+    if ( make_levels(levels) )   {
+      TTimeStamp start;
+      compute_parallel(levels, num_threads);
+      TTimeStamp stop;
+      printout(DEBUG,"DependencyHandler","Computed %ld conditions in %ld levels with %ld threads [%7.5f seconds]",
+               m_todo.size(), levels.size(), num_threads, stop.AsDouble()-start.AsDouble());
+      return;
+    }
+    // Circular dependencies: the serial pass below reports the offending item
+    printout(DEBUG,"DependencyHandler","Circular dependencies detected. Fall back to serial processing.");
+  }
   for( const auto& i : m_todo )   {
     if ( !i.second->condition )  {
       do_callback(i.second);
@@ -155,11 +303,15 @@ void ConditionsDependencyHandler::resolve()    {
 
 /// Interface to handle multi-condition inserts by callbacks: One single insert
 bool ConditionsDependencyHandler::registerOne(const IOV& iov, Condition cond)    {
+  std::unique_lock<std::shared_timed_mutex> guard(m_poolLock, std::defer_lock);
+  if ( m_parallel ) guard.lock();
   return m_pool.registerOne(iov, cond);
 }
 
 /// Handle multi-condition inserts by callbacks: block insertions of conditions with identical IOV
 size_t ConditionsDependencyHandler::registerMany(const IOV& iov, const std::vector<Condition>& values)   {
+  std::unique_lock<std::shared_timed_mutex> guard(m_poolLock, std::defer_lock);
+  if ( m_parallel ) guard.lock();
   return m_pool.registerMany(iov, values);
 }
 
@@ -170,7 +322,7 @@ std::vector<Condition> ConditionsDependencyHandler::get(DetElement de)   {
 
 /// Interface to access conditions by hash value of the item (only valid at resolve!)
 std::vector<Condition> ConditionsDependencyHandler::getByItem(Condition::itemkey_type key)   {
-  if ( m_state == RESOLVED )   {
+  if ( resolving() )   {
     struct item_selector {
       std::vector<Condition>  conditions;
       Condition::itemkey_type key;
@@ -182,8 +334,12 @@ std::vector<Condition> ConditionsDependencyHandler::getByItem(Condition::itemkey
       }
     };
     item_selector proc(key);
-    m_pool.scan(conditionsProcessor(proc));
-    for (auto c : proc.conditions ) m_currentWork->do_intersection(c->iov);
+    {
+      std::shared_lock<std::shared_timed_mutex> guard(m_poolLock, std::defer_lock);
+      if ( m_parallel ) guard.lock();
+      m_pool.scan(conditionsProcessor(proc));
+    }
+    for (auto c : proc.conditions ) currentWork()->do_intersection(c->iov);
     return proc.conditions;
   }
   except("ConditionsDependencyHandler",
@@ -193,11 +349,16 @@ std::vector<Condition> ConditionsDependencyHandler::getByItem(Condition::itemkey
 
 /// Interface to access conditions by hash value of the DetElement (only valid at resolve!)
 std::vector<Condition> ConditionsDependencyHandler::get(Condition::detkey_type det_key)   {
-  if ( m_state == RESOLVED )   {
+  if ( resolving() )   {
     ConditionKey::KeyMaker lower(det_key, Condition::FIRST_ITEM_KEY);
     ConditionKey::KeyMaker upper(det_key, Condition::LAST_ITEM_KEY);
-    std::vector<Condition> conditions = m_pool.get(lower.hash, upper.hash);
-    for (auto c : conditions ) m_currentWork->do_intersection(c->iov);
+    std::vector<Condition> conditions;
+    {
+      std::shared_lock<std::shared_timed_mutex> guard(m_poolLock, std::defer_lock);
+      if ( m_parallel ) guard.lock();
+      conditions = m_pool.get(lower.hash, upper.hash);
+    }
+    for (auto c : conditions ) currentWork()->do_intersection(c->iov);
     return conditions;
   }
   except("ConditionsDependencyHandler",
@@ -208,26 +369,39 @@ std::vector<Condition> ConditionsDependencyHandler::get(Condition::detkey_type d
 /// ConditionResolver implementation: Interface to access conditions
 Condition ConditionsDependencyHandler::get(Condition::key_type key, bool throw_if_not)  {
   /// If we are not already resolving here, we follow the normal procedure
-  Condition c = m_pool.get(key);
+  Work*& current = currentWork();
+  Condition c;
+  {
+    std::shared_lock<std::shared_timed_mutex> guard(m_poolLock, std::defer_lock);
+    if ( m_parallel ) guard.lock();
+    c = m_pool.get(key);
+  }
   if ( c.isValid() )  {
-    m_currentWork->do_intersection(c->iov);
+    current->do_intersection(c->iov);
     return c;
   }
   auto i = m_todo.find(key);
   if ( i != m_todo.end() )   {
     Work* w = i->second;
     if ( w->state == RESOLVED )   {
+      // The serial pass resolves these items on first access and intersects the IOV
+      if ( m_parallel ) current->do_intersection(w->iov);
       return w->condition;
     }
+    else if ( m_parallel )   {
+      except("ConditionsDependencyHandler",
+             "Access to undeclared dependency %016lX during parallel processing. "
+             "Declare the dependency or use serial processing.",key);
+    }
     else if ( w->state == CREATED )   {
-      return w->resolve(m_currentWork);
+      return w->resolve(current);
     }
     else if ( w->state == INVALID )  {
       do_callback(w);
       if ( w->condition && w->state == RESOLVED ) // cross-dependencies...
         return w->condition;
       else if ( w->condition )
-        return w->resolve(m_currentWork);
+        return w->resolve(current);
     }
   }
   if ( throw_if_not )  {
@@ -239,9 +413,10 @@ Condition ConditionsDependencyHandler::get(Condition::key_type key, bool throw_i
 /// Internal call to trigger update callback
 void ConditionsDependencyHandler::do_callback(Work* work)   {
   const ConditionDependency* dep = work->context.dependency;
+  Work*& current = currentWork();
   try  {
-    Work* previous  = m_currentWork;
-    m_currentWork   = work;
+    Work* previous  = current;
+    current         = work;
     if ( work->callstack > 0 )   {
       // if we end up here it means a previous construction call never finished
       // because the bugger tried to access another condition, which in turn
@@ -260,7 +435,7 @@ void ConditionsDependencyHandler::do_callback(Work* work)   {
     ++work->callstack;
     work->condition = (*dep->callback)(dep->target, work->context).ptr();
     --work->callstack;
-    m_currentWork   = previous;
+    current         = previous;
     if ( work->condition )  {
       if ( !work->iov )  {
         work->_iov = IOV(m_iovType,IOV::Key(IOV::MIN_KEY, IOV::MAX_KEY));
@@ -20,11 +20,18 @@
 
 #include "DD4hep/detail/ConditionsInterna.h"
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep;
 using namespace dd4hep::cond;
 
+namespace {
+  typedef ConditionsIOVPool::Elements::value_type Entry;
+}
+
 /// Default constructor
-ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
+ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ), m_selections(0)  {
   InstanceCount::increment(this);
 }
 
@@ -39,16 +46,152 @@ ConditionsIOVPool::~ConditionsIOVPool()  {
   InstanceCount::decrement(this);
 }
 
+/// Add a new pool element and update the index. Caller must hold the write lock.
+bool ConditionsIOVPool::addElement(const IOV::Key& key, Element pool)   {
+  auto ret = elements.emplace(key, pool);
+  if ( !ret.second )  {
+    return false;
+  }
+  pool->age_stamp = m_selections.load();
+  if ( m_index.size()+1 == elements.size() )   {
+    const Entry* e = &(*ret.first);
+    m_index.emplace_back(IndexNode {e, e->first.second});
+    m_root = insertNode(m_root, int(m_index.size())-1);
+    return true;
+  }
+  // Elements were added bypassing the index: start from scratch
+  rebuildIndex();
+  return true;
+}
+
+/// Update height and upper IOV bound of an index node from its subtrees
+void ConditionsIOVPool::updateNode(int node)   {
+  IndexNode& n = m_index[node];
+  n.height = 1;
+  n.upper  = n.entry->first.second;
+  for( int child : {n.left, n.right} )   {
+    if ( child >= 0 )  {
+      n.height = std::max(n.height, m_index[child].height+1);
+      n.upper  = std::max(n.upper,  m_index[child].upper);
+    }
+  }
+}
+
+/// Restore the balance of an index subtree. Returns the new subtree root
+int ConditionsIOVPool::balanceNode(int node)   {
+  auto height = [this](int n)  { return n < 0 ? 0 : m_index[n].height; };
+  auto rotate = [this](int n, bool left)  {
+    IndexNode& top = m_index[n];
+    int pivot = left ? top.right : top.left;
+    IndexNode& p = m_index[pivot];
+    if ( left )  { top.right = p.left;  p.left  = n; }
+    else         { top.left  = p.right; p.right = n; }
+    updateNode(n);
+    updateNode(pivot);
+    return pivot;
+  };
+  IndexNode& n = m_index[node];
+  int balance = height(n.left) - height(n.right);
+  if ( balance > 1 )   {
+    const IndexNode& l = m_index[n.left];
+    if ( height(l.left) < height(l.right) ) n.left = rotate(n.left, true);
+    return rotate(node, false);
+  }
+  else if ( balance < -1 )   {
+    const IndexNode& r = m_index[n.right];
+    if ( height(r.right) < height(r.left) ) n.right = rotate(n.right, false);
+    return rotate(node, true);
+  }
+  updateNode(node);
+  return node;
+}
+
+/// Insert a node into an index subtree. Returns the new subtree root
+int ConditionsIOVPool::insertNode(int node, int item)   {
+  if ( node < 0 )  {
+    return item;
+  }
+  if ( m_index[item].entry->first < m_index[node].entry->first )
+    m_index[node].left  = insertNode(m_index[node].left, item);
+  else
+    m_index[node].right = insertNode(m_index[node].right, item);
+  return balanceNode(node);
+}
+
+/// Build a balanced index subtree from the key ordered nodes [first, last)
+int ConditionsIOVPool::buildTree(int first, int last)   {
+  if ( first >= last )  {
+    return -1;
+  }
+  int mid = (first+last)/2;
+  m_index[mid].left  = buildTree(first, mid);
+  m_index[mid].right = buildTree(mid+1, last);
+  updateNode(mid);
+  return mid;
+}
+
+/// Rebuild the full index from the elements
+void ConditionsIOVPool::rebuildIndex()   {
+  int now = m_selections.load();
+  m_index.clear();
+  m_index.reserve(elements.size());
+  for( const auto& e : elements )   {
+    // Pools added bypassing addElement start aging now
+    int never = -1;
+    e.second->age_stamp.compare_exchange_strong(never, now);
+    m_index.emplace_back(IndexNode {&e, e.first.second});
+  }
+  m_root = buildTree(0, int(m_index.size()));
+}
+
+/// Bring the aging values of all pools up to date
+void ConditionsIOVPool::updateAge()   {
+  int now = m_selections.load();
+  for( const auto& e : elements )  {
+    int stamp = e.second->age_stamp.exchange(now);
+    if ( stamp >= 0 ) e.second->age_value += now - stamp;
+  }
+}
+
+/// Collect all elements of an index subtree containing the required IOV key
+void ConditionsIOVPool::scanTree(int node, const IOV::Key& req_key, std::vector<const Entry*>& result)  const   {
+  while ( node >= 0 )   {
+    const IndexNode& n = m_index[node];
+    if ( n.upper < req_key.second )
+      return;
+    scanTree(n.left, req_key, result);
+    // The node and its right subtree have lower bounds >= the node's lower bound
+    if ( n.entry->first.first > req_key.first )
+      return;
+    if ( n.entry->first.second >= req_key.second )
+      result.emplace_back(n.entry);
+    node = n.right;
+  }
+}
+
+/// Access all elements containing the required IOV key in key order
+void ConditionsIOVPool::matching(const IOV::Key& req_key, std::vector<const Entry*>& result)  const   {
+  if ( m_index.size() != elements.size() )   {
+    // Elements were added bypassing the index: linear scan
+    for( const auto& e : elements )  {
+      if ( IOV::key_contains_range(e.first, req_key) )
+        result.emplace_back(&e);
+    }
+    return;
+  }
+  scanTree(m_root, req_key, result);
+}
+
 size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  ReadLock guard(lock);
   if ( !elements.empty() )  {
     size_t len = result.size();
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& e : elements )  {
-      if ( IOV::key_contains_range(e.first, req_key) )  {
-        e.second->select(key, result);
-      }
-    }
+    std::vector<const Entry*> found;
+    matching(req_key, found);
+    for( const auto* e : found )
+      e->second->select(key, result);
     return result.size() - len;
   }
   return 0;
@@ -56,6 +199,7 @@ size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validit
 
 size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  ReadLock guard(lock);
   size_t len = result.size();
   const IOV::Key range = req_validity.key();
   for( const auto& e : elements )  {
@@ -75,8 +219,10 @@ size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_va
 
 /// Invoke cache cleanup with user defined policy
 int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
- Elements rest;
+  WriteLock guard(lock);
+  Elements rest;
   int count = 0;
+  updateAge();
   for( const auto& e : elements )  {
     const ConditionsPool* p = e.second.get();
     if ( cleaner (*p) )   {
@@ -87,13 +233,16 @@ int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
     rest.insert(e);
   }
   elements = std::move(rest);
+  rebuildIndex();
   return count;  
 }
 
 /// Remove all key based pools with an age beyon the minimum age
 int ConditionsIOVPool::clean(int max_age)   {
+  WriteLock guard(lock);
   Elements rest;
   int count = 0;
+  updateAge();
   for( const auto& e : elements )  {
     if ( e.second->age_value >= max_age )   {
       count += e.second->size();
@@ -104,6 +253,7 @@ int ConditionsIOVPool::clean(int max_age)   {
     }
   }
   elements = std::move(rest);
+  rebuildIndex();
   return count;
 }
 
@@ -112,17 +262,18 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
                                  RangeConditions&  valid,
                                  IOV&              cond_validity)
 {
+  ReadLock guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )  {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      num_selected += i.second->select_all(valid);
-      i.second->age_value = 0;
+    std::vector<const Entry*> found;
+    int now = ++m_selections;
+    matching(req_key, found);
+    for( const auto* i : found )  {
+      cond_validity.iov_intersection(i->first);
+      num_selected += i->second->select_all(valid);
+      i->second->age_value = 0;
+      i->second->age_stamp = now;
     }
   }
   return num_selected;
@@ -133,18 +284,19 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
                                  const ConditionsSelect& predicate_processor,
                                  IOV&                    cond_validity)
 {
+  ReadLock guard(lock);
   size_t num_selected = 0, pool_selected = 0;
   if ( !elements.empty() )  {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      pool_selected = i.second->select_all(predicate_processor);
+    std::vector<const Entry*> found;
+    int now = ++m_selections;
+    matching(req_key, found);
+    for( const auto* i : found )  {
+      cond_validity.iov_intersection(i->first);
+      pool_selected = i->second->select_all(predicate_processor);
       num_selected += pool_selected;
-      i.second->age_value = 0;
+      i->second->age_value = 0;
+      i->second->age_stamp = now;
     }
   }
   return num_selected;
@@ -165,14 +317,14 @@ size_t ConditionsIOVPool::select(const IOV& req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, Elements&  valid)
 {
+  ReadLock guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid[i.first] = i.second;
+    std::vector<const Entry*> found;
+    matching(req_key, found);
+    for( const auto* i : found )  {
+      valid[i->first] = i->second;
       ++num_selected;
     }
   }
@@ -194,14 +346,14 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, std::vector<Element>& valid)
 {
+  ReadLock guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid.emplace_back(i.second);
+    std::vector<const Entry*> found;
+    matching(req_key, found);
+    for( const auto* i : found )  {
+      valid.emplace_back(i->second);
       ++num_selected;
     }
   }
@@ -216,11 +216,12 @@ const IOVType* Manager_Type1::iovType (const string& iov_name) const   {
 /// Register IOV with type and key
 ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   // IOV read and checked. Now register it, but always locked!
-  ConditionsIOVPool* pool = m_rawPool[typ.type];
   dd4hep_lock_t lock(m_poolLock);
+  ConditionsIOVPool* pool = m_rawPool[typ.type];
   if ( !pool )  {
     m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
   }
+  ConditionsIOVPool::WriteLock pool_lock(pool->lock);
   ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
   if ( i != pool->elements.end() )   {
     return (*i).second.get();
@@ -230,7 +231,7 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   iov->keyData   = key;
   const void* argv_pool[] = {this, iov, 0};
   shared_ptr<ConditionsPool> cond_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
-  pool->elements.emplace(key,cond_pool);
+  pool->addElement(key,cond_pool);
   printout(INFO,"ConditionsMgr","Created IOV Pool for:%s",iov->str().c_str());
   return cond_pool.get();
 }
@@ -245,7 +246,10 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
   if ( cond.isValid() )  {
     cond->iov  = pool.iov;
     cond->setFlag(Condition::ACTIVE);
-    pool.insert(cond);
+    {
+      ConditionsIOVPool::WriteLock pool_lock(m_rawPool[pool.iov->type]->lock);
+      pool.insert(cond);
+    }
 #if 0
     printout(INFO,"ConditionsMgr","Register condition %016lX %s [%s] IOV:%s",
              cond->hash, cond.name(), cond->address.c_str(), pool.iov->str().c_str());
@@ -264,23 +268,31 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
 /// Register a whole block of conditions with identical IOV.
 size_t Manager_Type1::blockRegister(ConditionsPool& pool, const vector<Condition>& cond) const {
   size_t result = 0;
-  //string typ;
-  for(auto c : cond)   {
-    if ( c.isValid() )    {
+  bool   invalid = false;
+  {
+    ConditionsIOVPool::WriteLock pool_lock(m_rawPool[pool.iov->type]->lock);
+    for(auto c : cond)   {
+      if ( !c.isValid() )    {
+        invalid = true;
+        break;
+      }
       c->iov = pool.iov;
       c->setFlag(Condition::ACTIVE);
       pool.insert(c);
-      //typ = typeName(typeid(*(c.ptr())));
-      //if ( typ.find("Static") != string::npos ) cout << "++Insert:   " << typ << endl;
-      if ( !m_onRegister.empty() )   {
-        __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
-      }
       ++result;
-      continue;
     }
+  }
+   // Listeners are called without holding the pool lock: they may access the pool themselves
+  if ( !m_onRegister.empty() )   {
+    for(size_t i = 0; i < result; ++i)   {
+      Condition c = cond[i];
+      __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
+    }
+  }
+  if ( invalid )   {
     except("ConditionsMgr",
            "+++ Invalid condition objects may not be registered. [%s]",
-           Errors::invalidArg().c_str());    
+           Errors::invalidArg().c_str());
   }
   return result;
 }
@@ -121,7 +121,8 @@ namespace dd4hep {
       /// Evaluate and register all derived conditions from the dependency list
       virtual size_t compute(const Dependencies&         dependencies,
                              ConditionUpdateUserContext* user_param,
-                             bool                        force)  override;
+                             bool                        force,
+                             size_t                      num_threads)  override;
 
       /// Prepare user pool for usage (load, fill etc.) according to required IOV
       virtual ConditionsManager::Result load   (const IOV&              required,
@@ -163,6 +164,8 @@ namespace dd4hep {
 #include "DDCond/ConditionsDependencyHandler.h"
 
 #include <mutex>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 using namespace dd4hep;
@@ -170,6 +173,39 @@ using namespace dd4hep::cond;
 
 namespace {
 
+  /// Update locks of IOV pools held by the calling thread
+  thread_local vector<const mutex*> s_updateLocks;
+
+  /// Update lock of an IOV pool, which refuses re-entrant updates
+  /** Missing conditions are loaded and computed holding the update lock.
+   *  An update callback re-entering the user pool of the same IOV type
+   *  would wait forever for the lock held by its own thread.
+   */
+  class UpdateGuard  {
+    unique_lock<mutex> m_lock;
+  public:
+    /// Initializing constructor. The lock is not yet taken
+    UpdateGuard(mutex& update_lock) : m_lock(update_lock, defer_lock)  {}
+    /// Default destructor. Releases the lock if taken
+    ~UpdateGuard()  {
+      if ( m_lock.owns_lock() ) s_updateLocks.pop_back();
+    }
+    /// Check if the lock is taken
+    bool owns_lock()  const  {
+      return m_lock.owns_lock();
+    }
+    /// Take the lock. Throws exception if the calling thread already holds it
+    void lock()  {
+      const mutex* m = m_lock.mutex();
+      if ( find(s_updateLocks.begin(), s_updateLocks.end(), m) != s_updateLocks.end() )  {
+        except("UserPool","+++ Recursive update of conditions of the same IOV type. "
+               "Update callbacks may not prepare, load or compute conditions of their own IOV type.");
+      }
+      m_lock.lock();
+      s_updateLocks.emplace_back(m);
+    }
+  };
+
   class SimplePrint : public Condition::Processor {
     /// Conditions callback for object processing
     virtual int process(Condition)  const override    { return 1; }
@@ -446,7 +482,8 @@ bool ConditionsMappedUserPool<MAPPING>::remove(Condition::key_type hash_key)
 template<typename MAPPING>
 size_t ConditionsMappedUserPool<MAPPING>::compute(const Dependencies& deps,
                                                   ConditionUpdateUserContext* user_param,
-                                                  bool force)
+                                                  bool force,
+                                                  size_t num_threads)
 {
   if ( !deps.empty() )  {
     Dependencies missing;
@@ -472,10 +509,12 @@ size_t ConditionsMappedUserPool<MAPPING>::compute(const Dependencies& deps,
       missing.emplace(i);
     }
     if ( !missing.empty() )  {
+      UpdateGuard                 update_guard(m_iovPool->updateLock);
+      update_guard.lock();
       ConditionsManagerObject*    m(m_manager.access());
       ConditionsDependencyHandler handler(m, *this, missing, user_param);
       /// 1rst pass: Compute/create the missing condiions
-      handler.compute();
+      handler.compute(num_threads);
       /// 2nd pass:  Resolve missing dependencies
       handler.resolve();
       return handler.num_callback;
@@ -517,35 +556,45 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
-  m_conditions.clear();
-  slice_miss_cond.clear();
-  slice_miss_calc.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  CondMissing cond_missing;
+  CalcMissing calc_missing;
+  CondMissing::iterator last_cond;
+  CalcMissing::iterator last_calc;
+  long num_cond_miss = 0, num_calc_miss = 0;
+
+  // The selection only reads the IOV pools and runs concurrently to other threads.
+  // If conditions must be loaded or computed, the update lock of the IOV pool
+  // is taken and the selection is repeated: another thread may have added
+  // the missing conditions in the meantime.
+  UpdateGuard update_guard(m_iovPool->updateLock);
+  for(;;)  {
+    m_conditions.clear();
+    slice_miss_cond.clear();
+    slice_miss_calc.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+    if ( update_guard.owns_lock() || !do_load || (num_cond_miss == 0 && num_calc_miss == 0) )
+      break;
+    update_guard.lock();
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "%ld conditions out of %ld conditions are MISSING.",
            num_cond_miss, slice_cond.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "%ld derived conditions out of %ld conditions are MISSING.",
            num_calc_miss, slice_calc.size());
@@ -604,7 +653,7 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
       map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
       /// 1rst pass: Compute/create the missing condiions
-      handler.compute();
+      handler.compute(m_manager->numComputeThreads());
       /// 2nd pass:  Resolve missing dependencies
       handler.resolve();
       
@@ -643,24 +692,30 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
-  m_conditions.clear();
-  slice_miss_cond.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  CondMissing cond_missing;
+  CondMissing::iterator last_cond;
+  long num_cond_miss = 0;
+
+  // Concurrent selection. Loading is serialized by the update lock of the
+  // IOV pool, after which the selection is repeated (see prepare).
+  UpdateGuard update_guard(m_iovPool->updateLock);
+  for(;;)  {
+    m_conditions.clear();
+    slice_miss_cond.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+    if ( update_guard.owns_lock() || !do_load || num_cond_miss == 0 )
+      break;
+    update_guard.lock();
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "Found %ld missing conditions out of %ld conditions.",
            num_cond_miss, slice_cond.size());
@@ -715,22 +770,28 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   auto&  slice_miss_calc = slice.missingDerivations();
   bool   do_load         = m_manager->doLoadConditions();
   bool   do_output       = m_manager->doOutputUnloaded();
-  IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
-  slice_miss_calc.clear();
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
+  CalcMissing calc_missing;
+  CalcMissing::iterator last_calc;
+  long num_calc_miss = 0;
+
+  // Derived conditions computed by another thread in the meantime are
+  // added to the user pool by selecting again under the update lock.
+  UpdateGuard update_guard(m_iovPool->updateLock);
+  for(;;)  {
+    slice_miss_calc.clear();
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+    if ( update_guard.owns_lock() || !do_load || num_calc_miss == 0 )
+      break;
+    update_guard.lock();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), m_iov);
+  }
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "Found %ld missing derived conditions out of %ld conditions.",
            num_calc_miss, m_conditions.size());
@@ -748,7 +809,7 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
 
       /// 1rst pass: Compute/create the missing condiions
-      handler.compute();
+      handler.compute(m_manager->numComputeThreads());
       /// 2nd pass:  Resolve missing dependencies
       handler.resolve();
 
@@ -257,6 +257,9 @@ namespace dd4hep {
       /// Hash value
       virtual unsigned long long int hash64()  const override
       {  return detail::typeHash64<Q>();                                       }
+      /// Type of the extension interface
+      virtual const std::type_info& type()  const override
+      {  return typeid(Q);                                                     }
     };
 
     /// Internal call to extend the detector element with an arbitrary structure accessible by the type
@@ -110,9 +110,10 @@ namespace dd4hep {
     }
 
     /// Read compact geometry description or alignment file
-    virtual void fromCompact(const std::string& fname, DetectorBuildType type = BUILD_DEFAULT)   override {
-      fromXML(fname, type);
-    }
+    /** If the environment variable DD4HEP_GEOMETRY_CACHE is set, the fully built
+     *  description is taken from the geometry cache (see GeometryCache).
+     */
+    virtual void fromCompact(const std::string& fname, DetectorBuildType type = BUILD_DEFAULT)   override;
 
     /// Read any XML file
     virtual void fromXML(const std::string& fname, DetectorBuildType type = BUILD_DEFAULT)  override;
@@ -57,6 +57,8 @@ namespace dd4hep {
     virtual ExtensionEntry* clone(void* arg)  const = 0;
     /// Hash value
     virtual unsigned long long int hash64()  const = 0;
+    /// Type of the extension interface (if known)
+    virtual const std::type_info& type()  const  {  return typeid(void);  }
   };
 
   namespace detail  {
@@ -102,6 +104,9 @@ namespace dd4hep {
       /// Hash value
       virtual unsigned long long int hash64()  const override
       {  return detail::typeHash64<Q>();                                       }
+      /// Type of the extension interface
+      virtual const std::type_info& type()  const override
+      {  return typeid(Q);                                                     }
     };
       
     /// Implementation class for the object extension mechanism.
@@ -147,6 +152,9 @@ namespace dd4hep {
       /// Hash value
       virtual unsigned long long int hash64()  const override
       {  return detail::typeHash64<Q>();                                       }
+      /// Type of the extension interface
+      virtual const std::type_info& type()  const override
+      {  return typeid(Q);                                                     }
     };
 
     /// Implementation class for the object extension mechanism.
@@ -192,6 +200,9 @@ namespace dd4hep {
       /// Hash value
       virtual unsigned long long int hash64()  const override
       {  return detail::typeHash64<Q>();                                       }
+      /// Type of the extension interface
+      virtual const std::type_info& type()  const override
+      {  return typeid(Q);                                                     }
     };
   }     // End namespace detail
 }       // End namespace dd4hep
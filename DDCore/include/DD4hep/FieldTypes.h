@@ -17,6 +17,7 @@
 #include "DD4hep/Fields.h"
 #include "DD4hep/Shapes.h"
 #include <vector>
+#include <string>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -162,5 +163,111 @@ namespace dd4hep {
     virtual void fieldComponents(const double* pos, double* field);
   };
 
+  /// Implementation object of a field map given on a regular grid
+  /**
+   *  The field values are defined on the points of a regular grid, either
+   *  in cartesian coordinates (x, y, z) with the field components (Bx, By, Bz)
+   *  or in cylindrical coordinates (r, phi, z) with the field components
+   *  (Br, Bphi, Bz). A cylindrical map with one single point in phi is a
+   *  r-z map. Between the grid points the field is interpolated trilinearly.
+   *  Outside the grid the field map does not contribute. If the phi points
+   *  of a cylindrical map cover the full circle (points * step = 2 pi),
+   *  the cell after the last phi point closes the circle with the first one.
+   *
+   *  The map is read from a binary file, which is memory mapped:
+   *  - a Header structure followed by
+   *  - the field values as 3 floats per grid point.
+   *  The grid points are stored in bricks of 4x4x4 points (768 bytes). The
+   *  8 corners of a cell inside a brick then span at most 264 bytes, i.e.
+   *  about 5 cache lines, instead of 4 rows spread over the whole map.
+   *  Use GridField::write to create the file from field values in natural order.
+   *  Lengths in the file are scaled with lunit, field values with funit.
+   *  With cache_cell set the corner values of the last cell accessed are
+   *  kept per thread, which saves the lookup for consecutive steps of a
+   *  track within the same cell.
+   *  The map data are not ROOT persistent: OverlayedField::compile maps
+   *  the file again after the field is restored from ROOT.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class GridField : public CartesianField::Object {
+  public:
+    /// Coordinate system of the grid
+    enum GridType { CARTESIAN = 0, CYLINDRICAL = 1 };
+    /// Number of grid points per brick and axis
+    enum { BRICK = 4 };
+    /// Header of the field map file
+    struct Header  {
+      char          magic[8];
+      unsigned int  version;
+      unsigned int  grid;
+      unsigned int  points[3];
+      unsigned int  spare;
+      double        lower[3];
+      double        step[3];
+    };
+    /// Grid type
+    int            grid;
+    /// Number of grid points per axis
+    unsigned int   points[3];
+    /// Number of bricks per axis
+    unsigned int   bricks[3];
+    /// First grid point per axis (internal units)
+    double         lower[3];
+    /// Inverse grid spacing per axis (internal units)
+    double         inv_step[3];
+    /// Largest cell coordinate per axis
+    double         last[3];
+    /// Scale factor of the length unit in the file
+    double         lunit;
+    /// Scale factor of the field unit in the file
+    double         funit;
+    /// Position of the map origin
+    Position       offset;
+    /// Name of the field map file
+    std::string    file;
+    /// Field values in brick order
+    const float*   values;          //! Not ROOT persistent: mapped from the file
+    /// Flag to keep the corner values of the last cell accessed per thread
+    bool           cache_cell;
+    /// Flag if the phi points of a cylindrical map cover the full circle
+    bool           periodic_phi;
+
+  protected:
+    /// Memory mapped file
+    void*          m_mapping;       //! Not ROOT persistent
+    /// Size of the memory mapped file
+    std::size_t    m_mappingSize;   //! Not ROOT persistent
+
+    /// Offset of the field values of a grid point
+    std::size_t index(unsigned int i, unsigned int j, unsigned int k)  const  {
+      std::size_t brick = (std::size_t(i/BRICK)*bricks[1] + j/BRICK)*bricks[2] + k/BRICK;
+      return 3*(brick*BRICK*BRICK*BRICK + ((i%BRICK)*BRICK + j%BRICK)*BRICK + k%BRICK);
+    }
+    /// Interpolate the grid values at a position in grid coordinates
+    void interpolate(const double* coord, double* value)  const;
+
+  public:
+    /// Initializing constructor
+    GridField();
+    /// Default destructor
+    virtual ~GridField();
+    /// Load the field map from file. Must be called after setting lunit and funit
+    void load(const std::string& file_name);
+    /// Write field map file. The values are given in natural order: ((i*ny + j)*nz + k)*3 + component
+    static void write(const std::string& file_name,
+                      int grid,
+                      const unsigned int points[3],
+                      const double lower[3],
+                      const double step[3],
+                      const std::vector<float>& values);
+    /// Call to access the field components at a given location
+    virtual void fieldComponents(const double* pos, double* field);
+    /// Call to access the field components at count locations (pos and field: 3*count values)
+    void fieldComponents(std::size_t count, const double* pos, double* field);
+  };
+
 }         /* End namespace dd4hep             */
 #endif    /* DD4HEP_DDCORE_FIELDTYPES_H     */
@@ -131,6 +131,47 @@ namespace dd4hep {
     typedef std::map<std::string, std::string> PropertyValues;
     typedef std::map<std::string, PropertyValues> Properties;
 
+    /// Flattened evaluation sequence of the electric or magnetic field components
+    /**
+     *  The component handles are resolved once to the implementation objects.
+     *  The field types known to DDCore are called without virtual dispatch,
+     *  constant fields are summed when the evaluator is built. Optionally
+     *  the positions and the resulting field are scaled e.g. to convert to
+     *  the units of the client. The evaluator is only valid as long as the
+     *  components of the overlay are alive and must be rebuilt if their
+     *  parameters change.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class Evaluator {
+    public:
+      /// Dispatch type of a field component
+      enum Kind { GENERIC = 0, SOLENOID, DIPOLE, MULTIPOLE, GRID };
+      /// Field component entry
+      struct Component {
+        int                     kind;
+        CartesianField::Object* object;
+      };
+      /// Non-constant field components
+      std::vector<Component> components;
+      /// Sum of all constant field components
+      double constant[3]    { 0e0, 0e0, 0e0 };
+      /// Scale factor applied to the position before the evaluation
+      double position_scale { 1e0 };
+      /// Scale factor applied to the resulting field
+      double field_scale    { 1e0 };
+
+    public:
+      /// Default constructor
+      Evaluator() = default;
+      /// Initializing constructor
+      Evaluator(const std::vector<CartesianField>& fields, double pos_scale = 1e0, double fld_scale = 1e0);
+      /// Set the 3 field components (x, y, z) at a given location
+      void operator()(const double* pos, double* field) const;
+    };
+
     /// Internal data class shared by all handles
     /**
      *  \author  M.Frank
@@ -144,6 +185,10 @@ namespace dd4hep {
       CartesianField magnetic;
       std::vector<CartesianField> electric_components;
       std::vector<CartesianField> magnetic_components;
+      /// Flattened evaluation sequence of the electric components
+      Evaluator electric_evaluator;   //! Not ROOT persistent: rebuilt by OverlayedField::compile()
+      /// Flattened evaluation sequence of the magnetic components
+      Evaluator magnetic_evaluator;   //! Not ROOT persistent: rebuilt by OverlayedField::compile()
       /// Field extensions
       Properties properties;
       /// Default constructor
@@ -172,6 +217,12 @@ namespace dd4hep {
     /// Add a new field component
     void add(CartesianField field);
 
+    /// Rebuild the flattened evaluators. Required if the parameters of components change after adding them
+    void compile();
+
+    /// Create flattened evaluator of the electric or magnetic components with unit conversion factors
+    Evaluator evaluator(int field_type, double pos_scale = 1e0, double field_scale = 1e0) const;
+
     /// Returns the 3 electric field components (x, y, z) if many components are present
     void combinedElectric(const Position& pos, double* field) const {
       combinedElectric((const double*) &pos, field);
@@ -221,9 +272,7 @@ namespace dd4hep {
 
     /// Returns the 3 electric field components (x, y, z).
     void electricField(const double* pos, double* field) const {
-      field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->electric;
-      f.isValid() ? f.value(pos, field) : combinedElectric(pos, field);
+      data<Object>()->electric_evaluator(pos, field);
     }
 
     /// Returns the 3 magnetic field components (x, y, z).
@@ -245,9 +294,7 @@ namespace dd4hep {
 
     /// Returns the 3  magnetic field components (x, y, z).
     void magneticField(const double* pos, double* field) const {
-      field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->magnetic;
-      f.isValid() ? f.value(pos, field) : combinedMagnetic(pos, field);
+      data<Object>()->magnetic_evaluator(pos, field);
     }
 
     /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
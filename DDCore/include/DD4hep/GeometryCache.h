@@ -0,0 +1,141 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_GEOMETRYCACHE_H
+#define DD4HEP_GEOMETRYCACHE_H
+
+// Framework include files
+#include "DD4hep/Detector.h"
+
+// C/C++ include files
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Binary snapshot cache of fully built detector descriptions
+  /**
+   *  Building the detector description from compact XML requires to parse
+   *  all XML files and to execute all detector constructors. The cache
+   *  saves the fully built description with DD4hepRootPersistency and
+   *  reloads it in subsequent jobs.
+   *
+   *  The cache entry is identified by a key computed from the absolute path
+   *  of the compact file, the build type, all constants defined before
+   *  the compact file is processed and the DD4hep and ROOT versions.
+   *  Each entry has a manifest with the content hash of every input file
+   *  loaded while building (XML files and inputs registered with
+   *  xml::DocumentHandler::recordFile like field maps or GDML files) and
+   *  the size and modification time of every shared library loaded into
+   *  the process except the libraries of the operating system.
+   *  The entry is only used if none of them changed. Otherwise the
+   *  description is rebuilt and the entry refreshed.
+   *
+   *  Extensions of the detector and of detector elements are saved with
+   *  their ROOT dictionary to a separate file of the entry and are
+   *  attached again after loading.
+   *
+   *  Restrictions:
+   *  - Inputs read by plugins without xml::DocumentHandler::recordFile are not part of the manifest.
+   *  - Descriptions with extensions or field components without ROOT dictionary are not cached.
+   *
+   *  The cache is enabled for Detector::fromCompact if the environment
+   *  variable DD4HEP_GEOMETRY_CACHE names the cache directory.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class GeometryCache  {
+  public:
+    /// Description of an extension object saved with the cache entry
+    /**
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    struct Extension  {
+      /// Path of the detector element. Empty for extensions of the detector
+      std::string            path;
+      /// ROOT class name of the extension interface
+      std::string            type;
+      /// Extension key
+      unsigned long long int key   { 0 };
+      /// Extension entry (saving only)
+      ExtensionEntry*        entry { nullptr };
+    };
+
+    /// Helper to record the inputs of the description while it is being built
+    /**
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class Recorder  {
+    public:
+      /// Reference to the cache
+      GeometryCache& cache;
+      /// Previous XML file recorder of the DocumentHandler
+      std::vector<std::string>* previous { nullptr };
+    public:
+      /// Initializing constructor: start recording the loaded input files
+      Recorder(GeometryCache& c);
+      /// Default destructor: stop recording
+      ~Recorder();
+    };
+
+  protected:
+    /// Cache directory
+    std::string              m_directory;
+    /// Cache entry name without extension
+    std::string              m_entry;
+    /// Input files loaded while building the description
+    std::vector<std::string> m_files;
+    /// Extensions of the description
+    std::vector<Extension>   m_extensions;
+
+    /// Access the shared libraries currently loaded into the process
+    static std::vector<std::string> loadedLibraries();
+    /// Check that all field components can be saved. Returns false if a component has no ROOT dictionary
+    static bool checkFields(Detector& description);
+    /// Collect the extensions of the description. Returns false if an extension cannot be saved
+    static bool collectExtensions(Detector& description, std::vector<Extension>& extensions);
+    /// Restore the extensions of the description from the cache entry
+    void loadExtensions(Detector& description);
+    /// Save the extensions of the description to the cache entry
+    bool saveExtensions(const std::string& file_name);
+
+  public:
+    /// Initializing constructor
+    GeometryCache(const std::string& directory);
+    /// Default destructor
+    virtual ~GeometryCache() = default;
+    /// Cache directory from the environment (DD4HEP_GEOMETRY_CACHE). Empty if disabled
+    static std::string defaultDirectory();
+    /// Check if the cache is enabled
+    bool enabled()  const   {   return !m_directory.empty();   }
+    /// Compute the cache entry for a compact file. Must be called before loading or saving
+    const std::string& entry(Detector& description, const std::string& compact, DetectorBuildType type);
+    /// Name of the ROOT file of the cache entry
+    std::string dataFile()  const;
+    /// Name of the manifest of the cache entry
+    std::string manifestFile()  const;
+    /// Name of the ROOT file with the extensions of the cache entry
+    std::string extensionsFile()  const;
+    /// Load the description from the cache entry. Returns false if the entry is missing or outdated
+    bool load(Detector& description);
+    /// Save the built description and the manifest of the recorded inputs to the cache entry
+    bool save(Detector& description);
+  };
+}         /* End namespace dd4hep         */
+#endif    /* DD4HEP_GEOMETRYCACHE_H       */
@@ -100,6 +100,11 @@ namespace dd4hep {
    *  subdetectors must have the same length to ensure the uniqueness of the
    *  placement keys.
    *
+   *  Once populated, the top level manager compiles all sections into one
+   *  flat hash table ("frozen" mode), which is then used by lookupContext.
+   *  Adopting further placements drops the table and lookups fall back to the
+   *  section maps until freeze() is called again.
+   *
    *  By default the volume manager in TREE mode (-> 1)) is attached to the
    *  Detector instance and also managed by this instance.
    *  If you wish to create instances yourself, you must ensure that the
@@ -175,6 +180,13 @@ namespace dd4hep {
     /// Register physical volume with the manager and pre-computed volume id
     bool adoptPlacement(VolumeID volume_id, VolumeManagerContext* context);
 
+    /// Compile all sections into one flat lookup table used by lookupContext
+    void freeze();
+    /// Drop the flat lookup table. Lookups are then served by the section maps
+    void unfreeze();
+    /// Check if the lookups are served by the flat lookup table
+    bool isFrozen()  const;
+
     /** This set of functions is required when reading/analyzing
      *  already created hits which have a VolumeID attached.
      */
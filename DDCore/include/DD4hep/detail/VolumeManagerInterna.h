@@ -30,6 +30,9 @@
 // ROOT include files
 #include "TGeoMatrix.h"
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -54,6 +57,84 @@ namespace dd4hep {
       /// Default destructor
       ~VolumeManagerContextExtension() = default;
     };
+
+    /// Frozen, flat lookup table of all volume contexts known to a (top level) volume manager
+    /**
+     *  Once the volume manager is populated, all subdetector sections are compiled
+     *  into one open-addressing hash table keyed by the masked volume identifier.
+     *  The slots are stored contiguously and hold the context pointer directly,
+     *  hence a lookup costs one hash computation and (on average) one cache line.
+     *  The contexts themselves stay owned by the volume manager sections.
+     *
+     *  This object is transient and not subject to persistency.
+     *
+     * \author  M.Frank
+     * \version 1.0
+     * \ingroup DD4HEP_CORE
+     */
+    class VolumeManagerLookup  {
+    public:
+      /// Description of one volume manager section (top level or subdetector)
+      struct Section  {
+        /// Mask of the system field (0 if no pre-selection by system field is possible)
+        VolumeID sysMask = 0;
+        /// Encoded value of the system field
+        VolumeID sysBits = 0;
+        /// Mask applied to the volume identifier to build the lookup key
+        VolumeID detMask = ~0x0ULL;
+      };
+      /// One slot of the open-addressing table
+      struct Slot  {
+        /// Masked volume identifier
+        VolumeID              key     = 0;
+        /// Pointer to the context. Null pointer marks empty slots
+        VolumeManagerContext* context = 0;
+        /// Index of the owning section
+        std::size_t           section = 0;
+      };
+      /// Section descriptors in order of the search sequence
+      std::vector<Section> sections;
+      /// The table slots. The size is always a power of 2
+      std::vector<Slot>    slots;
+      /// Mask to map hash values to slot indices
+      VolumeID             slotMask = 0;
+      /// Number of occupied slots
+      std::size_t          entries  = 0;
+
+    public:
+      /// Default constructor
+      VolumeManagerLookup() = default;
+      /// Compile the lookup table from a populated top level volume manager
+      VolumeManagerLookup(const VolumeManagerObject& top);
+      /// Default destructor
+      ~VolumeManagerLookup() = default;
+      /// Hash function for the masked volume identifiers
+      static VolumeID hash(VolumeID key, std::size_t section)  {
+        VolumeID h = key ^ (VolumeID(section) << 56);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+      }
+      /// Insert a new context into the table
+      bool insert(std::size_t section, VolumeManagerContext* context);
+      /// Search the table for a matching volume identifier
+      VolumeManagerContext* search(VolumeID volume_id) const  {
+        for( std::size_t i = 0, n = sections.size(); i < n; ++i )   {
+          const Section& s = sections[i];
+          if ( (volume_id&s.sysMask) != s.sysBits ) continue;
+          const VolumeID key = volume_id&s.detMask;
+          for( VolumeID idx = hash(key, i)&slotMask; ; idx = (idx+1)&slotMask )  {
+            const Slot& slot = slots[idx];
+            if ( 0 == slot.context ) break;
+            if ( slot.key == key && slot.section == i ) return slot.context;
+          }
+        }
+        return 0;
+      }
+    };
   
     /// This structure describes the internal data of the volume manager object
     /**
@@ -84,6 +165,8 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+      /// Frozen lookup table (top level manager only). Transient: not persistent
+      VolumeManagerLookup*   lookup  = 0; //!
     public:
       /// Default constructor
       VolumeManagerObject() = default;
@@ -99,6 +182,10 @@ namespace dd4hep {
       VolumeManagerObject& operator=(const VolumeManagerObject& copy) = delete;
       /// Search the locally cached volumes for a matching ID
       VolumeManagerContext* search(const VolumeID& id) const;
+      /// Compile the frozen lookup table of the top level manager
+      void freeze();
+      /// Drop the frozen lookup table of the top level manager
+      void unfreeze();
       /// Update callback when alignment has changed (called only for subdetectors....)
       void update(unsigned long tags, DetElement& det, void* param);
     };
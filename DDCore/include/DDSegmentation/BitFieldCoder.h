@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <sstream>
 
 
@@ -53,7 +54,11 @@ namespace dd4hep {
       BitFieldElement& operator=(const BitFieldElement&) = default ;
 
       /// calculate this field's value given an external 64 bit bitmap 
-      long64 value(long64 bitfield) const;
+      long64 value(long64 bitfield) const  {
+        if( _isSigned )   // shift the field to the top and sign-extend it back down
+          return long64( ulong64(bitfield) << (64 - _offset - _width) ) >> (64 - _width) ;
+        return long64( ( ulong64(bitfield) & _mask ) >> _offset ) ;
+      }
 
 
       // assign the given value to the bit field
@@ -95,6 +100,148 @@ namespace dd4hep {
 
 
   
+    /// Light-weight accessor to one field of a bitfield with all constants resolved once.
+    /** Obtained from BitFieldCoder::handle(). All shift and mask constants are
+     *  precomputed, so that value() is inline, branch-free and needs neither
+     *  a name lookup nor a bounds check. The handle stays valid as long as the
+     *  coder it was obtained from is alive.
+     */
+    class BitFieldHandle  {
+    public :
+      /// Default constructor
+      BitFieldHandle() = default ;
+      /// Copy constructor
+      BitFieldHandle(const BitFieldHandle&) = default ;
+      /// Initializing constructor from the field element
+      explicit BitFieldHandle( const BitFieldElement& e ) 
+        : _mask( e.mask() ), _offset( e.offset() ),
+          _left( e.width() ? 64 - e.offset() - e.width() : 0 ),
+          _right( e.width() ? 64 - e.width() : 0 ),
+          _valueMask( e.width() == 0 ? 0ULL
+                      : ( e.isSigned() || e.width() == 64 ) ? ~0ULL : ( 1ULL << e.width() ) - 1 ),
+          _element( &e ) {
+      }
+      /// Assignment operator
+      BitFieldHandle& operator=(const BitFieldHandle&) = default ;
+
+      /// Decode the field value from the bitfield
+      long64 value(long64 bitfield) const  {
+        // shift the field to the top, then arithmetic shift down. Unsigned: clear the sign bits
+        return ( long64( ulong64(bitfield) << _left ) >> _right ) & long64(_valueMask) ;
+      }
+      /// Assign the value to the bitfield. Range checked like BitFieldElement::set
+      void set(long64& bitfield, long64 value) const  {
+        _element->set( bitfield, value ) ;
+      }
+
+      /** The field's mask */
+      ulong64 mask() const { return _mask ; }
+
+      /** The field's offset */
+      unsigned offset() const { return _offset ; }
+
+      /** Access to the underlying field element */
+      const BitFieldElement* element() const { return _element ; }
+
+    protected:
+      ulong64  _mask       {};
+      unsigned _offset     {};
+      unsigned _left       {};
+      unsigned _right      {};
+      ulong64  _valueMask  {};
+      const BitFieldElement* _element { nullptr };
+    };
+
+    /// Compile-time description of one field of a bitfield specification string
+    struct BitFieldSpec  {
+      /// The field's offset
+      unsigned offset   = 0 ;
+      /// The field's width
+      unsigned width    = 0 ;
+      /// True if field is interpreted as signed
+      bool     isSigned = false ;
+      /// True if the field is part of the specification
+      bool     found    = false ;
+    };
+
+    /** Decode the description of the field 'name' from a specification string of
+     *  the form accepted by BitFieldCoder. Can be evaluated at compile time:
+     *
+     *    constexpr BitFieldSpec s = bitFieldSpec( "system:8,barrel:3,layer:6", "layer" ) ;
+     */
+    constexpr BitFieldSpec bitFieldSpec( const char* description, const char* name )  {
+      BitFieldSpec spec ;
+      unsigned offset = 0 ;
+      const char* p = description ;
+      while( *p )  {
+        // compare the field name
+        const char* n = name ;
+        bool match = true ;
+        for( ; *p && *p != ':' && *p != ','; ++p )  {
+          if( match && *n == *p ) ++n ;
+          else match = false ;
+        }
+        match = match && *n == 0 ;
+        // decode [start]:[-]length
+        int values[2] = { 0, 0 } ;
+        int num_values = 0 ;
+        while( *p == ':' )  {
+          bool neg = false ;
+          int  val = 0 ;
+          for( ++p; *p == ' '; ++p ) ;
+          if( *p == '-' )  { neg = true ; ++p ; }
+          for( ; *p >= '0' && *p <= '9'; ++p ) val = 10*val + (*p - '0') ;
+          if( num_values < 2 ) values[num_values] = neg ? -val : val ;
+          ++num_values ;
+        }
+        int      width       = num_values == 1 ? values[0] : values[1] ;
+        unsigned this_offset = num_values == 1 ? offset : unsigned(values[0]) ;
+        unsigned abs_width   = unsigned( width < 0 ? -width : width ) ;
+        offset = this_offset + abs_width ;
+        if( match && ( num_values == 1 || num_values == 2 ) )  {
+          spec.offset   = this_offset ;
+          spec.width    = abs_width ;
+          spec.isSigned = width < 0 ;
+          spec.found    = true ;
+          return spec ;
+        }
+        for( ; *p && *p != ','; ++p ) ;
+        if( *p == ',' ) ++p ;
+      }
+      return spec ;
+    }
+
+    /// Field decoder with all constants fixed at compile time.
+    /** Usable from user plugins, where the readout specification is known at compile time:
+     *
+     *    constexpr const char spec[] = "system:8,barrel:3,layer:6,x:32:-16,y:-16" ;
+     *    typedef FixedBitFieldElement<bitFieldSpec(spec,"x").offset,
+     *                                 bitFieldSpec(spec,"x").width,
+     *                                 bitFieldSpec(spec,"x").isSigned>   FieldX ;
+     *    long64 x = FieldX::value( cellID ) ;
+     */
+    template <unsigned OFFSET, unsigned WIDTH, bool SIGNED> struct FixedBitFieldElement  {
+      static_assert( WIDTH > 0 && OFFSET + WIDTH <= 64, "Invalid bitfield: unknown field or bad offset/width" ) ;
+
+      /// The field's mask
+      static constexpr ulong64  mask   = ( WIDTH == 64 ? ~0ULL : ( ( 1ULL << WIDTH ) - 1 ) ) << OFFSET ;
+      /// The field's offset
+      static constexpr unsigned offset = OFFSET ;
+      /// The field's width
+      static constexpr unsigned width  = WIDTH ;
+
+      /// Decode the field value from the bitfield
+      static constexpr long64 value(long64 bitfield)  {
+        return SIGNED
+          ? long64( ulong64(bitfield) << ( 64 - OFFSET - WIDTH ) ) >> ( 64 - WIDTH )
+          : long64( ( ulong64(bitfield) & mask ) >> OFFSET ) ;
+      }
+      /// Assign the value to the bitfield (no range check)
+      static constexpr long64 set(long64 bitfield, long64 value)  {
+        return long64( ( ulong64(bitfield) & ~mask ) | ( ( ulong64(value) << OFFSET ) & mask ) ) ;
+      }
+    };
+
     /// Helper class for decoding and encoding a bit field of 64bits for convenient declaration
     /** and manipulation of sub fields of various widths.<br>
      *  This is a thread safe re-implementation of the functionality in the deprected BitField64.
@@ -123,15 +270,26 @@ namespace dd4hep {
 
       /// Default constructor
       BitFieldCoder() = default ;
-      /// Copy constructor
-      BitFieldCoder(const BitFieldCoder&) = default ;
+      /// Copy constructor. The field handles refer to the own fields
+      BitFieldCoder(const BitFieldCoder& c)
+        : _fields( c._fields ), _map( c._map ), _joined( c._joined )  {
+        buildHandles() ;
+      }
       /// Move constructor
       BitFieldCoder(BitFieldCoder&&) = default ;
       /// Default destructor
       ~BitFieldCoder() = default ;
 
-      /// Assignment operator
-      BitFieldCoder& operator=(const BitFieldCoder&) = default ;
+      /// Assignment operator. The field handles refer to the own fields
+      BitFieldCoder& operator=(const BitFieldCoder& c)  {
+        if( this != &c )  {
+          _fields = c._fields ;
+          _map    = c._map ;
+          _joined = c._joined ;
+          buildHandles() ;
+        }
+        return *this ;
+      }
     
       /** The c'tor takes an initialization string of the form:<br>
        *  \<fieldDesc\>[,\<fieldDesc\>...]<br>
@@ -174,10 +332,12 @@ namespace dd4hep {
       }
     
       /** Access to field through name .
+       *  Note: the name is hashed on every call. In loops prefer handle( name ).
        */
       long64 get(long64 bitfield, const std::string& name) const {
 
-        return _fields.at( index( name ) ).value( bitfield ) ;
+        auto i = _handles.find( name ) ;
+        return i != _handles.end() ? i->second.value( bitfield ) : _fields[ index( name ) ].value( bitfield ) ;
       }
 
       /** set value of sub-field specified by index 
@@ -190,7 +350,24 @@ namespace dd4hep {
        */
       void set(long64& bitfield, const std::string& name, ulong64 value) const {
 
-        _fields.at( index( name ) ).set( bitfield, value ) ;
+        auto i = _handles.find( name ) ;
+        if( i != _handles.end() ) i->second.set( bitfield, value ) ;
+        else _fields[ index( name ) ].set( bitfield, value ) ;
+      }
+
+      /** Light-weight accessor to the field specified by index with all constants resolved.
+       */
+      BitFieldHandle handle(size_t idx) const {
+
+        return BitFieldHandle( _fields.at( idx ) ) ;
+      }
+
+      /** Light-weight accessor to the field named 'name' with all constants resolved.
+       */
+      BitFieldHandle handle(const std::string& name) const {
+
+        auto i = _handles.find( name ) ;
+        return i != _handles.end() ? i->second : BitFieldHandle( _fields[ index( name ) ] ) ;
       }
 
 
@@ -249,6 +426,11 @@ namespace dd4hep {
        */
       void init( const std::string& initString) ;
 
+      /** Resolve the handles of all fields by name. Objects read by ROOT have no
+       *  handles: the accessors by name then fall back to the index lookup.
+       */
+      void buildHandles() ;
+
     public:
 
     protected:
@@ -258,6 +440,8 @@ namespace dd4hep {
       std::vector<BitFieldElement> _fields{} ;
       IndexMap  _map{} ;
       long64    _joined{} ;
+      /// Resolved field handles by name
+      std::unordered_map<std::string, BitFieldHandle> _handles{} ;  //! transient
 
     };
 
@@ -17,6 +17,9 @@
 // Framework include files
 #include "XML/XMLElements.h"
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -65,6 +68,10 @@ namespace dd4hep {
 
       /// Set minimum print level
       static int setMinimumPrintLevel(int level);
+      /// Record the paths of all XML files loaded from now on (0 stops recording). Returns the previous recorder
+      static std::vector<std::string>* setFileRecorder(std::vector<std::string>* files);
+      /// Record a non-XML input file (e.g. a field map) read while the recorder is active
+      static void recordFile(const std::string& path);
       /// System ID of a given XML entity
       static std::string system_path(Handle_t base);
       /// System ID of a new XML entity in the same directory as base
@@ -63,6 +63,7 @@ UNICODE (build);
 UNICODE (c);
 UNICODE (distance);
 UNICODE (C);
+UNICODE (cache);
 UNICODE (calorimeter);
 UNICODE (cartesian_grid_xy);
 UNICODE (chamber);
@@ -16,6 +16,8 @@
 #include "DD4hep/DD4hepRootPersistency.h"
 #include "DD4hep/detail/ObjectsInterna.h"
 #include "DD4hep/detail/SegmentationsInterna.h"
+#include "DD4hep/detail/DetectorInterna.h"
+#include "DD4hep/World.h"
 
 // ROOT include files
 #include "TFile.h"
@@ -37,6 +39,8 @@ int DD4hepRootPersistency::save(Detector& description, const char* fname, const
       DD4hepRootPersistency* persist = new DD4hepRootPersistency();
       persist->m_data = new dd4hep::DetectorData();
       persist->m_data->adoptData(dynamic_cast<DetectorData&>(description),false);
+      /// Adopting the data re-assigned the (transient) detector reference of the world: restore it
+      World(description.world())->description = &description;
       for( const auto& s : persist->m_data->m_sensitive )  {
         dd4hep::SensitiveDetector sd = s.second;
         dd4hep::Readout ro = sd.readout();
@@ -143,6 +147,8 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
           }
           printout(ALWAYS,"DD4hepRootPersistency",
                    "+++ Fixed VolumeManager TOTALS     %-24s  %6ld volumes %4ld sdets %4ld mgrs.","",num[0],num[1],num[2]);
+          /// The flat lookup table is transient: re-compile it once the system fields are restored
+          persist->volumeManager().freeze();
           printout(ALWAYS,"DD4hepRootPersistency","+++ loaded %ld nominals....",persist->nominals.size());
         }
         else   {
@@ -152,6 +158,8 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
         DetectorData* src_data = dynamic_cast<DetectorData*>(source);
         if( tar_data != nullptr && src_data != nullptr )  {
           tar_data->adoptData(*src_data,false);
+          /// The flattened field evaluators are transient: re-compile them for the adopted field
+          if ( description.field().isValid() ) description.field().compile();
           TTimeStamp stop;
           printout(ALWAYS,"DD4hepRootPersistency",
                    "+++ Successfully loaded detector description from file:%s  [%8.3f seconds]",
@@ -19,6 +19,7 @@
 #include "DD4hep/GeoHandler.h"
 #include "DD4hep/DetectorHelper.h"
 #include "DD4hep/DetectorTools.h"
+#include "DD4hep/GeometryCache.h"
 
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/detail/ObjectsInterna.h"
@@ -629,6 +630,8 @@ void DetectorImp::endDocument(bool close_geometry)    {
   ShapePatcher patcher(m_volManager, m_world);
   patcher.patchShapes();
   mapDetectorTypes();
+  /// Flatten the field overlay once all field components are defined
+  if ( m_field.isValid() ) m_field.compile();
   m_state = READY;
 }
 
@@ -695,6 +698,30 @@ void DetectorImp::init() {
   }
 }
 
+/// Read compact geometry description or alignment file
+void DetectorImp::fromCompact(const string& xmlfile, DetectorBuildType build_type) {
+  GeometryCache cache(GeometryCache::defaultDirectory());
+  /// The cache holds complete descriptions only: use it for the first file
+  if ( cache.enabled() && m_state == NOT_READY && !m_world.isValid() )   {
+    lock_guard<recursive_mutex> lock(s_detector_apply_lock);
+    cache.entry(*this, xmlfile, build_type);
+    /// Same build type while loading from the cache as while processing the XML
+    TypePreserve build_type_preserve(m_buildType = build_type);
+    if ( cache.load(*this) )   {
+      mapDetectorTypes();
+      m_state = READY;
+      return;
+    }
+    {
+      GeometryCache::Recorder recorder(cache);
+      fromXML(xmlfile, build_type);
+    }
+    cache.save(*this);
+    return;
+  }
+  fromXML(xmlfile, build_type);
+}
+
 /// Read any geometry description or alignment file
 void DetectorImp::fromXML(const string& xmlfile, DetectorBuildType build_type) {
   TypePreserve build_type_preserve(m_buildType = build_type);
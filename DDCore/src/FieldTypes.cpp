@@ -12,8 +12,18 @@
 //==========================================================================
 
 #include "DD4hep/FieldTypes.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/DD4hepUnits.h"
 #include "DD4hep/detail/Handle.inl"
 #include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace dd4hep;
@@ -37,6 +47,21 @@ DD4HEP_INSTANTIATE_HANDLE(ConstantField);
 DD4HEP_INSTANTIATE_HANDLE(SolenoidField);
 DD4HEP_INSTANTIATE_HANDLE(DipoleField);
 DD4HEP_INSTANTIATE_HANDLE(MultipoleField);
+DD4HEP_INSTANTIATE_HANDLE(GridField);
+
+namespace {
+  /// Magic word of the field map files
+  const char GRID_FIELD_MAGIC[8] = { 'D','D','4','h','e','p','F','M' };
+
+  /// Corner values of the grid cell last accessed by this thread
+  struct CellCache  {
+    const GridField* field  { nullptr };
+    const float*     values { nullptr };
+    unsigned int     cell[3] { 0, 0, 0 };
+    float            corners[8][3];
+  };
+  thread_local CellCache s_cellCache;
+}
 
 /// Compute  the field components at a given location and add to given field
 void ConstantField::fieldComponents(const double* /* pos */, double* field) {
@@ -135,3 +160,208 @@ void MultipoleField::fieldComponents(const double* pos, double* field) {
     field[2] += B_z;
   }
 }
+
+/// Initializing constructor
+GridField::GridField()
+  : grid(CARTESIAN), lunit(dd4hep::mm), funit(dd4hep::tesla), offset(), file(), values(0),
+    cache_cell(false), periodic_phi(false), m_mapping(0), m_mappingSize(0)
+{
+  type = CartesianField::MAGNETIC;
+  for( int i = 0; i < 3; ++i )  {
+    points[i] = bricks[i] = 1;
+    lower[i] = inv_step[i] = last[i] = 0e0;
+  }
+}
+
+/// Default destructor
+GridField::~GridField()   {
+  if ( m_mapping ) ::munmap(m_mapping, m_mappingSize);
+  m_mapping = 0;
+  values = 0;
+}
+
+/// Load the field map from file. Must be called after setting lunit and funit
+void GridField::load(const std::string& file_name)   {
+  struct stat info;
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &info) != 0 )   {
+    if ( fd >= 0 ) ::close(fd);
+    except("GridField","+++ Failed to open field map %s: %s", file_name.c_str(), ::strerror(errno));
+  }
+  size_t len = info.st_size;
+  void*  ptr = len >= sizeof(Header) ? ::mmap(0, len, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if ( ptr == MAP_FAILED )   {
+    except("GridField","+++ Failed to map field map %s: %s", file_name.c_str(),
+           len < sizeof(Header) ? "File too short" : ::strerror(errno));
+  }
+  const Header* hdr = (const Header*)ptr;
+  size_t num_bricks = 1, expected = 0;
+  for( int i = 0; i < 3; ++i )
+    num_bricks *= (hdr->points[i] + BRICK - 1) / BRICK;
+  expected = sizeof(Header) + num_bricks * BRICK * BRICK * BRICK * 3 * sizeof(float);
+  if ( ::memcmp(hdr->magic, GRID_FIELD_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != 1 ||
+       hdr->grid > CYLINDRICAL || hdr->points[0]*hdr->points[1]*hdr->points[2] == 0 || len != expected )   {
+    ::munmap(ptr, len);
+    except("GridField","+++ Invalid field map file %s [size: %ld bytes, expected: %ld bytes]",
+           file_name.c_str(), len, expected);
+  }
+  if ( m_mapping ) ::munmap(m_mapping, m_mappingSize);
+  m_mapping     = ptr;
+  m_mappingSize = len;
+  file   = file_name;
+  grid   = hdr->grid;
+  values = (const float*)(hdr+1);
+  for( int i = 0; i < 3; ++i )   {
+    // The phi axis of cylindrical maps is an angle and not scaled
+    double scale = (grid == CYLINDRICAL && i == 1) ? 1e0 : lunit;
+    points[i]   = hdr->points[i];
+    bricks[i]   = (points[i] + BRICK - 1) / BRICK;
+    lower[i]    = hdr->lower[i] * scale;
+    inv_step[i] = points[i] > 1 ? 1e0 / (hdr->step[i] * scale) : 0e0;
+    last[i]     = double(points[i] - 1);
+  }
+  periodic_phi = grid == CYLINDRICAL && points[1] > 1 &&
+    std::fabs(points[1] * hdr->step[1] - 2e0*M_PI) < 1e-6;
+  printout(INFO,"GridField","+++ Loaded %s field map %s with %u x %u x %u points.",
+           grid == CYLINDRICAL ? "cylindrical" : "cartesian", file_name.c_str(),
+           points[0], points[1], points[2]);
+}
+
+/// Write field map file. The values are given in natural order: ((i*ny + j)*nz + k)*3 + component
+void GridField::write(const std::string& file_name,
+                      int grid_type,
+                      const unsigned int num_points[3],
+                      const double first[3],
+                      const double step[3],
+                      const std::vector<float>& field_values)
+{
+  GridField map;
+  Header hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, GRID_FIELD_MAGIC, sizeof(hdr.magic));
+  hdr.version = 1;
+  hdr.grid    = grid_type;
+  for( int i = 0; i < 3; ++i )   {
+    hdr.points[i]  = map.points[i] = num_points[i];
+    hdr.lower[i]   = first[i];
+    hdr.step[i]    = step[i];
+    map.bricks[i]  = (num_points[i] + BRICK - 1) / BRICK;
+  }
+  size_t num_points_total = size_t(num_points[0]) * num_points[1] * num_points[2];
+  if ( field_values.size() != 3*num_points_total )   {
+    except("GridField","+++ Field map %s: %ld values given for %ld grid points.",
+           file_name.c_str(), field_values.size(), num_points_total);
+  }
+  vector<float> data(size_t(map.bricks[0]) * map.bricks[1] * map.bricks[2] * BRICK * BRICK * BRICK * 3, 0e0);
+  for( unsigned int i = 0; i < num_points[0]; ++i )   {
+    for( unsigned int j = 0; j < num_points[1]; ++j )   {
+      for( unsigned int k = 0; k < num_points[2]; ++k )   {
+        const float* src = &field_values[((size_t(i)*num_points[1] + j)*num_points[2] + k)*3];
+        std::copy(src, src+3, &data[map.index(i, j, k)]);
+      }
+    }
+  }
+  FILE* file = ::fopen(file_name.c_str(), "wb");
+  bool  ok   = file != 0;
+  ok = ok && ::fwrite(&hdr, sizeof(hdr), 1, file) == 1;
+  ok = ok && ::fwrite(&data[0], sizeof(float), data.size(), file) == data.size();
+  if ( file ) ok = (0 == ::fclose(file)) && ok;
+  if ( !ok )   {
+    except("GridField","+++ Failed to write field map %s: %s", file_name.c_str(), ::strerror(errno));
+  }
+}
+
+/// Interpolate the grid values at a position in grid coordinates
+void GridField::interpolate(const double* coord, double* value)  const   {
+  unsigned int i0[3], i1[3];
+  double w[3], inside = 1e0;
+  // Cell location without branches: clamp to the grid and
+  // suppress the contribution of positions outside the grid.
+  for( int a = 0; a < 3; ++a )   {
+    double t = (coord[a] - lower[a]) * inv_step[a];
+    if ( a == 1 && periodic_phi )   {
+      // Full circle: the last cell ends at the first phi point
+      t -= points[1] * std::floor(t / points[1]);
+      i0[1] = std::min((unsigned int)t, points[1] - 1);
+      i1[1] = i0[1] + 1 == points[1] ? 0 : i0[1] + 1;
+      w[1]  = std::min(std::max(0e0, t - double(i0[1])), 1e0);
+      continue;
+    }
+    inside *= double((t >= 0e0) & (t <= last[a]));
+    t = std::min(std::max(0e0, t), last[a]);
+    i0[a] = std::min((unsigned int)t, std::max(points[a], 2u) - 2);
+    i1[a] = std::min(i0[a] + 1, points[a] - 1);
+    w[a]  = t - double(i0[a]);
+  }
+  const float *v000, *v001, *v010, *v011, *v100, *v101, *v110, *v111;
+  if ( cache_cell )   {
+    // Consecutive steps of a track mostly stay in the same cell:
+    // re-use the corner values and skip the gather from the map.
+    CellCache& c = s_cellCache;
+    if ( c.field != this || c.values != values ||
+         c.cell[0] != i0[0] || c.cell[1] != i0[1] || c.cell[2] != i0[2] )   {
+      for( int n = 0; n < 8; ++n )   {   // Corner n: bit 2 -> x, bit 1 -> y, bit 0 -> z
+        const float* v = values + index((n&4 ? i1 : i0)[0], (n&2 ? i1 : i0)[1], (n&1 ? i1 : i0)[2]);
+        c.corners[n][0] = v[0];
+        c.corners[n][1] = v[1];
+        c.corners[n][2] = v[2];
+      }
+      c.field  = this;
+      c.values = values;
+      std::copy(i0, i0+3, c.cell);
+    }
+    v000 = c.corners[0]; v001 = c.corners[1]; v010 = c.corners[2]; v011 = c.corners[3];
+    v100 = c.corners[4]; v101 = c.corners[5]; v110 = c.corners[6]; v111 = c.corners[7];
+  }
+  else   {
+    v000 = values + index(i0[0], i0[1], i0[2]);
+    v001 = values + index(i0[0], i0[1], i1[2]);
+    v010 = values + index(i0[0], i1[1], i0[2]);
+    v011 = values + index(i0[0], i1[1], i1[2]);
+    v100 = values + index(i1[0], i0[1], i0[2]);
+    v101 = values + index(i1[0], i0[1], i1[2]);
+    v110 = values + index(i1[0], i1[1], i0[2]);
+    v111 = values + index(i1[0], i1[1], i1[2]);
+  }
+  double wx = w[0], wy = w[1], wz = w[2];
+  double scale = inside * funit;
+  for( int c = 0; c < 3; ++c )   {
+    double c00 = v000[c] + (v001[c] - v000[c]) * wz;
+    double c01 = v010[c] + (v011[c] - v010[c]) * wz;
+    double c10 = v100[c] + (v101[c] - v100[c]) * wz;
+    double c11 = v110[c] + (v111[c] - v110[c]) * wz;
+    double c0  = c00 + (c01 - c00) * wy;
+    double c1  = c10 + (c11 - c10) * wy;
+    value[c]   = (c0 + (c1 - c0) * wx) * scale;
+  }
+}
+
+/// Call to access the field components at a given location
+void GridField::fieldComponents(const double* pos, double* field)   {
+  double x = pos[0] - offset.X(), y = pos[1] - offset.Y(), z = pos[2] - offset.Z();
+  double b[3];
+  if ( grid == CARTESIAN )   {
+    double coord[3] = { x, y, z };
+    interpolate(coord, b);
+    field[0] += b[0];
+    field[1] += b[1];
+    field[2] += b[2];
+    return;
+  }
+  double r = std::sqrt(x*x + y*y);
+  double phi = points[1] > 1 ? std::atan2(y, x) : 0e0;
+  if ( phi < lower[1] ) phi += 2e0*M_PI;
+  double coord[3] = { r, phi, z };
+  double cos_phi = r > 0e0 ? x/r : 1e0, sin_phi = r > 0e0 ? y/r : 0e0;
+  interpolate(coord, b);
+  field[0] += b[0] * cos_phi - b[1] * sin_phi;
+  field[1] += b[0] * sin_phi + b[1] * cos_phi;
+  field[2] += b[2];
+}
+
+/// Call to access the field components at count locations (pos and field: 3*count values)
+void GridField::fieldComponents(std::size_t count, const double* pos, double* field)   {
+  for( std::size_t i = 0; i < count; ++i )
+    fieldComponents(pos + 3*i, field + 3*i);
+}
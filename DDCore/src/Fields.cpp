@@ -12,9 +12,13 @@
 //==========================================================================
 
 #include "DD4hep/Fields.h"
+#include "DD4hep/FieldTypes.h"
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/detail/Handle.inl"
 
+// C/C++ include files
+#include <typeinfo>
+
 using namespace std;
 using namespace dd4hep;
 
@@ -24,11 +28,6 @@ DD4HEP_INSTANTIATE_HANDLE(CartesianFieldObject);
 typedef OverlayedField::Object OverlayedFieldObject;
 DD4HEP_INSTANTIATE_HANDLE(OverlayedFieldObject);
 
-namespace {
-  void calculate_combined_field(vector<CartesianField>& v, const double* pos, double* field) {
-    for (const auto& i : v ) i.value(pos, field);
-  }
-}
 
 /// Default constructor
 CartesianField::Object::Object()
@@ -71,6 +70,58 @@ void CartesianField::value(const double* pos, double* val) const {
   data<Object>()->fieldComponents(pos, val);
 }
 
+/// Initializing constructor
+OverlayedField::Evaluator::Evaluator(const vector<CartesianField>& fields, double pos_scale, double fld_scale)
+  : position_scale(pos_scale), field_scale(fld_scale)
+{
+  for ( const auto& f : fields )  {
+    CartesianField::Object* obj = f.data<CartesianField::Object>();
+    const type_info& typ = typeid(*obj);
+    // Only exact types are dispatched directly: sub-classes may override fieldComponents
+    if ( typ == typeid(ConstantField) )  {
+      const Direction& dir = ((ConstantField*)obj)->direction;
+      constant[0] += dir.X();
+      constant[1] += dir.Y();
+      constant[2] += dir.Z();
+      continue;
+    }
+    Component c { GENERIC, obj };
+    if      ( typ == typeid(SolenoidField)  ) c.kind = SOLENOID;
+    else if ( typ == typeid(DipoleField)    ) c.kind = DIPOLE;
+    else if ( typ == typeid(MultipoleField) ) c.kind = MULTIPOLE;
+    else if ( typ == typeid(GridField)      ) c.kind = GRID;
+    components.emplace_back(c);
+  }
+}
+
+/// Set the 3 field components (x, y, z) at a given location
+void OverlayedField::Evaluator::operator()(const double* pos, double* field) const {
+  double p[3] = { pos[0]*position_scale, pos[1]*position_scale, pos[2]*position_scale };
+  double b[3] = { constant[0], constant[1], constant[2] };
+  for ( const Component& c : components )  {
+    switch(c.kind)  {
+    case SOLENOID:
+      ((SolenoidField*)c.object)->SolenoidField::fieldComponents(p, b);
+      break;
+    case DIPOLE:
+      ((DipoleField*)c.object)->DipoleField::fieldComponents(p, b);
+      break;
+    case MULTIPOLE:
+      ((MultipoleField*)c.object)->MultipoleField::fieldComponents(p, b);
+      break;
+    case GRID:
+      ((GridField*)c.object)->GridField::fieldComponents(p, b);
+      break;
+    default:
+      c.object->fieldComponents(p, b);
+      break;
+    }
+  }
+  field[0] = b[0] * field_scale;
+  field[1] = b[1] * field_scale;
+  field[2] = b[2] * field_scale;
+}
+
 /// Default constructor
 OverlayedField::Object::Object()
   : type(0), electric(), magnetic() {
@@ -119,8 +170,10 @@ void OverlayedField::add(CartesianField field) {
         o->type |= field.MAGNETIC;
         o->magnetic = v.size() == 1 ? field : CartesianField();
       }
-      if (isMag || isEle)
+      if (isMag || isEle)  {
+        compile();
         return;
+      }
       throw runtime_error("OverlayedField::add: Attempt to add an unknown field type.");
     }
     throw runtime_error("OverlayedField::add: Attempt to add to an invalid object.");
@@ -128,22 +181,47 @@ void OverlayedField::add(CartesianField field) {
   throw runtime_error("OverlayedField::add: Attempt to add an invalid field.");
 }
 
+/// Rebuild the flattened evaluators. Required if the parameters of components change after adding them
+void OverlayedField::compile() {
+  Object* o = data<Object>();
+  if (o) {
+    for ( const auto* components : { &o->electric_components, &o->magnetic_components } )  {
+      for ( const auto& f : *components )  {
+        // The field map data are not ROOT persistent: map the file again after restoring
+        GridField* g = dynamic_cast<GridField*>(f.data<CartesianField::Object>());
+        if ( g && !g->values && !g->file.empty() ) g->load(g->file);
+      }
+    }
+    o->electric_evaluator = Evaluator(o->electric_components);
+    o->magnetic_evaluator = Evaluator(o->magnetic_components);
+    return;
+  }
+  throw runtime_error("OverlayedField::compile: Attempt to compile an invalid object.");
+}
+
+/// Create flattened evaluator of the electric or magnetic components with unit conversion factors
+OverlayedField::Evaluator OverlayedField::evaluator(int field_type, double pos_scale, double field_scale) const {
+  Object* o = data<Object>();
+  if (field_type == CartesianField::ELECTRIC)
+    return Evaluator(o->electric_components, pos_scale, field_scale);
+  else if (field_type == CartesianField::MAGNETIC)
+    return Evaluator(o->magnetic_components, pos_scale, field_scale);
+  throw runtime_error("OverlayedField::evaluator: Attempt to access an unknown field type.");
+}
+
 /// Returns the 3 electric field components (x, y, z).
 void OverlayedField::combinedElectric(const double* pos, double* field) const {
-  field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->electric_components, pos, field);
+  data<Object>()->electric_evaluator(pos, field);
 }
 
 /// Returns the 3  magnetic field components (x, y, z).
 void OverlayedField::combinedMagnetic(const double* pos, double* field) const {
-  field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->magnetic_components, pos, field);
+  data<Object>()->magnetic_evaluator(pos, field);
 }
 
 /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
 void OverlayedField::electromagneticField(const double* pos, double* field) const {
   Object* o = data<Object>();
-  field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(o->electric_components, pos, field);
-  calculate_combined_field(o->magnetic_components, pos, field + 3);
+  o->electric_evaluator(pos, field);
+  o->magnetic_evaluator(pos, field + 3);
 }
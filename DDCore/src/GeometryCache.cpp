@@ -0,0 +1,405 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/GeometryCache.h"
+#include "DD4hep/DD4hepRootPersistency.h"
+#include "DD4hep/detail/DetectorInterna.h"
+#include "DD4hep/DetectorTools.h"
+#include "DD4hep/Primitives.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Fields.h"
+#include "XML/DocumentHandler.h"
+
+// ROOT include files
+#include "RVersion.h"
+#include "TSystem.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TBufferFile.h"
+
+// C/C++ include files
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <link.h>
+#endif
+
+using namespace std;
+using namespace dd4hep;
+
+namespace {
+
+  /// Absolute path of a file. Unchanged if the file does not exist
+  string absolute_path(const string& path)   {
+    char buff[PATH_MAX+1];
+    string p = path.substr(0,5) == "file:" ? path.substr(5) : path;
+    if ( ::realpath(p.c_str(), buff) ) return buff;
+    return p;
+  }
+
+  /// Hash of the content of a file
+  string file_stamp(const string& path)   {
+    ifstream in(path, ios::in|ios::binary);
+    if ( !in.good() ) return "missing";
+    string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    char text[32];
+    ::snprintf(text, sizeof(text), "%016llx", detail::hash64(data));
+    return text;
+  }
+
+  /// Size and modification time of a shared library
+  string library_stamp(const string& path)   {
+    struct stat buff;
+    if ( 0 != ::stat(path.c_str(), &buff) ) return "missing";
+    stringstream str;
+    str << buff.st_size << ':' << buff.st_mtime;
+    return str.str();
+  }
+
+  /// Check if a shared library belongs to the operating system. These are not stamped
+  bool system_library(const string& path)   {
+    static const char* dirs[] = { "/lib/", "/lib64/", "/usr/lib/", "/usr/lib64/" };
+    for( const char* d : dirs )
+      if ( 0 == path.compare(0, ::strlen(d), d) ) return true;
+    return false;
+  }
+
+#if defined(__linux__)
+  /// Callback to collect the names of the loaded shared libraries
+  int collect_library(struct dl_phdr_info* info, size_t /* size */, void* param)   {
+    if ( info->dlpi_name && info->dlpi_name[0] )
+      ((vector<string>*)param)->emplace_back(info->dlpi_name);
+    return 0;
+  }
+#endif
+
+  /// Extension entry of an object restored from the cache using its ROOT dictionary
+  class PersistentExtension : public ExtensionEntry  {
+    void*                  ptr;
+    TClass*                cls;
+    unsigned long long int key;
+  public:
+    /// Initializing constructor
+    PersistentExtension(void* p, TClass* c, unsigned long long int k) : ptr(p), cls(c), key(k) {}
+    /// Virtual object accessor
+    virtual void* object()  const override     {  return ptr;              }
+    /// Virtual object copy operator: copy by streaming the object
+    virtual void* copy(void*)  const override   {
+      TBufferFile buffer(TBuffer::kWrite);
+      buffer.WriteObjectAny(ptr, cls);
+      buffer.SetReadMode();
+      buffer.SetBufferOffset(0);
+      return buffer.ReadObjectAny(cls);
+    }
+    /// Virtual object destructor
+    virtual void  destruct()  const override    {  cls->Destructor(ptr);    }
+    /// Virtual entry clone function
+    virtual ExtensionEntry* clone(void* arg)  const override
+    {  return new PersistentExtension(copy(arg), cls, key);                  }
+    /// Hash value
+    virtual unsigned long long int hash64()  const override  {  return key;  }
+    /// Type of the extension interface
+    virtual const type_info& type()  const override
+    {  return cls->GetTypeInfo() ? *cls->GetTypeInfo() : typeid(void);       }
+  };
+
+  /// Collect the extensions of a detector element and its children
+  void collect_extensions(DetElement de, vector<GeometryCache::Extension>& extensions)   {
+    for( const auto& e : de.ptr()->extensions )
+      extensions.emplace_back(GeometryCache::Extension{ de.path(), "", e.first, e.second });
+    for( const auto& c : de.children() )
+      collect_extensions(c.second, extensions);
+  }
+}
+
+/// Initializing constructor: start recording the loaded input files
+GeometryCache::Recorder::Recorder(GeometryCache& c) : cache(c)   {
+  cache.m_files.clear();
+  previous = xml::DocumentHandler::setFileRecorder(&cache.m_files);
+}
+
+/// Default destructor: stop recording
+GeometryCache::Recorder::~Recorder()   {
+  xml::DocumentHandler::setFileRecorder(previous);
+}
+
+/// Initializing constructor
+GeometryCache::GeometryCache(const string& directory) : m_directory(directory)   {
+}
+
+/// Cache directory from the environment (DD4HEP_GEOMETRY_CACHE). Empty if disabled
+string GeometryCache::defaultDirectory()   {
+  const char* dir = ::getenv("DD4HEP_GEOMETRY_CACHE");
+  return dir ? dir : "";
+}
+
+/// Access the shared libraries currently loaded into the process
+vector<string> GeometryCache::loadedLibraries()   {
+  vector<string> libs;
+#if defined(__linux__)
+  ::dl_iterate_phdr(collect_library, &libs);
+#endif
+  return libs;
+}
+
+/// Check that all field components can be saved. Returns false if a component has no ROOT dictionary
+bool GeometryCache::checkFields(Detector& description)   {
+  OverlayedField field = description.field();
+  if ( !field.isValid() )   {
+    return true;
+  }
+  OverlayedField::Object* obj = field.data<OverlayedField::Object>();
+  for( const auto* components : { &obj->electric_components, &obj->magnetic_components } )   {
+    for( const auto& c : *components )   {
+      const type_info& typ = typeid(*c.ptr());
+      TClass* cls = TClass::GetClass(typ, kTRUE, kTRUE);
+      if ( !cls || !cls->HasDictionary() )   {
+        printout(WARNING,"GeometryCache","+++ Field %s of type %s has no ROOT dictionary. Not cached.",
+                 c.name(), typeName(typ).c_str());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Collect the extensions of the description. Returns false if an extension cannot be saved
+bool GeometryCache::collectExtensions(Detector& description, vector<Extension>& extensions)   {
+  DetectorData* data = dynamic_cast<DetectorData*>(&description);
+  if ( data )   {
+    for( const auto& e : data->m_extensions.extensions )
+      extensions.emplace_back(Extension{ "", "", e.first, e.second });
+  }
+  if ( description.world().isValid() )   {
+    collect_extensions(description.world(), extensions);
+  }
+  for( auto& e : extensions )   {
+    const type_info& typ = e.entry->type();
+    TClass* cls = typ == typeid(void) ? nullptr : TClass::GetClass(typ, kTRUE, kTRUE);
+    if ( !cls || !cls->HasDictionary() )   {
+      printout(WARNING,"GeometryCache","+++ Extension %016llX of %s of type %s has no ROOT dictionary. Not cached.",
+               e.key, e.path.empty() ? "the detector" : e.path.c_str(),
+               typ == typeid(void) ? "[unknown]" : typeName(typ).c_str());
+      return false;
+    }
+    e.type = cls->GetName();
+  }
+  return true;
+}
+
+/// Restore the extensions of the description from the cache entry
+void GeometryCache::loadExtensions(Detector& description)   {
+  if ( m_extensions.empty() )   {
+    return;
+  }
+  unique_ptr<TFile> file(TFile::Open(extensionsFile().c_str()));
+  if ( !file || file->IsZombie() )   {
+    except("GeometryCache","+++ Failed to open extensions of cache entry %s.",extensionsFile().c_str());
+  }
+  for( size_t i = 0; i < m_extensions.size(); ++i )   {
+    const Extension& e = m_extensions[i];
+    TClass* cls = TClass::GetClass(e.type.c_str());
+    void*   obj = cls ? file->GetObjectChecked(("extension_"+to_string(i)).c_str(), cls) : nullptr;
+    if ( !obj )   {
+      except("GeometryCache","+++ Failed to read extension %ld of type %s from %s.",
+             long(i), e.type.c_str(), extensionsFile().c_str());
+    }
+    PersistentExtension* entry = new PersistentExtension(obj, cls, e.key);
+    if ( e.path.empty() )
+      description.addUserExtension(e.key, entry);
+    else
+      detail::tools::findElement(description, e.path).addExtension(e.key, entry);
+  }
+  printout(INFO,"GeometryCache","+++ Restored %ld extensions from %s.",
+           long(m_extensions.size()), extensionsFile().c_str());
+}
+
+/// Save the extensions of the description to the cache entry
+bool GeometryCache::saveExtensions(const string& file_name)   {
+  unique_ptr<TFile> file(TFile::Open(file_name.c_str(), "RECREATE"));
+  if ( !file || file->IsZombie() )   {
+    return false;
+  }
+  for( size_t i = 0; i < m_extensions.size(); ++i )   {
+    const Extension& e = m_extensions[i];
+    TClass* cls = TClass::GetClass(e.type.c_str());
+    if ( file->WriteObjectAny(e.entry->object(), cls, ("extension_"+to_string(i)).c_str()) <= 0 )   {
+      return false;
+    }
+  }
+  file->Close();
+  return true;
+}
+
+/// Compute the cache entry for a compact file
+const string& GeometryCache::entry(Detector& description, const string& compact, DetectorBuildType type)   {
+  string path = absolute_path(compact);
+  string stem = path.substr(path.rfind('/')+1);
+  stringstream key;
+  key << path << '\n' << int(type) << '\n'
+      << DD4HEP_MAJOR_VERSION << '.' << DD4HEP_MINOR_VERSION << '\n'
+      << ROOT_VERSION_CODE << '\n';
+  for( const auto& c : description.constants() )
+    key << c.first << '=' << c.second->GetTitle() << '\n';
+  char text[32];
+  ::snprintf(text, sizeof(text), "%016llx", detail::hash64(key.str()));
+  m_entry = m_directory + "/" + stem.substr(0, stem.rfind('.')) + "." + text;
+  return m_entry;
+}
+
+/// Name of the ROOT file of the cache entry
+string GeometryCache::dataFile()  const   {
+  return m_entry + ".root";
+}
+
+/// Name of the manifest of the cache entry
+string GeometryCache::manifestFile()  const   {
+  return m_entry + ".manifest";
+}
+
+/// Name of the ROOT file with the extensions of the cache entry
+string GeometryCache::extensionsFile()  const   {
+  return m_entry + ".extensions.root";
+}
+
+/// Load the description from the cache entry. Returns false if the entry is missing or outdated
+bool GeometryCache::load(Detector& description)   {
+  if ( !enabled() || m_entry.empty() )   {
+    return false;
+  }
+  ifstream manifest(manifestFile());
+  if ( !manifest.good() )   {
+    printout(INFO,"GeometryCache","+++ No cache entry %s.",m_entry.c_str());
+    return false;
+  }
+  string line;
+  m_extensions.clear();
+  while( getline(manifest, line) )   {
+    if ( line.empty() || line[0] == '#' ) continue;
+    string tag, stamp, path;
+    istringstream in(line);
+    in >> tag >> stamp >> ws;
+    if ( tag == "extension" )   {
+      /// Extension lines: extension <key> <path or '-'> <class name>
+      Extension e;
+      in >> path >> ws;
+      getline(in, e.type);
+      e.key  = ::strtoull(stamp.c_str(), 0, 16);
+      e.path = path == "-" ? "" : path;
+      TClass* cls = TClass::GetClass(e.type.c_str());
+      if ( cls && cls->HasDictionary() )   {
+        m_extensions.emplace_back(e);
+        continue;
+      }
+      printout(INFO,"GeometryCache","+++ Cache entry %s is outdated. No dictionary for extension type %s",
+               m_entry.c_str(), e.type.c_str());
+      return false;
+    }
+    getline(in, path);
+    if ( (tag == "file"    && stamp == file_stamp(path)) ||
+         (tag == "library" && stamp == library_stamp(path)) )   {
+      continue;
+    }
+    printout(INFO,"GeometryCache","+++ Cache entry %s is outdated. Changed input: %s",
+             m_entry.c_str(), path.c_str());
+    return false;
+  }
+  try  {
+    if ( 1 != DD4hepRootPersistency::load(description, dataFile().c_str(), "Geometry") )   {
+      return false;
+    }
+  }
+  catch(const exception& e)   {
+    printout(WARNING,"GeometryCache","+++ Failed to load cache entry %s: %s",
+             dataFile().c_str(), e.what());
+    return false;
+  }
+  printout(INFO,"GeometryCache","+++ Loaded detector description from cache entry %s.",
+           dataFile().c_str());
+  /// The description is loaded: missing extensions are fatal
+  loadExtensions(description);
+  return true;
+}
+
+/// Save the built description and the manifest of the recorded inputs to the cache entry
+bool GeometryCache::save(Detector& description)   {
+  if ( !enabled() || m_entry.empty() )   {
+    return false;
+  }
+  if ( description.state() != Detector::READY )   {
+    printout(WARNING,"GeometryCache","+++ Detector description is not closed. Not cached.");
+    return false;
+  }
+  m_extensions.clear();
+  if ( !checkFields(description) || !collectExtensions(description, m_extensions) )   {
+    return false;
+  }
+  set<string>  files, libs;
+  size_t       num_libs = 0;
+  stringstream manifest;
+  manifest << "# DD4hep geometry cache manifest: <type> <stamp> <path>" << endl;
+  for( const auto& f : m_files ) files.insert(absolute_path(f));
+  for( const auto& f : files )
+    manifest << "file " << file_stamp(f) << " " << f << endl;
+  /// All loaded libraries may have contributed: detector constructors,
+  /// plugins and the DD4hep libraries. Only system libraries are skipped.
+  for( const auto& l : loadedLibraries() )   {
+    if ( !system_library(l) && libs.insert(l).second )   {
+      manifest << "library " << library_stamp(l) << " " << l << endl;
+      ++num_libs;
+    }
+  }
+  for( const auto& e : m_extensions )   {
+    char key[32];
+    ::snprintf(key, sizeof(key), "%016llx", e.key);
+    manifest << "extension " << key << " " << (e.path.empty() ? "-" : e.path) << " " << e.type << endl;
+  }
+  /// Concurrent jobs may refresh the same entry: write to temporaries and rename
+  string tmp = m_entry + "." + to_string(::getpid()) + ".tmp";
+  gSystem->mkdir(m_directory.c_str(), kTRUE);
+  if ( DD4hepRootPersistency::save(description, tmp.c_str(), "Geometry") <= 0 ||
+       0 != ::rename(tmp.c_str(), dataFile().c_str()) )   {
+    printout(WARNING,"GeometryCache","+++ Failed to write cache entry %s.",dataFile().c_str());
+    ::remove(tmp.c_str());
+    return false;
+  }
+  if ( !m_extensions.empty() &&
+       (!saveExtensions(tmp) || 0 != ::rename(tmp.c_str(), extensionsFile().c_str())) )   {
+    printout(WARNING,"GeometryCache","+++ Failed to write cache extensions %s.",extensionsFile().c_str());
+    ::remove(tmp.c_str());
+    return false;
+  }
+  ofstream out(tmp);
+  out << manifest.str();
+  out.close();
+  if ( !out.good() || 0 != ::rename(tmp.c_str(), manifestFile().c_str()) )   {
+    printout(WARNING,"GeometryCache","+++ Failed to write cache manifest %s.",manifestFile().c_str());
+    ::remove(tmp.c_str());
+    return false;
+  }
+  printout(INFO,"GeometryCache","+++ Saved detector description to cache entry %s "
+           "[%ld files, %ld libraries, %ld extensions].",
+           dataFile().c_str(), files.size(), num_libs, long(m_extensions.size()));
+  return true;
+}
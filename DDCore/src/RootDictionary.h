@@ -164,6 +164,8 @@ template class dd4hep::Handle<TNamed>;
 #pragma link C++ class dd4hep::Handle<dd4hep::SolenoidField>+;
 #pragma link C++ class dd4hep::DipoleField+;
 #pragma link C++ class dd4hep::Handle<dd4hep::DipoleField>+;
+#pragma link C++ class dd4hep::GridField+;
+#pragma link C++ class dd4hep::Handle<dd4hep::GridField>+;
 
 #pragma link C++ class dd4hep::IDDescriptor+;
 #pragma link C++ class dd4hep::IDDescriptorObject+;
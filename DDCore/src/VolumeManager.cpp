@@ -341,6 +341,7 @@ VolumeManager::VolumeManager(const Detector& description, const string& nam, Det
     obj_ptr->flags = flags;
     p.populate(elt);
     node_count = p.numNodes();
+    obj_ptr->freeze();
   }
   printout(INFO, "VolumeManager", " - populating volume ids - done. %ld nodes.",node_count);
 }
@@ -442,6 +443,35 @@ IDDescriptor VolumeManager::idSpec() const {
   return _data().id;
 }
 
+/// Compile all sections into one flat lookup table used by lookupContext
+void VolumeManager::freeze()   {
+  if ( isValid() )  {
+    Object& o = _data();
+    if ( o.top ) o.top->freeze();
+    return;
+  }
+  except("VolumeManager","freeze: Failed to compile lookup table [Invalid Manager Handle]");
+}
+
+/// Drop the flat lookup table. Lookups are then served by the section maps
+void VolumeManager::unfreeze()   {
+  if ( isValid() )  {
+    Object& o = _data();
+    if ( o.top ) o.top->unfreeze();
+    return;
+  }
+  except("VolumeManager","unfreeze: Failed to drop lookup table [Invalid Manager Handle]");
+}
+
+/// Check if the lookups are served by the flat lookup table
+bool VolumeManager::isFrozen()  const   {
+  if ( isValid() )  {
+    const Object& o = _data();
+    return o.top && o.top->lookup;
+  }
+  return false;
+}
+
 /// Register physical volume with the manager (normally: section manager)
 bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* context) {
   stringstream err;
@@ -461,6 +491,7 @@ bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* contex
   }
 
   if ( i == o.volumes.end()) {
+    if ( o.top ) o.top->unfreeze();
     o.volumes[vid] = context;
     o.detMask |= mask;
     err << "Inserted new volume:" << setw(6) << left << o.volumes.size()
@@ -547,6 +578,12 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
     if ( !is_top && one_tree ) {
       return VolumeManager(o.top).lookupContext(volume_id);
     }
+    /// If the top level manager is frozen, the flat lookup table holds all entries
+    if ( is_top && o.lookup )  {
+      if ( (c = o.lookup->search(volume_id)) != 0 )
+        return c;
+      except("VolumeManager","lookupContext: Failed to search Volume context %016llX [Unknown identifier]", (void*)volume_id);
+    }
     VolumeID id = volume_id;
     /// First look in our own volume cache if the entry is found.
     c = o.search(id);
@@ -651,6 +688,8 @@ std::ostream& dd4hep::operator<<(std::ostream& os, const VolumeManager& m) {
 
 /// Default destructor
 VolumeManagerObject::~VolumeManagerObject() {
+  /// Cleanup frozen lookup table
+  detail::deletePtr(lookup);
   /// Cleanup volume tree
   destroyObjects(volumes);
   /// Cleanup dependent managers
@@ -676,3 +715,69 @@ VolumeManagerContext* VolumeManagerObject::search(const VolumeID& vol_id) const
   return (i == volumes.end()) ? 0 : (*i).second;
 }
 
+
+/// Compile the frozen lookup table of the top level manager
+void VolumeManagerObject::freeze()   {
+  detail::deletePtr(lookup);
+  lookup = new VolumeManagerLookup(*this);
+  printout(DEBUG,"VolumeManager","+++ Frozen lookup table: %ld sections %ld entries in %ld slots.",
+           lookup->sections.size(), lookup->entries, lookup->slots.size());
+}
+
+/// Drop the frozen lookup table of the top level manager
+void VolumeManagerObject::unfreeze()   {
+  detail::deletePtr(lookup);
+}
+
+/// Compile the lookup table from a populated top level volume manager
+VolumeManagerLookup::VolumeManagerLookup(const VolumeManagerObject& top)   {
+  vector<const VolumeManagerObject*> objs;
+  size_t count = 0, capacity = 16;
+  bool one_tree = (top.flags & VolumeManager::ONE) == VolumeManager::ONE;
+
+  /// Keep the search sequence of VolumeManager::lookupContext: first the top, then the sections
+  /// Empty sections are not considered: they would only cost useless probes.
+  if ( !top.volumes.empty() )
+    objs.emplace_back(&top);
+  if ( !one_tree )  {
+    for( const auto& j : top.subdetectors )
+      if ( !j.second->volumes.empty() ) objs.emplace_back(j.second.ptr());
+  }
+  for( const auto* o : objs )  {
+    Section sec;
+    sec.detMask = o->detMask;
+    /// Pre-select by the system field only if it is fully part of the lookup key
+    if ( o->system && (o->detMask&o->system->mask()) == o->system->mask() )  {
+      sec.sysMask = o->system->mask();
+      sec.sysBits = (o->sysID << o->system->offset()) & sec.sysMask;
+    }
+    sections.emplace_back(sec);
+    count += o->volumes.size();
+  }
+  /// Keep the load factor below 50 percent to have short probe sequences
+  while ( capacity < 2*count ) capacity <<= 1;
+  slots.resize(capacity);
+  slotMask = capacity-1;
+  for( size_t i = 0; i < objs.size(); ++i )  {
+    for( const auto& v : objs[i]->volumes )
+      insert(i, v.second);
+  }
+}
+
+/// Insert a new context into the table
+bool VolumeManagerLookup::insert(size_t section, VolumeManagerContext* context)   {
+  VolumeID key = context->identifier & sections[section].detMask;
+  for( VolumeID idx = hash(key, section)&slotMask; ; idx = (idx+1)&slotMask )  {
+    Slot& slot = slots[idx];
+    if ( 0 == slot.context )  {
+      slot.key     = key;
+      slot.context = context;
+      slot.section = section;
+      ++entries;
+      return true;
+    }
+    if ( slot.key == key && slot.section == section )  {
+      return false;
+    }
+  }
+}
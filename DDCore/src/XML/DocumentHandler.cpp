@@ -41,6 +41,11 @@ namespace {
     return fn;
   }
   int s_minPrintLevel = INFO;
+  std::vector<std::string>* s_fileRecorder = 0;
+  /// Record the path of a successfully loaded XML file
+  void record_file(const string& path)   {
+    if ( s_fileRecorder && !path.empty() ) s_fileRecorder->push_back(path);
+  }
 }
 
 #ifndef __TIXML__
@@ -348,6 +353,7 @@ Document DocumentHandler::load(const string& fname, UriReader* reader) const   {
     if ( !path.empty() )  {
       parser->parse(path.c_str());
       if ( reader ) reader->parserLoaded(path);
+      record_file(path);
     }
     else   {
       if ( reader && reader->load(fname, path) )  {
@@ -363,6 +369,7 @@ Document DocumentHandler::load(const string& fname, UriReader* reader) const   {
     try {
       parser->parse(fname.c_str());
       if ( reader ) reader->parserLoaded(path);
+      record_file(fname);
     }
     catch (const exception& ex) {
       printout(FATAL,"DocumentHandler","+++ Exception(XercesC): parse(URI):%s",ex.what());
@@ -514,6 +521,7 @@ Document DocumentHandler::load(const std::string& fname, UriReader* reader) cons
     printout(ERROR,"DocumentHandler","+++ Exception (TinyXML): parse(path):%s",e.what());
   }
   if ( result ) {
+    record_file(clean);
     if ( s_minPrintLevel <= INFO ) {
       printout(INFO,"DocumentHandler","+++ Document %s succesfully parsed with TinyXML .....",
                fname.c_str());
@@ -627,6 +635,18 @@ int DocumentHandler::setMinimumPrintLevel(int level)    {
   return tmp;
 }
 
+/// Record the paths of all XML files loaded from now on (0 stops recording)
+std::vector<std::string>* DocumentHandler::setFileRecorder(std::vector<std::string>* files)   {
+  std::vector<std::string>* tmp = s_fileRecorder;
+  s_fileRecorder = files;
+  return tmp;
+}
+
+/// Record a non-XML input file (e.g. a field map) read while the recorder is active
+void DocumentHandler::recordFile(const std::string& path)   {
+  record_file(undressed_file_name(path));
+}
+
 /// Default comment string
 std::string DocumentHandler::defaultComment()  {
   const char comment[] = "\n"
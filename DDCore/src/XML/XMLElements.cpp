@@ -298,13 +298,11 @@ long dd4hep::xml::_toLong(const XmlChar* value) {
       s.erase(idx, 6);
     while (s[0] == ' ')
       s.erase(0, 1);
-    double result = eval.evaluate(s.c_str());
-    if (eval.status() != tools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
+    pair<int,double> result = eval.evaluate(s, cerr);
+    if (result.first != tools::Evaluator::OK) {
       throw runtime_error("dd4hep: Severe error during expression evaluation of " + s);
     }
-    return (long) result;
+    return (long) result.second;
   }
   return -1;
 }
@@ -338,14 +336,11 @@ bool dd4hep::xml::_toBool(const XmlChar* value) {
 float dd4hep::xml::_toFloat(const XmlChar* value) {
   if (value) {
     string s = _toString(value);
-    double result = eval.evaluate(s.c_str());
-
-    if (eval.status() != tools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
+    pair<int,double> result = eval.evaluate(s, cerr);
+    if (result.first != tools::Evaluator::OK) {
       throw runtime_error("dd4hep: Severe error during expression evaluation of " + s);
     }
-    return (float) result;
+    return (float) result.second;
   }
   return 0.0;
 }
@@ -353,13 +348,11 @@ float dd4hep::xml::_toFloat(const XmlChar* value) {
 double dd4hep::xml::_toDouble(const XmlChar* value) {
   if (value) {
     string s = _toString(value);
-    double result = eval.evaluate(s.c_str());
-    if (eval.status() != tools::Evaluator::OK) {
-      cerr << s << ": ";
-      eval.print_error();
+    pair<int,double> result = eval.evaluate(s, cerr);
+    if (result.first != tools::Evaluator::OK) {
       throw runtime_error("dd4hep: Severe error during expression evaluation of " + s);
     }
-    return result;
+    return result.second;
   }
   return 0.0;
 }
@@ -371,13 +364,11 @@ void dd4hep::xml::_toDictionary(const XmlChar* name, const XmlChar* value) {
     v.erase(idx, 5);
   while (v[0] == ' ')
     v.erase(0, 1);
-  double result = eval.evaluate(v.c_str());
-  if (eval.status() != tools::Evaluator::OK) {
-    cerr << v << ": ";
-    eval.print_error();
+  pair<int,double> result = eval.evaluate(v, cerr);
+  if (result.first != tools::Evaluator::OK) {
     throw runtime_error("dd4hep: Severe error during expression evaluation of " + v);
   }
-  eval.setVariable(n.c_str(), result);
+  eval.setVariable(n.c_str(), result.second);
 }
 
 /// Helper function to populate the evaluator dictionary  \ingroup DD4HEP_XML
@@ -89,6 +89,7 @@ static long gdml_parse(Detector& description, int argc, char** argv) {
           TUri uri(input.c_str());
           input = uri.GetRelativePart();
           Volume vol = parser.GDMLReadFile(input.c_str());
+          xml::DocumentHandler::recordFile(input);
           if ( vol.isValid() )   {
             vol.import(); // We require the extensions in dd4hep.
             pv = mother.placeVolume(vol);
@@ -113,6 +114,7 @@ static long gdml_parse(Detector& description, int argc, char** argv) {
       TUri uri(input.c_str());
       input = uri.GetRelativePart();
       Volume vol = parser.GDMLReadFile(input.c_str());
+      xml::DocumentHandler::recordFile(input);
       if ( vol.isValid() )   {
         vol.import(); // We require the extensions in dd4hep.
         description.manager().SetTopVolume(vol.ptr());
@@ -285,6 +287,7 @@ static Ref_t create_detector(Detector& description, xml_h e, Ref_t /* sens_det *
   }  
   DetElement  sdet(name, id);
   Volume volume = parser.GDMLReadFile(gdml.c_str());
+  xml::DocumentHandler::recordFile(gdml);
   if ( !volume.isValid() )   {
     except("ROOTGDMLParse","+++ Failed to parse GDML file:%s",gdml.c_str());
   }
@@ -257,6 +257,34 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+static Ref_t create_GridField(Detector& /* description */, xml_h e) {
+  xml_dim_t c(e), child;
+  CartesianField obj;
+  GridField* ptr = new GridField();
+  if (c.hasAttr(_U(field)))  {
+    string t = c.attr<string>(_U(field));
+    ptr->type = ::toupper(t[0]) == 'E' ? CartesianField::ELECTRIC : CartesianField::MAGNETIC;
+  }
+  if (c.hasAttr(_U(lunit))) ptr->lunit = c.attr<double>(_U(lunit));
+  if (c.hasAttr(_U(funit))) ptr->funit = c.attr<double>(_U(funit));
+  if (c.hasAttr(_U(cache))) ptr->cache_cell = c.attr<bool>(_U(cache));
+  if ((child = c.child(_U(position), false))) {   // Position is not mandatory!
+    ptr->offset.SetXYZ(child.x(0.0), child.y(0.0), child.z(0.0));
+  }
+  try  {
+    string file_name = c.attr<string>(_U(file));
+    ptr->load(file_name);
+    xml::DocumentHandler::recordFile(file_name);
+  }
+  catch(const exception& ex)  {
+    delete ptr;
+    throw_print(string("Compact2Objects[ERROR]: ")+ex.what());
+  }
+  obj.assign(ptr, c.nameStr(), c.typeStr());
+  return obj;
+}
+DECLARE_XMLELEMENT(FieldMap,create_GridField)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
@@ -121,3 +121,25 @@ static Handle<NamedObject> convert_multipole(Detector&, xml_h field, Handle<Name
   return object;
 }
 DECLARE_XML_PROCESSOR(MultipoleMagnet_Convert2Detector,convert_multipole)
+
+static Handle<NamedObject> convert_grid_field(Detector&, xml_h field, Handle<NamedObject> object) {
+  xml_doc_t  doc = xml_elt_t(field).document();
+  GridField* fld = object.data<GridField>();
+  field.setAttr(_U(name), object->GetName());
+  field.setAttr(_U(type), object->GetTitle());
+  field.setAttr(_U(file), fld->file);
+  field.setAttr(_U(lunit), fld->lunit);
+  field.setAttr(_U(funit), fld->funit);
+  field.setAttr(_U(cache), fld->cache_cell);
+  if (fld->type == CartesianField::ELECTRIC)
+    field.setAttr(_U(field), "electric");
+  else if (fld->type == CartesianField::MAGNETIC)
+    field.setAttr(_U(field), "magnetic");
+  xml_elt_t x_pos = xml_elt_t(doc, _U(position));
+  x_pos.setAttr(_U(x),fld->offset.x());
+  x_pos.setAttr(_U(y),fld->offset.y());
+  x_pos.setAttr(_U(z),fld->offset.z());
+  field.append(x_pos);
+  return object;
+}
+DECLARE_XML_PROCESSOR(FieldMap_Convert2Detector,convert_grid_field)
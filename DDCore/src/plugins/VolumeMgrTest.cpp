@@ -22,7 +22,13 @@
 #include "DD4hep/AlignmentsNominalMap.h"
 #include "DD4hep/detail/VolumeManagerInterna.h"
 
+// ROOT include files
+#include "TTimeStamp.h"
+
 // C/C++ include files
+#include <cerrno>
+#include <cstring>
+#include <random>
 #include <stdexcept>
 #include <algorithm>
 
@@ -323,3 +329,77 @@ long VolIDTest::run(Detector& description,int argc,char** argv)    {
 }
 
 DECLARE_APPLY(DD4hep_VolumeMgrTest,VolIDTest::run)
+
+namespace  {
+
+  /// Measure the lookup throughput of the volume manager
+  /**
+   *  Compares the lookup speed of the section maps with the
+   *  frozen flat lookup table of the volume manager.
+   *
+   *  Arguments: -turns <number>  Number of passes over all registered volume identifiers
+   *
+   *  @author  M.Frank
+   *  @version 1.0
+   */
+  long volmgr_benchmark(Detector& description, int argc, char** argv)   {
+    size_t turns = 10;
+    for(int i = 0; i < argc && argv[i]; ++i)  {
+      if ( 0 == ::strncmp("-turns",argv[i],4) && i+1 < argc )
+        turns = ::atol(argv[++i]);
+      else  {
+        cout <<
+          "Usage: -plugin DD4hep_VolumeMgrBenchmark -arg [-arg]                  \n"
+          "     -turns <number>   Number of passes over all volume identifiers.   \n"
+          "\tArguments given: " << arguments(argc,argv) << endl << flush;
+        ::exit(EINVAL);
+      }
+    }
+    VolumeManager mgr = VolumeManager::getVolumeManager(description);
+    vector<VolumeID> ids;
+    for( const auto& s : mgr->subdetectors )  {
+      for( const auto& v : s.second->volumes )
+        ids.emplace_back(v.first);
+    }
+    for( const auto& v : mgr->volumes )
+      ids.emplace_back(v.first);
+    if ( ids.empty() )  {
+      except("VolumeMgrBenchmark","+++ The volume manager has no registered volumes.");
+    }
+    /// Access the identifiers in random order to defeat trivial caching effects
+    shuffle(ids.begin(), ids.end(), mt19937(12345));
+
+    bool   frozen = mgr.isFrozen();
+    size_t errors = 0;
+    auto measure = [&ids, &mgr, &errors, turns](const char* tag)  {
+      size_t    count = 0;
+      TTimeStamp start;
+      for( size_t t = 0; t < turns; ++t )  {
+        for( VolumeID vid : ids )  {
+          const VolumeManagerContext* c = mgr.lookupContext(vid);
+          if ( c->identifier != (vid&c->mask) ) ++errors;
+          ++count;
+        }
+      }
+      TTimeStamp stop;
+      double secs = stop.AsDouble()-start.AsDouble();
+      printout(ALWAYS,"VolumeMgrBenchmark","+++ %-12s %10ld lookups in %8.3f seconds: %12.0f lookups/second",
+               tag, count, secs, secs > 0e0 ? double(count)/secs : 0e0);
+      return secs;
+    };
+    mgr.unfreeze();
+    double t_map = measure("Section maps");
+    mgr.freeze();
+    double t_tab = measure("Flat table");
+    if ( !frozen ) mgr.unfreeze();
+    printout(ALWAYS,"VolumeMgrBenchmark","+++ %ld volume identifiers. Speedup flat table / maps: %.2f",
+             ids.size(), t_tab > 0e0 ? t_map/t_tab : 0e0);
+    if ( errors > 0 )  {
+      printout(ERROR,"VolumeMgrBenchmark","+++ FAILED: %ld lookups returned a wrong context.",errors);
+      return 0;
+    }
+    printout(ALWAYS,"VolumeMgrBenchmark","+++ PASSED: All lookups returned consistent contexts.");
+    return 1;
+  }
+}
+DECLARE_APPLY(DD4hep_VolumeMgrBenchmark,volmgr_benchmark)
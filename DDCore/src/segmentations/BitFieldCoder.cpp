@@ -42,18 +42,6 @@ namespace dd4hep{
       }
     }
   
-    long64 BitFieldElement::value(long64 id) const { 
-      if(  _isSigned   ) {
-        long64 val = ( id & _mask ) >> _offset ;
-        if( ( val  & ( 1LL << ( _width - 1 ) ) ) != 0 ) { // negative value
-          val -= ( 1LL << _width );
-        }
-        return val ;
-      } else { 
-        return  ( id & _mask ) >> _offset ;
-      }
-    }
-
     void BitFieldElement::set(long64& field, long64 in) const {
     
       // check range 
@@ -206,6 +194,14 @@ namespace dd4hep{
 
         addField( name , thisOffset, width ) ;
       }
+      buildHandles() ;
+    }
+
+    void BitFieldCoder::buildHandles() {
+
+      _handles.clear() ;
+      for( const auto& f : _fields )
+        _handles.emplace( f.name(), BitFieldHandle( f ) ) ;
     }
 
 
@@ -22,6 +22,7 @@
 // C/C++ include files
 #include <string>
 #include <cstdarg>
+#include <typeinfo>
 
 #if defined(G__ROOT) || defined(__CLING__) || defined(__ROOTCLING__)
 #define DDDIGI_DEFINE_ACTION_DEFAULT_CTOR(action)  public: action() = default;
@@ -297,8 +298,21 @@ namespace dd4hep {
       /// Support of exceptions: Print fatal message and throw runtime_error.
       void except(const char* fmt, ...) const;
 
+      /// Declare an event data slot read by this action. To be called at initialization
+      template <typename T> DigiSlot<T> declareInput(const std::string& nam, int mask = 0)  {
+        return DigiSlot<T>(this->declareSlot(nam, mask, typeid(T), false));
+      }
+      /// Declare an event data slot written by this action. To be called at initialization
+      template <typename T> DigiSlot<T> declareOutput(const std::string& nam, int mask = 0)  {
+        return DigiSlot<T>(this->declareSlot(nam, mask, typeid(T), true));
+      }
+
       /// Optional action initialization if required
       virtual void initialize();
+
+    protected:
+      /// Declare an event data slot in the slot registry of the kernel
+      std::size_t declareSlot(const std::string& nam, int mask, const std::type_info& type, bool output);
     };
 
     /// Declare property
@@ -16,6 +16,7 @@
 // Framework incloude files
 #include "DD4hep/Primitives.h"
 #include "DDDigi/DigiData.h"
+#include "DDDigi/DigiRandomGenerator.h"
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -29,6 +30,7 @@ namespace dd4hep {
 
     /// Forward declarations
     class DigiActionSequence;
+    class DigiAction;
     class DigiKernel;
 
     /// Generic context to extend user, run and event information
@@ -118,6 +120,13 @@ namespace dd4hep {
       DigiActionSequence& eventAction() const;
       /// Access to the main output action sequence from the kernel object
       DigiActionSequence& outputAction() const;
+      /// Random number stream of an action for the current event
+      /** The stream is defined by the run seed, the event number and the action name.
+       *  It is independent of the number of threads and the scheduling order.
+       */
+      DigiRandomGenerator randomGenerator(const DigiAction& action)  const;
+      /// Random number stream with a given name for the current event
+      DigiRandomGenerator randomGenerator(const std::string& stream_name)  const;
     };
 
   }    // End namespace digi
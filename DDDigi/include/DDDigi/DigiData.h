@@ -24,7 +24,9 @@
 #include <functional>
 #include <stdexcept>
 #include <cstdint>
+#include <cstddef>
 #include <memory>
+#include <vector>
 #include <map>
 
 /// Namespace for the AIDA detector description toolkit
@@ -77,6 +79,8 @@ namespace dd4hep {
       public:
         std::function<long long int(const void*)> cellID;
         std::function<long(const void*)>          flag;
+        /// Optional: deposits of tables without time accessor have the time 0
+        std::function<double(const void*)>        time;
         FunctionTable() = default;
         ~FunctionTable() = default;
       };
@@ -101,6 +105,8 @@ namespace dd4hep {
 
       long long int cellID()  const    {   return object.second->cellID(object.first);     }
       long          flag()  const      {   return object.second->flag(object.first);       }
+      double        time()  const
+      {   return object.second->time ? object.second->time(object.first) : 0e0;            }
     };
 
     template <typename T> inline EnergyDeposit::EnergyDeposit(const T* ptr)
@@ -252,9 +258,189 @@ namespace dd4hep {
       DigiCount& operator=(const DigiCount& copy) = delete;      
     };
 
+    /// Columnar view of cell data to process signals of many cells at once
+    /*
+     *  The columns are not owned by the view.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiCellColumns   {
+    public:
+      std::size_t    size      { 0 };
+      const double*  raw_value { nullptr };
+      const double*  delay     { nullptr };
+      unsigned char* kill      { nullptr };
+    };
+
     typedef DigiContainer<EnergyDeposit*> DigiEnergyDeposits;
     typedef DigiContainer<DigiCount*>     DigiCounts;
 
+    /// Memory arena with the lifetime of one event
+    /*
+     *  Memory is handed out from large blocks and only released
+     *  all together when the arena is reset or destroyed.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiArena   {
+    public:
+      /// Default size of the arena's memory blocks
+      static constexpr std::size_t BLOCK_SIZE = 256*1024;
+      /// Default alignment of the allocations (cache line)
+      static constexpr std::size_t ALIGNMENT  = 64;
+
+    protected:
+      std::vector<std::pair<unsigned char*,std::size_t> > m_blocks;
+      unsigned char* m_current  { nullptr };
+      std::size_t    m_free     { 0 };
+
+      /// Allocate a new block able to serve at least len bytes
+      void* newBlock(std::size_t len, std::size_t align);
+
+    public:
+      /// Default constructor
+      DigiArena() = default;
+      /// Disable move constructor
+      DigiArena(DigiArena&& copy) = delete;
+      /// Disable copy constructor
+      DigiArena(const DigiArena& copy) = delete;
+      /// Default destructor
+      ~DigiArena();
+      /// Disable move assignment
+      DigiArena& operator=(DigiArena&& copy) = delete;
+      /// Disable copy assignment
+      DigiArena& operator=(const DigiArena& copy) = delete;
+
+      /// Allocate uninitialized memory from the arena
+      void* allocate(std::size_t len, std::size_t align = ALIGNMENT)   {
+        std::size_t pad = (align - (reinterpret_cast<std::uintptr_t>(m_current) & (align-1))) & (align-1);
+        if ( m_current && pad + len <= m_free )   {
+          void* ptr = m_current + pad;
+          m_current += pad + len;
+          m_free    -= pad + len;
+          return ptr;
+        }
+        return newBlock(len, align);
+      }
+      /// Allocate an uninitialized array of trivial objects from the arena
+      template <typename T> T* allocate_array(std::size_t n)   {
+        return static_cast<T*>(this->allocate(n*sizeof(T), ALIGNMENT));
+      }
+      /// Release all memory of the arena
+      void reset();
+      /// Total number of bytes reserved by the arena
+      std::size_t capacity()  const;
+    };
+
+    /// Container class to host energy deposits as parallel columns
+    /*
+     *  Structure of arrays alternative to DigiEnergyDeposits:
+     *  cell identifiers, energies, times and positions of all deposits
+     *  are held in contiguous, cache line aligned arrays allocated
+     *  from the arena of the event. Signal processing may thus loop
+     *  over whole columns. The column pointers are invalidated when
+     *  the container grows and the data are only valid as long as
+     *  the arena is alive.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDepositColumns   {
+      /// Unique name within the event
+      std::string    name;
+      /// Reference to the memory arena of the event
+      DigiArena*     m_arena     { nullptr };
+      /// Number of deposits
+      std::size_t    m_size      { 0 };
+      /// Allocated number of deposits
+      std::size_t    m_capacity  { 0 };
+      CellID*        m_cellID    { nullptr };
+      long*          m_flag      { nullptr };
+      double*        m_deposit   { nullptr };
+      double*        m_time      { nullptr };
+      double*        m_x         { nullptr };
+      double*        m_y         { nullptr };
+      double*        m_z         { nullptr };
+
+    public:
+      /// Initializing constructor
+      DigiDepositColumns(DigiArena& arena, const std::string& nam = "");
+      /// Disable move constructor
+      DigiDepositColumns(DigiDepositColumns&& copy) = delete;
+      /// Disable copy constructor
+      DigiDepositColumns(const DigiDepositColumns& copy) = delete;
+      /// Default destructor. The memory is owned by the arena.
+      ~DigiDepositColumns() = default;
+      /// Disable move assignment
+      DigiDepositColumns& operator=(DigiDepositColumns&& copy) = delete;
+      /// Disable copy assignment
+      DigiDepositColumns& operator=(const DigiDepositColumns& copy) = delete;
+
+      /// Access the container name
+      const std::string& containerName()  const  {  return name;        }
+      /// Number of deposits
+      std::size_t size()  const                  {  return m_size;      }
+      /// Check if the container has deposits
+      bool empty()  const                        {  return 0 == m_size; }
+      /// Reserve space for at least n deposits
+      void reserve(std::size_t n);
+      /// Remove all deposits. The memory stays with the arena.
+      void clear()                               {  m_size = 0;         }
+
+      /// Add a new deposit
+      void push_back(CellID cell, double deposit, double time, const Position& pos, long flag = 0)  {
+        if ( m_size == m_capacity ) this->reserve(m_capacity ? 2*m_capacity : 64);
+        m_cellID [m_size] = cell;
+        m_flag   [m_size] = flag;
+        m_deposit[m_size] = deposit;
+        m_time   [m_size] = time;
+        m_x      [m_size] = pos.X();
+        m_y      [m_size] = pos.Y();
+        m_z      [m_size] = pos.Z();
+        ++m_size;
+      }
+      /// Migration: add a deposit from the polymorphic representation
+      void add(const EnergyDeposit& deposit);
+      /// Migration: add all deposits of a container of polymorphic deposits
+      std::size_t add(const DigiEnergyDeposits& deposits);
+
+      /// Access the cell identifier column
+      CellID*       cellIDs()                    {  return m_cellID;    }
+      const CellID* cellIDs()  const             {  return m_cellID;    }
+      /// Access the flag column
+      long*         flags()                      {  return m_flag;      }
+      const long*   flags()  const               {  return m_flag;      }
+      /// Access the energy deposit column
+      double*       deposits()                   {  return m_deposit;   }
+      const double* deposits()  const            {  return m_deposit;   }
+      /// Access the deposit time column
+      double*       times()                      {  return m_time;      }
+      const double* times()  const               {  return m_time;      }
+      /// Access the position column for the x-coordinate
+      const double* x()  const                   {  return m_x;         }
+      /// Access the position column for the y-coordinate
+      const double* y()  const                   {  return m_y;         }
+      /// Access the position column for the z-coordinate
+      const double* z()  const                   {  return m_z;         }
+      /// Access the position of a single deposit
+      Position position(std::size_t i)  const    {  return Position(m_x[i], m_y[i], m_z[i]); }
+
+      /// Cell data view of the deposits for the signal processing
+      DigiCellColumns cellColumns(unsigned char* kill)  const  {
+        DigiCellColumns cells;
+        cells.size      = m_size;
+        cells.raw_value = m_deposit;
+        cells.delay     = m_time;
+        cells.kill      = kill;
+        return cells;
+      }
+    };
+
     ///  Key defintion to access the event data
     /**
      *  Helper to convert item and mask to a 64 bit integer
@@ -281,6 +467,37 @@ namespace dd4hep {
       key_type toLong()  const  {  return key; }
       void set(const std::string& name, int mask);
     };
+
+    ///  Typed handle to a data slot of the event
+    /**
+     *  Slots are declared by the actions at initialization time in the
+     *  slot registry of the kernel (see DigiSlotRegistry). The handle
+     *  only holds the slot index: the access to the event data is
+     *  a plain array access without any type check at run time.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    template <typename T> class DigiSlot   {
+    public:
+      /// Data type of the slot
+      typedef T type;
+      /// Slot index in the event
+      std::size_t index  { std::size_t(-1) };
+
+    public:
+      /// Default constructor: invalid slot
+      DigiSlot() = default;
+      /// Initializing constructor
+      explicit DigiSlot(std::size_t idx) : index(idx) {}
+      /// Default copy constructor
+      DigiSlot(const DigiSlot& copy) = default;
+      /// Default assignment
+      DigiSlot& operator=(const DigiSlot& copy) = default;
+      /// Check if the slot was declared
+      bool isValid()  const  {  return index != std::size_t(-1); }
+    };
     
     ///  User event data for DDDigi
     /**
@@ -293,11 +510,17 @@ namespace dd4hep {
     public:
       /// Forward definition of the key type
       typedef Key::key_type key_type;
+      /// Memory arena for data with the lifetime of the event
+      DigiArena                                                      arena;
       std::map<unsigned long, std::shared_ptr<DigiEnergyDeposits> >  energyDeposits;
       std::map<unsigned long, std::shared_ptr<DigiCounts> >          digitizations;
+      /// Columnar energy deposits allocated from the event arena
+      std::map<unsigned long, std::shared_ptr<DigiDepositColumns> >  depositColumns;
 
       int eventNumber = 0;
       std::map<key_type, dd4hep::any>  data;
+      /// Data slots declared in the slot registry. Sized by the context before processing.
+      std::vector<std::shared_ptr<void> > slots;
 
     public:
 #if defined(G__ROOT) || defined(__CLING__) || defined(__ROOTCLING__)
@@ -344,6 +567,38 @@ namespace dd4hep {
         throw std::runtime_error("DigiEvent"); // Will never get here!
       }
 
+      /// Add item to a declared data slot. The object is moved if possible.
+      template<typename T, typename V> bool put(const DigiSlot<T>& slot, V&& object)     {
+        if ( slot.index < slots.size() && !slots[slot.index] )   {
+          slots[slot.index] = std::make_shared<T>(std::forward<V>(object));
+          return true;
+        }
+        except("DigiEvent","Invalid requested to store data in event slot %ld [%ld slots].",
+               long(slot.index), long(slots.size()));
+        throw std::runtime_error("DigiEvent"); // Will never get here!
+      }
+
+      /// Check if a declared data slot is filled
+      template<typename T> bool contains(const DigiSlot<T>& slot)  const    {
+        return slot.index < slots.size() && slots[slot.index];
+      }
+
+      /// Retrieve item from a declared data slot
+      template<typename T> T& get(const DigiSlot<T>& slot)     {
+        if ( slot.index < slots.size() && slots[slot.index] )
+          return *static_cast<T*>(slots[slot.index].get());
+        except("DigiEvent","Invalid data requested from event slot %ld.",long(slot.index));
+        throw std::runtime_error("DigiEvent"); // Will never get here!
+      }
+
+      /// Retrieve item from a declared data slot
+      template<typename T> const T& get(const DigiSlot<T>& slot)  const    {
+        if ( slot.index < slots.size() && slots[slot.index] )
+          return *static_cast<const T*>(slots[slot.index].get());
+        except("DigiEvent","Invalid data requested from event slot %ld.",long(slot.index));
+        throw std::runtime_error("DigiEvent"); // Will never get here!
+      }
+
       /// Add an extension object to the detector element
       void* addExtension(unsigned long long int k, ExtensionEntry* e)  {
         return ObjectExtensions::addExtension(k, e);
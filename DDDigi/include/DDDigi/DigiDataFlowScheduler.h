@@ -0,0 +1,110 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDDIGI_DIGIDATAFLOWSCHEDULER_H
+#define DD4HEP_DDDIGI_DIGIDATAFLOWSCHEDULER_H
+
+/// Framework include files
+#include "DDDigi/DigiSynchronize.h"
+
+/// C/C++ include files
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    // Forward declarations
+    class DigiDataFlowScheduler;
+
+    /// Execute the child actions according to their data dependencies
+    /**
+     *  The execution order of the children is not given by the order of
+     *  adoption, but by the data flow: on first use a dependency graph is
+     *  derived from the event data slots declared by the actions in the
+     *  slot registry (DigiAction::declareInput / declareOutput). An action
+     *  depends on all children producing a slot it consumes. The slots
+     *  declared by nested actions of child sequences are attributed to the
+     *  child. Cyclic dependencies are an error.
+     *
+     *  If the kernel runs multi-threaded, every action is submitted as a task
+     *  as soon as all its producers finished. The tasks run in the same
+     *  TBB task arena as the events processed in parallel: intra-event and
+     *  inter-event concurrency share the same worker threads. Otherwise the
+     *  actions are executed serially in topological order.
+     *
+     *  At destruction a report with the execution time of every action
+     *  and the average number of concurrently running actions is printed.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDataFlowScheduler : public DigiSynchronize {
+    public:
+      /// Node of the dependency graph
+      struct Node  {
+        /// Reference to the scheduled action
+        DigiEventAction*    action  { nullptr };
+        /// Indices of the actions depending on this action
+        std::vector<size_t> successors;
+        /// Number of actions this action depends on
+        int                 num_inputs { 0 };
+        /// Statistics: number of calls
+        std::atomic<long>   calls   { 0 };
+        /// Statistics: accumulated execution time in nanoseconds
+        std::atomic<long>   nanoseconds { 0 };
+      };
+
+    protected:
+      /// Flag to build the dependency graph exactly once
+      mutable std::once_flag                      m_built;
+      /// Dependency graph
+      mutable std::vector<std::unique_ptr<Node> > m_nodes;
+      /// Topological order of the graph
+      mutable std::vector<size_t>                 m_order;
+      /// Statistics: number of processed events
+      mutable std::atomic<long>                   m_events      { 0 };
+      /// Statistics: accumulated wall time of the events in nanoseconds
+      mutable std::atomic<long>                   m_nanoseconds { 0 };
+      /// Statistics: number of currently running actions
+      mutable std::atomic<int>                    m_running     { 0 };
+      /// Statistics: maximal number of concurrently running actions
+      mutable std::atomic<int>                    m_maxRunning  { 0 };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiDataFlowScheduler);
+      /// Build the dependency graph from the declared slots
+      void buildGraph()  const;
+      /// Execute a single node and record the statistics
+      void executeNode(Node& node, DigiContext& context)  const;
+
+    public:
+      /// Standard constructor
+      DigiDataFlowScheduler(const DigiKernel& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiDataFlowScheduler();
+      /// Print the timing and occupancy report
+      void printStatistics()  const;
+      /// Execute the children according to the data flow
+      virtual void execute(DigiContext& context)  const override;
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DD4HEP_DDDIGI_DIGIDATAFLOWSCHEDULER_H
@@ -28,6 +28,7 @@ namespace dd4hep {
 
     /// Forward declarations
     class DigiActionSequence;
+    class DigiSlotRegistry;
     
     /// Class, which allows all DigiAction derivatives to access the DDG4 kernel structures.
     /**
@@ -111,6 +112,10 @@ namespace dd4hep {
       void setOutputLevel(const std::string object, PrintLevel new_level);
       /// Retrieve the global output level of a named object.
       PrintLevel getOutputLevel(const std::string object) const;
+      /// Access the number of worker threads (<= 0: serial processing)
+      int numThreads() const;
+      /// Access the seed of the random number streams of the run (property "randomSeed")
+      unsigned long randomSeed() const;
 
       /// Construct detector geometry using description plugin
       virtual void loadGeometry(const std::string& compact_file);
@@ -126,6 +131,8 @@ namespace dd4hep {
       /// Run the simulation: Terminate Digi
       virtual int terminate();
 
+      /// Access to the registry of the event data slots
+      DigiSlotRegistry& slotRegistry() const;
       /// Access to the main input action sequence from the kernel object
       DigiActionSequence& inputAction() const;
       /// Access to the main event action sequence from the kernel object
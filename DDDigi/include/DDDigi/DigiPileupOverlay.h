@@ -0,0 +1,109 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDDIGI_DIGIPILEUPOVERLAY_H
+#define DD4HEP_DDDIGI_DIGIPILEUPOVERLAY_H
+
+/// Framework include files
+#include "DDDigi/DigiSynchronize.h"
+
+/// C/C++ include files
+#include <mutex>
+#include <memory>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    // Forward declarations
+    class DigiEvent;
+    class DigiPileupOverlay;
+
+    /// Overlay of pile-up events from a memory resident pool of background events
+    /**
+     *  The adopted child actions are the sources of the background events,
+     *  typically input actions like DigiROOTInput with minimum-bias or
+     *  beam-background data. On first use 'PoolSize' background events are
+     *  read by executing the children on private events, which are numbered
+     *  from 1 like the events of the kernel. The pool is read-only afterwards
+     *  and shared by all events processed in parallel without any locking.
+     *
+     *  For every signal event the number of overlaid events is drawn from a
+     *  Poisson distribution with mean 'Mean'. Each overlaid event is
+     *  assigned a random bunch crossing in [FirstCrossing, LastCrossing]
+     *  and the times of its deposits are shifted by crossing*BunchSpacing.
+     *  The random numbers are taken from the stream of the action in the
+     *  event context: the result does not depend on the thread scheduling.
+     *
+     *  The columnar energy deposits of the background are merged by
+     *  container name. Signal containers receiving background deposits are
+     *  extended in place under their own key, all other signal containers
+     *  are left untouched. Background containers without signal counterpart
+     *  are added with the key of the container name and 'Mask'.
+     *
+     *  Properties:
+     *  - PoolSize:       number of pre-loaded background events (default: 100)
+     *  - Mean:           mean number of overlaid events per signal event (default: 1)
+     *  - BunchSpacing:   time between bunch crossings (default: 25 ns)
+     *  - FirstCrossing:  first bunch crossing relative to the signal (default: 0)
+     *  - LastCrossing:   last bunch crossing relative to the signal (default: 0)
+     *  - Mask:           mask of the keys of containers missing in the signal (default: 0)
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiPileupOverlay : public DigiSynchronize {
+    protected:
+      /// Property: Number of background events to be pre-loaded
+      int                      m_poolSize      = 100;
+      /// Property: Mean number of overlaid events per signal event
+      double                   m_mean          = 1.0;
+      /// Property: Time between two bunch crossings
+      double                   m_bunchSpacing;
+      /// Property: First bunch crossing relative to the signal crossing
+      int                      m_firstCrossing = 0;
+      /// Property: Last bunch crossing relative to the signal crossing
+      int                      m_lastCrossing  = 0;
+      /// Property: Mask of the keys of containers missing in the signal event
+      int                      m_mask          = 0;
+
+      /// Flag to load the background pool exactly once
+      mutable std::once_flag   m_loaded;
+      /// Read-only pool of background events
+      mutable std::vector<std::unique_ptr<DigiEvent> > m_pool;
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiPileupOverlay);
+      /// Load the background pool by executing the child actions
+      void loadPool()  const;
+
+    public:
+      /// Standard constructor
+      DigiPileupOverlay(const DigiKernel& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiPileupOverlay();
+      /// Access the background pool
+      const std::vector<std::unique_ptr<DigiEvent> >& pool()  const  {
+        return m_pool;
+      }
+      /// Overlay the background to the signal event
+      virtual void execute(DigiContext& context)  const override;
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DD4HEP_DDDIGI_DIGIPILEUPOVERLAY_H
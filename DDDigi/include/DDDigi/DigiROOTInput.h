@@ -0,0 +1,89 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDDIGI_DIGIROOTINPUT_H
+#define DD4HEP_DDDIGI_DIGIROOTINPUT_H
+
+/// Framework include files
+#include "DDDigi/DigiInputAction.h"
+
+/// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    // Forward declarations
+    class DigiROOTInput;
+
+    /// Input action reading the hit collections written by DDG4 to ROOT files
+    /**
+     *  The hit collections of the DDG4 Geant4Output2ROOT event tree are
+     *  converted into columnar energy deposits (DigiDepositColumns) of the
+     *  DigiEvent. The hit classes are accessed by the ROOT reflection:
+     *  there is no link dependency to DDG4, only the dictionaries
+     *  of the hit classes must be loadable.
+     *
+     *  Entries are read and decompressed by a background thread ahead of
+     *  the requests of the event processing. Up to 'Prefetch' converted
+     *  events are kept in a queue, so that several events processed in
+     *  parallel do not have to wait for the I/O.
+     *  The kernel numbers the events from 1: event number N always receives
+     *  the input entry N-1, independent of the order in which parallel
+     *  events request their data.
+     *
+     *  Properties:
+     *  - Input:       list of input files
+     *  - Tree:        name of the event tree (default: EVENT)
+     *  - Containers:  names of the branches to be read (default: all hit collections)
+     *  - Prefetch:    maximal number of events read ahead (default: 8)
+     *  - Mask:        mask of the event data keys of the deposits (default: 0)
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiROOTInput : public DigiInputAction {
+    public:
+      class internals_t;
+
+    protected:
+      /// Property: Name of the tree to be read
+      std::string               m_tree_name;
+      /// Property: Branch names to be read (empty: all hit collections)
+      std::vector<std::string>  m_containers;
+      /// Property: Maximal number of events read ahead
+      int                       m_prefetch  = 8;
+      /// Property: Mask of the event data keys
+      int                       m_mask      = 0;
+      /// Reader state and prefetch queue
+      std::unique_ptr<internals_t> internals;
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiROOTInput);
+
+    public:
+      /// Standard constructor
+      DigiROOTInput(const DigiKernel& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiROOTInput();
+      /// Callback to read event input
+      virtual void execute(DigiContext& context)  const override;
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DD4HEP_DDDIGI_DIGIROOTINPUT_H
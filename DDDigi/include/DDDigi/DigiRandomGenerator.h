@@ -0,0 +1,101 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDDIGI_DIGIRANDOMGENERATOR_H
+#define DD4HEP_DDDIGI_DIGIRANDOMGENERATOR_H
+
+/// C/C++ include files
+#include <cstdint>
+#include <cstddef>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Counter based random number stream for reproducible parallel processing
+    /**
+     *  Philox4x32-10 generator: every block of 4 random words is a pure
+     *  function of the key and the counter. The key is derived from the
+     *  stream identifier (the hashed action name) and the run seed, the
+     *  counter from the event number and the block number within the stream.
+     *  The random numbers of an action in a given event are therefore
+     *  identical independent of the number of threads and of the order
+     *  in which events and actions are scheduled.
+     *
+     *  Instances are cheap value objects. They satisfy the requirements
+     *  of a UniformRandomBitGenerator and may be used with the distributions
+     *  of the standard library. Clients needing large numbers of random
+     *  values should use the bulk functions, which evaluate many blocks
+     *  in vectorizable loops.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiRandomGenerator  {
+    public:
+      typedef std::uint32_t result_type;
+
+    protected:
+      /// Generator key: stream identifier and low word of the run seed
+      std::uint32_t  m_key[2];
+      /// Event number and high word of the run seed
+      std::uint32_t  m_event, m_seed;
+      /// Number of the next block to be generated
+      std::uint64_t  m_block  { 0 };
+      /// Buffered words of the current block
+      std::uint32_t  m_buffer[4];
+      /// Number of consumed words of the current block
+      unsigned int   m_used   { 4 };
+
+      /// Generate the words of 'num_blocks' consecutive blocks
+      void generate(std::uint32_t* words, std::size_t num_blocks);
+
+    public:
+      /// Initializing constructor
+      DigiRandomGenerator(std::uint64_t seed, std::uint32_t event, std::uint32_t stream);
+      /// Default copy constructor
+      DigiRandomGenerator(const DigiRandomGenerator& copy) = default;
+      /// Default assignment
+      DigiRandomGenerator& operator=(const DigiRandomGenerator& copy) = default;
+
+      /// Philox4x32-10 block function
+      static void philox(const std::uint32_t key[2], const std::uint32_t counter[4], std::uint32_t result[4]);
+
+      /// Smallest value returned by operator()
+      static constexpr result_type min()  {  return 0;           }
+      /// Largest value returned by operator()
+      static constexpr result_type max()  {  return 0xFFFFFFFFu; }
+      /// Next 32 bit random word
+      result_type operator()()   {
+        if ( m_used == 4 )   {
+          this->generate(m_buffer, 1);
+          m_used = 0;
+        }
+        return m_buffer[m_used++];
+      }
+      /// Uniformly distributed random number in the open interval (0,1)
+      double uniform();
+      /// Gaussian distributed random number
+      double gaussian(double mean = 0e0, double sigma = 1e0);
+
+      /// Bulk generation: n uniformly distributed random numbers in (0,1)
+      void uniform(double* result, std::size_t n);
+      /// Bulk generation: n gaussian distributed random numbers
+      void gaussian(double* result, std::size_t n, double mean = 0e0, double sigma = 1e0);
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DD4HEP_DDDIGI_DIGIRANDOMGENERATOR_H
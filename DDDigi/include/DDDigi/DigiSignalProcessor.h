@@ -50,6 +50,11 @@ namespace dd4hep {
       virtual ~DigiSignalProcessor();
       /// Callback to read event signalprocessor
       virtual double operator()(const DigiCellData& data)  const = 0;
+      /// Process the signals of whole columns of cells: result[i] = signal of cell i
+      /** The default implementation calls the single cell callback for every cell.
+       *  Processors should overload it with plain loops over the columns.
+       */
+      virtual void process(const DigiCellColumns& cells, double* result)  const;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
@@ -58,6 +58,8 @@ namespace dd4hep {
       void adopt(DigiSignalProcessor* action);
       /// Begin-of-event callback
       virtual double operator()(const DigiCellData& data)  const override;
+      /// Process the signals of whole columns of cells
+      virtual void process(const DigiCellColumns& cells, double* result)  const override;
     };
 
   }    // End namespace digi
@@ -0,0 +1,100 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDDIGI_DIGISLOTREGISTRY_H
+#define DD4HEP_DDDIGI_DIGISLOTREGISTRY_H
+
+/// Framework include files
+#include "DDDigi/DigiData.h"
+
+/// C/C++ include files
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    // Forward declarations
+    class DigiAction;
+
+    /// Registry of the event data slots declared by the actions
+    /**
+     *  Actions declare the data they read and write at initialization time
+     *  (see DigiAction::declareInput and DigiAction::declareOutput). Every
+     *  distinct (name, mask) pair is assigned a stable slot index. The events
+     *  hold one entry per slot, so that the data access during the event
+     *  processing is an array index without lookup and without type check.
+     *  Declaring the same slot with different data types is an error.
+     *
+     *  The registry also records which actions produce and consume each
+     *  slot. This information describes the data flow between the actions.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiSlotRegistry   {
+    public:
+      /// Description of one data slot
+      struct Entry  {
+        /// Name of the data item
+        std::string                     name;
+        /// Event data key of the item
+        Key                             key;
+        /// Data type of the slot
+        const std::type_info*           type  { nullptr };
+        /// Actions writing the slot
+        std::vector<const DigiAction*>  producers;
+        /// Actions reading the slot
+        std::vector<const DigiAction*>  consumers;
+      };
+
+    protected:
+      /// Lock to protect the declarations
+      mutable std::mutex                 m_lock;
+      /// Slot descriptions by index
+      std::vector<Entry>                 m_slots;
+      /// Slot index by event data key
+      std::map<Key::key_type, std::size_t> m_index;
+
+    public:
+      /// Default constructor
+      DigiSlotRegistry() = default;
+      /// Inhibit copy constructor
+      DigiSlotRegistry(const DigiSlotRegistry& copy) = delete;
+      /// Inhibit assignment
+      DigiSlotRegistry& operator=(const DigiSlotRegistry& copy) = delete;
+      /// Default destructor
+      ~DigiSlotRegistry() = default;
+
+      /// Declare a slot read or written by an action. Returns the slot index
+      std::size_t declare(const DigiAction* action, const std::string& name, int mask,
+                          const std::type_info& type, bool output);
+      /// Number of declared slots
+      std::size_t size()  const;
+      /// Find a slot by name and mask. Returns size_t(-1) if not declared
+      std::size_t find(const std::string& name, int mask)  const;
+      /// Copy of the slot descriptions. To be used after initialization
+      std::vector<Entry> entries()  const;
+      /// Print the slot declarations
+      void print()  const;
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DD4HEP_DDDIGI_DIGISLOTREGISTRY_H
@@ -21,6 +21,7 @@
 
 /// C/C++ include files
 #include <functional>
+#include <vector>
 #include <map>
 
 class TClass;
@@ -49,6 +50,14 @@ namespace dd4hep {
      */
     class DigiSubdetectorSequence : public DigiActionSequence {
     protected:
+      /// Precompiled sensitive placement of a parallelization context
+      class Cell  {
+      public:
+        PlacedVolume     placement;
+        VolumeID         volume_id;
+        VolumeID         volume_mask;
+        DigiCellScanner* scanner;
+      };
       class Context  {
       public:
         DetElement detector;
@@ -56,6 +65,8 @@ namespace dd4hep {
         VolumeID   reverse_id;
         VolumeID   detector_mask;
         std::shared_ptr<DigiCellScanner> scanner;
+        /// Range of the context's sensitive placements in the cell plan
+        std::size_t first_cell = 0, num_cells = 0;
         Context(DetElement de, VolumeID vid, VolumeID rid, VolumeID mask)
           : detector(de), detector_id(vid), reverse_id(rid), detector_mask(mask) {}
         Context() = delete;
@@ -75,6 +86,8 @@ namespace dd4hep {
       std::map<DetElement, VolumeID> m_parallelDet;
       std::map<VolumeID, Context>    m_parallelVid;
       Scanners                       m_scanners;
+      /// Sensitive placements of all parallelization contexts computed at initialization
+      std::vector<Cell>              m_cells;
 
       std::function<void(const DigiCellScanner&, const CellDataBase&)> m_cellHandler;
 
@@ -93,7 +106,7 @@ namespace dd4hep {
       void process_cell(const DigiCellScanner& , const CellDataBase& data)  const;
       void scan_detector(DetElement de, VolumeID vid, VolumeID mask);
       void scan_sensitive(PlacedVolume pv, VolumeID vid, VolumeID mask);
-      void process_context(const Context& c, PlacedVolume pv, VolumeID vid, VolumeID mask)   const;
+      void process_context(const Context& c)   const;
       
     public:
       /// Standard constructor
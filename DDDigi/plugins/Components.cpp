@@ -24,9 +24,18 @@
 #include "DDDigi/DigiInputAction.h"
 DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiInputAction)
 
+#include "DDDigi/DigiROOTInput.h"
+DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiROOTInput)
+
 #include "DDDigi/DigiSynchronize.h"
 DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiSynchronize)
 
+#include "DDDigi/DigiDataFlowScheduler.h"
+DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiDataFlowScheduler)
+
+#include "DDDigi/DigiPileupOverlay.h"
+DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiPileupOverlay)
+
 #include "DDDigi/DigiActionSequence.h"
 DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiActionSequence)
 
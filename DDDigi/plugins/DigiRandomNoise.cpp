@@ -31,6 +31,11 @@ namespace dd4hep {
      *  Class which applies random noise hits of a given amplitude
      *  to a segmented sensitive element.
      *
+     *  The gaussian noise of width 'Amplitude' is added with the
+     *  probability 'Probability' to every columnar energy deposit
+     *  of the event. The random numbers are taken from the
+     *  reproducible stream of the action in the event context.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_DIGITIZATION
@@ -78,9 +83,11 @@ namespace dd4hep {
 #include "DD4hep/Printout.h"
 #include "DD4hep/InstanceCount.h"
 #include "DDDigi/DigiFactories.h"
+#include "DDDigi/DigiContext.h"
 //#include "DDDigi/DigiRandomNoise.h"
 
 // C/C++ include files
+#include <vector>
 
 using namespace std;
 using namespace dd4hep::digi;
@@ -102,6 +109,28 @@ DigiRandomNoise::~DigiRandomNoise() {
 }
 
 /// Pre-track action callback
-void DigiRandomNoise::execute(DigiContext& /* context */)  const   {
-  info("+++ Virtual method execute() MUST be overloaded!");
+void DigiRandomNoise::execute(DigiContext& context)  const   {
+  DigiEvent& event = context.event();
+  DigiRandomGenerator random = context.randomGenerator(*this);
+  vector<double> noise, select;
+  size_t num_noise = 0;
+  for( auto& c : event.depositColumns )   {
+    DigiDepositColumns& deposits = *c.second;
+    size_t num_cells = deposits.size();
+    double* energy = deposits.deposits();
+    noise.resize(num_cells);
+    select.resize(num_cells);
+    random.gaussian(noise.data(), num_cells, 0e0, m_amplitude);
+    random.uniform(select.data(), num_cells);
+    double sum = 0e0;
+    for( size_t i = 0; i < num_cells; ++i )   {
+      energy[i] += select[i] < m_probability ? noise[i] : 0e0;
+      sum += energy[i];
+    }
+    debug("+++ Event: %8d (DigiRandomNoise) Collection %s: %ld deposits, energy sum: %.9e",
+          event.eventNumber, deposits.containerName().c_str(), long(num_cells), sum);
+    num_noise += num_cells;
+  }
+  debug("+++ Event: %8d (DigiRandomNoise) Added noise to %ld deposits.",
+        event.eventNumber, num_noise);
 }
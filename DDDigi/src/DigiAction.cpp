@@ -15,6 +15,8 @@
 #include "DD4hep/Printout.h"
 #include "DD4hep/InstanceCount.h"
 #include "DDDigi/DigiAction.h"
+#include "DDDigi/DigiKernel.h"
+#include "DDDigi/DigiSlotRegistry.h"
 
 // C/C++ include files
 #include <algorithm>
@@ -203,3 +205,10 @@ void DigiAction::except(const char* fmt, ...) const {
 void DigiAction::initialize()   {
 }
 
+/// Declare an event data slot in the slot registry of the kernel
+size_t DigiAction::declareSlot(const string& nam, int mask, const type_info& type, bool output)   {
+  size_t idx = m_kernel.slotRegistry().declare(this, nam, mask, type, output);
+  debug("+++ Declared %s slot %ld: %s [mask:%d]", output ? "output" : "input", idx, nam.c_str(), mask);
+  return idx;
+}
+
@@ -16,6 +16,8 @@
 #include "DD4hep/InstanceCount.h"
 #include "DDDigi/DigiContext.h"
 #include "DDDigi/DigiKernel.h"
+#include "DDDigi/DigiAction.h"
+#include "DDDigi/DigiSlotRegistry.h"
 
 // C/C++ include files
 #include <algorithm>
@@ -31,6 +33,7 @@ DigiContext::DigiContext(const DigiKernel* k, DigiEvent* e)
   if ( !m_kernel )    {
     except("DigiContext","Cannot initialize Digitization context with invalid DigiKernel!");
   }
+  setEvent(e);
   InstanceCount::increment(this);
 }
 
@@ -43,6 +46,11 @@ DigiContext::~DigiContext() {
 /// Set the geant4 event reference
 void DigiContext::setEvent(DigiEvent* new_event)   {
   m_event = new_event;
+  // All slots must exist before processing: actions fill them concurrently
+  if ( m_event )   {
+    size_t num_slots = m_kernel->slotRegistry().size();
+    if ( m_event->slots.size() < num_slots ) m_event->slots.resize(num_slots);
+  }
 }
 
 /// Access the geant4 event -- valid only between BeginEvent() and EndEvent()!
@@ -77,3 +85,12 @@ DigiActionSequence& DigiContext::outputAction() const    {
   return m_kernel->outputAction();
 }
 
+/// Random number stream of an action for the current event
+DigiRandomGenerator DigiContext::randomGenerator(const DigiAction& action)  const   {
+  return randomGenerator(action.name());
+}
+
+/// Random number stream with a given name for the current event
+DigiRandomGenerator DigiContext::randomGenerator(const std::string& stream_name)  const   {
+  return DigiRandomGenerator(m_kernel->randomSeed(), event().eventNumber, detail::hash32(stream_name));
+}
@@ -20,6 +20,10 @@
 
 // C/C++ include files
 #include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
 
 using namespace std;
 using namespace dd4hep;
@@ -79,3 +83,91 @@ DigiEvent::~DigiEvent()
 {
   InstanceCount::decrement(this);
 }
+
+constexpr std::size_t DigiArena::BLOCK_SIZE;
+constexpr std::size_t DigiArena::ALIGNMENT;
+
+/// Default destructor
+DigiArena::~DigiArena()   {
+  reset();
+}
+
+/// Allocate a new block able to serve at least len bytes
+void* DigiArena::newBlock(std::size_t len, std::size_t align)   {
+  std::size_t    blk_len = std::max(BLOCK_SIZE, len + align);
+  unsigned char* blk     = (unsigned char*)::malloc(blk_len);
+  if ( !blk )   {
+    except("DigiArena","+++ Failed to allocate memory block of %ld bytes.", blk_len);
+  }
+  m_blocks.emplace_back(blk, blk_len);
+  std::size_t pad = (align - (reinterpret_cast<std::uintptr_t>(blk) & (align-1))) & (align-1);
+  unsigned char* ptr = blk + pad;
+  // Large allocations do not replace the current block if it has more space left
+  if ( blk_len - pad - len > m_free )   {
+    m_current = ptr + len;
+    m_free    = blk_len - pad - len;
+  }
+  return ptr;
+}
+
+/// Release all memory of the arena
+void DigiArena::reset()   {
+  for( auto& b : m_blocks ) ::free(b.first);
+  m_blocks.clear();
+  m_current = nullptr;
+  m_free    = 0;
+}
+
+/// Total number of bytes reserved by the arena
+std::size_t DigiArena::capacity()  const   {
+  std::size_t len = 0;
+  for( const auto& b : m_blocks ) len += b.second;
+  return len;
+}
+
+/// Initializing constructor
+DigiDepositColumns::DigiDepositColumns(DigiArena& arena, const std::string& nam)
+  : name(nam), m_arena(&arena)
+{
+}
+
+/// Reserve space for at least n deposits
+void DigiDepositColumns::reserve(std::size_t n)   {
+  if ( n <= m_capacity )   {
+    return;
+  }
+  auto grow = [this, n](auto*& column)   {
+    typedef typename std::remove_reference<decltype(*column)>::type value_t;
+    value_t* ptr = m_arena->allocate_array<value_t>(n);
+    if ( m_size > 0 ) ::memcpy(ptr, column, m_size*sizeof(value_t));
+    column = ptr;
+  };
+  grow(m_cellID);
+  grow(m_flag);
+  grow(m_deposit);
+  grow(m_time);
+  grow(m_x);
+  grow(m_y);
+  grow(m_z);
+  m_capacity = n;
+}
+
+/// Migration: add a deposit from the polymorphic representation
+void DigiDepositColumns::add(const EnergyDeposit& deposit)   {
+  if ( const auto* calo = dynamic_cast<const CaloDeposit*>(&deposit) )
+    push_back(calo->cellID(), calo->deposit(), calo->time(), calo->position(), calo->flag());
+  else if ( const auto* trk = dynamic_cast<const TrackerDeposit*>(&deposit) )
+    push_back(trk->cellID(), trk->deposit(), trk->time(), trk->position(), trk->flag());
+  else
+    push_back(deposit.cellID(), 0e0, deposit.time(), Position(), deposit.flag());
+}
+
+/// Migration: add all deposits of a container of polymorphic deposits
+std::size_t DigiDepositColumns::add(const DigiEnergyDeposits& deposits)   {
+  std::size_t len = m_size;
+  reserve(m_size + deposits.size());
+  for( const auto* d : deposits )   {
+    if ( d ) add(*d);
+  }
+  return m_size - len;
+}
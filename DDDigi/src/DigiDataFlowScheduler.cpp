@@ -0,0 +1,187 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDDigi/DigiDataFlowScheduler.h"
+#include "DDDigi/DigiSlotRegistry.h"
+#include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiKernel.h"
+
+#ifdef DD4HEP_USE_TBB
+#include "tbb/tbb.h"
+#endif
+
+// C/C++ include files
+#include <set>
+#include <map>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+namespace {
+  /// Collect the child action and all nested actions of sequences
+  void collect_actions(const DigiEventAction* action, set<const DigiAction*>& actions)  {
+    actions.insert(action);
+    if ( const auto* sync = dynamic_cast<const DigiSynchronize*>(action) )  {
+      for( const auto* a : sync->children() )
+        collect_actions(a, actions);
+    }
+  }
+}
+
+/// Standard constructor
+DigiDataFlowScheduler::DigiDataFlowScheduler(const DigiKernel& kernel, const string& nam)
+  : DigiSynchronize(kernel, nam)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiDataFlowScheduler::~DigiDataFlowScheduler() {
+  printStatistics();
+  m_nodes.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Build the dependency graph from the declared slots
+void DigiDataFlowScheduler::buildGraph()  const   {
+  vector<DigiSlotRegistry::Entry> slots = m_kernel.slotRegistry().entries();
+  map<const DigiAction*, size_t>  owner;
+  vector<set<size_t> > edges(m_actors.size());
+
+  m_nodes.clear();
+  for( size_t i = 0; i < m_actors.size(); ++i )   {
+    set<const DigiAction*> actions;
+    collect_actions(m_actors[i], actions);
+    for( const auto* a : actions ) owner.emplace(a, i);
+    m_nodes.emplace_back(new Node());
+    m_nodes.back()->action = m_actors[i];
+  }
+  for( const auto& s : slots )   {
+    for( const auto* p : s.producers )   {
+      auto ip = owner.find(p);
+      if ( ip == owner.end() ) continue;
+      for( const auto* c : s.consumers )   {
+        auto ic = owner.find(c);
+        if ( ic != owner.end() && ic->second != ip->second )
+          edges[ip->second].insert(ic->second);
+      }
+    }
+  }
+  for( size_t i = 0; i < edges.size(); ++i )   {
+    for( size_t j : edges[i] )   {
+      m_nodes[i]->successors.push_back(j);
+      ++m_nodes[j]->num_inputs;
+    }
+  }
+  // Topological order (Kahn). Actions without dependencies keep the adoption order
+  vector<int> pending;
+  for( const auto& n : m_nodes ) pending.push_back(n->num_inputs);
+  m_order.clear();
+  for( size_t i = 0; i < m_nodes.size(); ++i )
+    if ( 0 == pending[i] ) m_order.push_back(i);
+  for( size_t k = 0; k < m_order.size(); ++k )   {
+    for( size_t j : m_nodes[m_order[k]]->successors )
+      if ( 0 == --pending[j] ) m_order.push_back(j);
+  }
+  if ( m_order.size() != m_nodes.size() )   {
+    for( size_t i = 0; i < m_nodes.size(); ++i )   {
+      if ( pending[i] > 0 ) error("+++ Action %s is part of a dependency cycle.", m_nodes[i]->action->c_name());
+    }
+    except("+++ The data dependencies of the %ld actions are cyclic.", m_nodes.size());
+  }
+  for( size_t i : m_order )   {
+    const Node& n = *m_nodes[i];
+    info("+++ Schedule action %-32s inputs from %ld action(s), output to %ld action(s).",
+         n.action->c_name(), size_t(n.num_inputs), n.successors.size());
+  }
+}
+
+/// Execute a single node and record the statistics
+void DigiDataFlowScheduler::executeNode(Node& node, DigiContext& context)  const   {
+  int running = ++m_running;
+  int max_running = m_maxRunning;
+  while( running > max_running && !m_maxRunning.compare_exchange_weak(max_running, running) ) {}
+  auto start = chrono::high_resolution_clock::now();
+  try  {
+    node.action->execute(context);
+  }
+  catch(...)  {
+    --m_running;
+    throw;
+  }
+  auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - start);
+  --m_running;
+  ++node.calls;
+  node.nanoseconds += ns.count();
+}
+
+/// Execute the children according to the data flow
+void DigiDataFlowScheduler::execute(DigiContext& context)  const   {
+  call_once(m_built, [this] { this->buildGraph(); });
+  auto start = chrono::high_resolution_clock::now();
+  bool parallel = m_parallel && m_kernel.numThreads() > 0;
+#ifdef DD4HEP_USE_TBB
+  if ( parallel )   {
+    size_t num_nodes = m_nodes.size();
+    unique_ptr<atomic<int>[]> pending(new atomic<int>[num_nodes]);
+    for( size_t i = 0; i < num_nodes; ++i ) pending[i] = m_nodes[i]->num_inputs;
+    tbb::task_group group;
+    function<void(size_t)> submit = [&](size_t i)  {
+      group.run([&, i]  {
+          Node& node = *m_nodes[i];
+          this->executeNode(node, context);
+          for( size_t j : node.successors )
+            if ( 0 == --pending[j] ) submit(j);
+        });
+    };
+    for( size_t i = 0; i < num_nodes; ++i )
+      if ( 0 == m_nodes[i]->num_inputs ) submit(i);
+    group.wait();
+  }
+  else
+#endif
+  {
+    parallel = false;
+    for( size_t i : m_order )
+      executeNode(*m_nodes[i], context);
+  }
+  auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::high_resolution_clock::now() - start);
+  ++m_events;
+  m_nanoseconds += ns.count();
+  debug("+++ Event: %8d (DigiDataFlowScheduler) Parallel: %-4s  %3ld actions [%8.3g sec]",
+        context.event().eventNumber, yes_no(parallel), m_nodes.size(), 1e-9*double(ns.count()));
+}
+
+/// Print the timing and occupancy report
+void DigiDataFlowScheduler::printStatistics()  const   {
+  long num_events = m_events;
+  if ( 0 == num_events ) return;
+  double total = 0e0, wall = 1e-9*double(m_nanoseconds.load());
+  for( const auto& n : m_nodes ) total += 1e-9*double(n->nanoseconds.load());
+  info("+++ Scheduled %ld events: %8.3f sec wall time, %8.3f sec in actions.",
+       num_events, wall, total);
+  for( size_t i : m_order )   {
+    const Node& n = *m_nodes[i];
+    double secs = 1e-9*double(n.nanoseconds.load());
+    info("+++ %-32s %7ld calls %10.3f msec/call %5.1f %% of the action time",
+         n.action->c_name(), n.calls.load(), n.calls ? 1e3*secs/double(n.calls) : 0e0,
+         total > 0e0 ? 100e0*secs/total : 0e0);
+  }
+  info("+++ Occupancy: average %.2f actions running, maximum %d actions running.",
+       wall > 0e0 ? total/wall : 0e0, m_maxRunning.load());
+}
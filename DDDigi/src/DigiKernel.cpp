@@ -22,6 +22,7 @@
 #include "DDDigi/DigiKernel.h"
 #include "DDDigi/DigiContext.h"
 #include "DDDigi/DigiActionSequence.h"
+#include "DDDigi/DigiSlotRegistry.h"
 
 #ifdef DD4HEP_USE_TBB
 #include "tbb/tbb.h"
@@ -38,6 +39,15 @@ using namespace dd4hep;
 using namespace dd4hep::digi;
 namespace  {
   static std::mutex kernel_mutex;
+
+  /// Initialize an action and all actions of sub-sequences
+  void initialize_action(DigiEventAction* action)   {
+    action->initialize();
+    if ( DigiSynchronize* sync = dynamic_cast<DigiSynchronize*>(action) )   {
+      for( auto* a : sync->children() )
+        initialize_action(a);
+    }
+  }
 }
 
 /// DigiKernel herlp class: Container of instance variabled
@@ -56,6 +66,8 @@ public:
   /// Atomic counter: Number of events still to be processed in this run
   std::atomic_int       eventsToDo;
 
+  /// Registry of the event data slots
+  DigiSlotRegistry      slots;
   /// The main data input action sequence
   DigiActionSequence*   inputAction = 0;
   /// The main event action sequence
@@ -72,8 +84,12 @@ public:
   int                   maxEventsParallel;
   /// Property: maximum number of threads to be used (if TBB)
   int                   numThreads;
+  /// Property: Seed of the random number streams of the run
+  long                  randomSeed = 0;
   /// Property: Allow to stop execution from interactive prompt
   bool                  stop = false;
+  /// Flag if the actions were initialized
+  bool                  initialized = false;
   Internals() = default;
   ~Internals() = default;
 };
@@ -148,6 +164,7 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->numThreads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("randomSeed",       internals->randomSeed);
   declareProperty("OutputLevel",      internals->outputLevel = DEBUG);
   declareProperty("OutputLevels",     internals->clientLevels);
   internals->inputAction  = new DigiActionSequence(*this, "InputAction");
@@ -212,6 +229,16 @@ PrintLevel DigiKernel::outputLevel() const  {
   return (PrintLevel)internals->outputLevel;
 }
 
+/// Access the number of worker threads (<= 0: serial processing)
+int DigiKernel::numThreads() const  {
+  return internals->tbbInit ? internals->numThreads : -1;
+}
+
+/// Access the seed of the random number streams of the run
+unsigned long DigiKernel::randomSeed() const  {
+  return (unsigned long)internals->randomSeed;
+}
+
 /// Fill cache with the global output level of a named object. Must be set before instantiation
 void DigiKernel::setOutputLevel(const std::string object, PrintLevel new_level)   {
   internals->clientLevels[object] = new_level;
@@ -248,7 +275,20 @@ int DigiKernel::configure()   {
 }
 
 int DigiKernel::initialize()   {
-  return 1;//DigiExec::initialize(*this);
+  if ( !internals->initialized )   {
+    internals->initialized = true;
+    initialize_action(internals->inputAction);
+    initialize_action(internals->eventAction);
+    initialize_action(internals->outputAction);
+    printout(INFO,"DigiKernel","+++ Initialized all actions: %ld event data slots declared.",
+             internals->slots.size());
+  }
+  return 1;
+}
+
+/// Access to the registry of the event data slots
+DigiSlotRegistry& DigiKernel::slotRegistry() const    {
+  return internals->slots;
 }
 
 /// Access to the main input action sequence from the kernel object
@@ -330,6 +370,8 @@ void DigiKernel::notify(DigiContext* context, const std::exception& e)   {
 
 int DigiKernel::run()   {
   chrono::system_clock::time_point start = chrono::system_clock::now();
+  // The event data slots must be declared before the first event is created
+  initialize();
   internals->stop = false;
   internals->eventsToDo = internals->numEvents;
   printout(INFO,
@@ -0,0 +1,152 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/DD4hepUnits.h"
+#include "DD4hep/InstanceCount.h"
+#include "DDDigi/DigiPileupOverlay.h"
+#include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiData.h"
+
+// C/C++ include files
+#include <map>
+#include <string>
+#include <chrono>
+#include <random>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+/// Standard constructor
+DigiPileupOverlay::DigiPileupOverlay(const DigiKernel& kernel, const string& nam)
+  : DigiSynchronize(kernel, nam)
+{
+  declareProperty("PoolSize",      m_poolSize);
+  declareProperty("Mean",          m_mean);
+  declareProperty("BunchSpacing",  m_bunchSpacing = 25e0*dd4hep::ns);
+  declareProperty("FirstCrossing", m_firstCrossing);
+  declareProperty("LastCrossing",  m_lastCrossing);
+  declareProperty("Mask",          m_mask);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiPileupOverlay::~DigiPileupOverlay() {
+  m_pool.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Load the background pool by executing the child actions
+void DigiPileupOverlay::loadPool()  const   {
+  auto start = chrono::high_resolution_clock::now();
+  size_t num_deposits = 0;
+  if ( 0 == m_actors.size() )   {
+    except("+++ No background source actions present. Cannot fill the pile-up pool.");
+  }
+  m_pool.reserve(m_poolSize);
+  for( int i = 0; i < m_poolSize; ++i )   {
+    // Numbered from 1 like the events of the kernel
+    unique_ptr<DigiEvent> background(new DigiEvent(i+1));
+    DigiContext context(&m_kernel, background.get());
+    this->DigiSynchronize::execute(context);
+    for( const auto& c : background->depositColumns )
+      num_deposits += c.second->size();
+    m_pool.emplace_back(move(background));
+  }
+  chrono::duration<double> secs = chrono::high_resolution_clock::now() - start;
+  info("+++ Loaded %ld background events with %ld deposits into the pile-up pool [%8.3g sec]",
+       m_pool.size(), num_deposits, secs.count());
+}
+
+/// Overlay the background to the signal event
+void DigiPileupOverlay::execute(DigiContext& context)  const   {
+  typedef pair<const DigiEvent*, double> Overlay;
+  struct Target  {
+    const DigiDepositColumns* prototype = 0;
+    size_t count = 0;
+  };
+  call_once(m_loaded, [this] { this->loadPool(); });
+
+  DigiEvent& event = context.event();
+  if ( m_pool.empty() || m_mean <= 0e0 )   {
+    return;
+  }
+  // Reproducible random stream independent of the processing thread
+  DigiRandomGenerator generator = context.randomGenerator(*this);
+  poisson_distribution<int>     num_overlay(m_mean);
+  uniform_int_distribution<size_t> pool_entry(0, m_pool.size()-1);
+  uniform_int_distribution<int> crossing(min(m_firstCrossing, m_lastCrossing),
+                                         max(m_firstCrossing, m_lastCrossing));
+  vector<Overlay> overlays(num_overlay(generator));
+  for( auto& o : overlays )   {
+    o.first  = m_pool[pool_entry(generator)].get();
+    o.second = crossing(generator) * m_bunchSpacing;
+    debug("+++ Event: %8d (DigiPileupOverlay) Overlay background event %d with time offset %g.",
+          event.eventNumber, o.first->eventNumber, o.second);
+  }
+
+  // Count the number of deposits added to every container
+  map<string, Target> targets;
+  for( const auto& o : overlays )   {
+    for( const auto& c : o.first->depositColumns )   {
+      Target& t = targets[c.second->containerName()];
+      t.prototype = c.second.get();
+      t.count += c.second->size();
+    }
+  }
+  // Signal containers are found by name: their keys may carry any mask
+  map<string, Key::key_type> signal_keys;
+  for( const auto& c : event.depositColumns )
+    signal_keys.emplace(c.second->containerName(), c.first);
+
+  // Extend the signal containers in place or create the missing containers
+  size_t num_deposits = 0;
+  for( const auto& t : targets )   {
+    if ( 0 == t.second.count ) continue;
+    auto is = signal_keys.find(t.first);
+    Key::key_type out_key = 0;
+    if ( is != signal_keys.end() )   {
+      out_key = is->second;
+    }
+    else   {
+      Key key;
+      key.set(t.first, m_mask);
+      out_key = key.toLong();
+    }
+    auto& out = event.depositColumns[out_key];
+    if ( !out )   {
+      out.reset(new DigiDepositColumns(event.arena, t.second.prototype->containerName()));
+    }
+    out->reserve(out->size() + t.second.count);
+    for( const auto& o : overlays )   {
+      for( const auto& c : o.first->depositColumns )   {
+        const DigiDepositColumns& in = *c.second;
+        if ( in.containerName() != t.first ) continue;
+        const CellID* cells = in.cellIDs();
+        const long*   flags = in.flags();
+        const double* deps  = in.deposits();
+        const double* times = in.times();
+        for( size_t i = 0, n = in.size(); i < n; ++i )   {
+          out->push_back(cells[i], deps[i], times[i] + o.second, in.position(i), flags[i]);
+        }
+        num_deposits += in.size();
+      }
+    }
+  }
+  for( const auto& c : event.depositColumns )   {
+    debug("+++ Event: %8d (DigiPileupOverlay) Collection %s: %ld deposits.",
+          event.eventNumber, c.second->containerName().c_str(), long(c.second->size()));
+  }
+  debug("+++ Event: %8d (DigiPileupOverlay) Overlaid %ld events with %ld deposits to %ld containers.",
+        event.eventNumber, overlays.size(), num_deposits, targets.size());
+}
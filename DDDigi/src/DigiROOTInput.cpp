@@ -0,0 +1,333 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDDigi/DigiROOTInput.h"
+#include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiData.h"
+
+// ROOT include files
+#include "TROOT.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TClass.h"
+#include "TDataMember.h"
+#include "TVirtualCollectionProxy.h"
+
+// C/C++ include files
+#include <mutex>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <stdexcept>
+#include <condition_variable>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+/// Helper class to hold the reader state and the prefetch queue
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiROOTInput::internals_t  {
+public:
+  /// Deposits of one hit collection in columnar form
+  struct Collection  {
+    Key                key;
+    std::string        name;
+    vector<CellID>     cellID;
+    vector<long>       flag;
+    vector<double>     deposit, time, x, y, z;
+  };
+  /// Converted data of one event
+  typedef vector<Collection> Event;
+
+  /// Reflection information of one hit collection branch
+  struct Container  {
+    TBranch*                 branch   = 0;
+    TClass*                  clazz    = 0;
+    TClass*                  hitClass = 0;
+    TVirtualCollectionProxy* proxy    = 0;
+    void*                    object   = 0;
+    Key                      key;
+    long                     cellID   = -1;
+    long                     flag     = -1;
+    long                     deposit  = -1;
+    long                     position = -1;
+    long                     time     = -1;
+  };
+
+  DigiROOTInput*            action;
+  vector<Container>         containers;
+  /// Converted events by input entry number
+  map<long, unique_ptr<Event> > queue;
+  mutex                     lock;
+  condition_variable        produced, consumed;
+  exception_ptr             error;
+  once_flag                 started;
+  thread                    reader;
+  TFile*                    file   = 0;
+  TTree*                    tree   = 0;
+  bool                      done   = false;
+  bool                      stop   = false;
+  long                      numRead = 0;
+  /// Largest entry number requested by the event processing
+  long                      wanted  = -1;
+
+public:
+  /// Initializing constructor
+  internals_t(DigiROOTInput* a) : action(a) {}
+  /// Default destructor
+  ~internals_t();
+  /// Start the reader thread on first request
+  void start();
+  /// Reader thread main loop
+  void run();
+  /// Open the next input file and connect the hit collection branches
+  bool open(const string& fname);
+  /// Close the current input file
+  void close();
+  /// Read and convert one entry of the current input tree
+  unique_ptr<Event> read(Long64_t entry);
+  /// Pop a given converted event from the queue. Blocks until data are available
+  unique_ptr<Event> get(long entry);
+};
+
+/// Default destructor
+DigiROOTInput::internals_t::~internals_t()   {
+  {
+    lock_guard<mutex> guard(lock);
+    stop = true;
+  }
+  consumed.notify_all();
+  if ( reader.joinable() ) reader.join();
+  close();
+}
+
+/// Start the reader thread on first request
+void DigiROOTInput::internals_t::start()   {
+  call_once(started, [this]  {
+      ROOT::EnableThreadSafety();
+      reader = thread([this] { this->run(); });
+    });
+}
+
+/// Close the current input file
+void DigiROOTInput::internals_t::close()   {
+  for( auto& c : containers )   {
+    if ( c.object ) c.clazz->Destructor(c.object);
+  }
+  containers.clear();
+  if ( file ) delete file;
+  file = 0;
+  tree = 0;
+}
+
+/// Open the next input file and connect the hit collection branches
+bool DigiROOTInput::internals_t::open(const string& fname)   {
+  const auto& names = action->m_containers;
+  close();
+  file = TFile::Open(fname.c_str());
+  if ( !file || file->IsZombie() )   {
+    action->except("+++ Failed to open input file: %s", fname.c_str());
+  }
+  tree = (TTree*)file->Get(action->m_tree_name.c_str());
+  if ( !tree )   {
+    action->except("+++ The input file %s has no tree %s",
+                   fname.c_str(), action->m_tree_name.c_str());
+  }
+  tree->SetBranchStatus("*", 0);
+  TObjArray* branches = tree->GetListOfBranches();
+  // The branch addresses point into the container array: no reallocation allowed
+  containers.reserve(branches->GetEntriesFast());
+  for( Int_t i = 0, n = branches->GetEntriesFast(); i < n; ++i )   {
+    Container c;
+    c.branch = (TBranch*)branches->UncheckedAt(i);
+    string nam = c.branch->GetName();
+    if ( !names.empty() && find(names.begin(), names.end(), nam) == names.end() )
+      continue;
+    c.clazz = TClass::GetClass(c.branch->GetClassName(), kTRUE);
+    c.proxy = c.clazz ? c.clazz->GetCollectionProxy() : 0;
+    c.hitClass = c.proxy ? c.proxy->GetValueClass() : 0;
+    if ( !c.hitClass || !c.proxy->HasPointers() )
+      continue;
+    c.cellID   = c.hitClass->GetDataMemberOffset("cellID");
+    c.flag     = c.hitClass->GetDataMemberOffset("flag");
+    c.deposit  = c.hitClass->GetDataMemberOffset("energyDeposit");
+    c.position = c.hitClass->GetDataMemberOffset("position");
+    // Only tracker hits have a single contribution with a time stamp
+    TDataMember* truth = c.hitClass->GetDataMember("truth");
+    TClass* truth_class = truth ? TClass::GetClass(truth->GetTypeName()) : 0;
+    if ( truth_class && !truth_class->GetCollectionProxy() )   {
+      Long_t off = truth_class->GetDataMemberOffset("time");
+      if ( off > 0 || truth_class->GetDataMember("time") )
+        c.time = c.hitClass->GetDataMemberOffset("truth") + off;
+    }
+    if ( c.cellID <= 0 || c.deposit <= 0 || c.position <= 0 )   {
+      action->debug("+++ Ignore branch %s of type %s: no hit collection.",
+                    nam.c_str(), c.branch->GetClassName());
+      continue;
+    }
+    c.key.set(nam, action->m_mask);
+    c.object = c.clazz->New();
+    containers.emplace_back(c);
+    tree->SetBranchStatus((nam+"*").c_str(), 1);
+    containers.back().branch->SetAddress(&containers.back().object);
+    containers.back().branch->SetAutoDelete(kFALSE);
+    action->info("+++ Reading hit collection %s [%s]", nam.c_str(), c.hitClass->GetName());
+  }
+  if ( containers.empty() )   {
+    action->warning("+++ The input file %s contains no hit collections.", fname.c_str());
+  }
+  tree->SetCacheSize(32*1024*1024);
+  return true;
+}
+
+/// Read and convert one entry of the current input tree
+unique_ptr<DigiROOTInput::internals_t::Event> DigiROOTInput::internals_t::read(Long64_t entry)   {
+  unique_ptr<Event> event(new Event());
+  event->reserve(containers.size());
+  if ( tree->GetEntry(entry) <= 0 )   {
+    action->except("+++ Failed to read entry %ld of tree %s", long(entry), tree->GetName());
+  }
+  for( auto& c : containers )   {
+    TVirtualCollectionProxy::TPushPop push(c.proxy, c.object);
+    size_t num_hits = c.proxy->Size();
+    event->emplace_back();
+    Collection& coll = event->back();
+    coll.key  = c.key;
+    coll.name = c.branch->GetName();
+    coll.cellID.resize(num_hits);
+    coll.flag.resize(num_hits);
+    coll.deposit.resize(num_hits);
+    coll.time.resize(num_hits);
+    coll.x.resize(num_hits);
+    coll.y.resize(num_hits);
+    coll.z.resize(num_hits);
+    for( size_t i = 0; i < num_hits; ++i )   {
+      const char* hit = *(const char**)c.proxy->At(i);
+      const double* pos = (const double*)(hit + c.position);
+      coll.cellID[i]  = *(const CellID*)(hit + c.cellID);
+      coll.flag[i]    = c.flag > 0 ? *(const long*)(hit + c.flag) : 0;
+      coll.deposit[i] = *(const double*)(hit + c.deposit);
+      coll.time[i]    = c.time > 0 ? *(const double*)(hit + c.time) : 0e0;
+      coll.x[i]       = pos[0];
+      coll.y[i]       = pos[1];
+      coll.z[i]       = pos[2];
+      c.hitClass->Destructor((void*)hit);
+    }
+    c.proxy->Clear();
+  }
+  return event;
+}
+
+/// Reader thread main loop
+void DigiROOTInput::internals_t::run()   {
+  try  {
+    for( const auto& fname : action->m_input )   {
+      open(fname);
+      for( Long64_t entry = 0, num = tree->GetEntries(); entry < num; ++entry )   {
+        unique_ptr<Event> event = read(entry);
+        unique_lock<mutex> guard(lock);
+        // Read beyond the prefetch limit only if an event waits for a later entry
+        consumed.wait(guard, [this] {
+            return stop || int(queue.size()) < action->m_prefetch || numRead <= wanted;
+          });
+        if ( stop ) return;
+        queue.emplace(numRead, move(event));
+        ++numRead;
+        guard.unlock();
+        produced.notify_all();
+      }
+      close();
+    }
+  }
+  catch(...)  {
+    lock_guard<mutex> guard(lock);
+    error = current_exception();
+  }
+  {
+    lock_guard<mutex> guard(lock);
+    done = true;
+  }
+  produced.notify_all();
+}
+
+/// Pop a given converted event from the queue. Blocks until data are available
+unique_ptr<DigiROOTInput::internals_t::Event> DigiROOTInput::internals_t::get(long entry)   {
+  start();
+  unique_lock<mutex> guard(lock);
+  if ( entry < 0 || (entry < numRead && queue.find(entry) == queue.end()) )   {
+    action->except("+++ Input entry %ld is invalid or was already delivered.", entry);
+  }
+  if ( entry > wanted )   {
+    wanted = entry;
+    consumed.notify_one();
+  }
+  produced.wait(guard, [this, entry] { return done || queue.find(entry) != queue.end(); });
+  auto i = queue.find(entry);
+  if ( i == queue.end() )   {
+    if ( error ) rethrow_exception(error);
+    action->except("+++ No input data for entry %ld: the input has only %ld events.", entry, numRead);
+  }
+  unique_ptr<Event> event = move(i->second);
+  queue.erase(i);
+  guard.unlock();
+  consumed.notify_one();
+  return event;
+}
+
+/// Standard constructor
+DigiROOTInput::DigiROOTInput(const DigiKernel& kernel, const string& nam)
+  : DigiInputAction(kernel, nam)
+{
+  declareProperty("Tree",       m_tree_name = "EVENT");
+  declareProperty("Containers", m_containers);
+  declareProperty("Prefetch",   m_prefetch);
+  declareProperty("Mask",       m_mask);
+  internals.reset(new internals_t(this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiROOTInput::~DigiROOTInput()   {
+  internals.reset();
+  InstanceCount::decrement(this);
+}
+
+/// Callback to read event input
+void DigiROOTInput::execute(DigiContext& context)  const   {
+  if ( m_input.empty() )   {
+    except("+++ No input files specified.");
+  }
+  DigiEvent& event = context.event();
+  // The entry depends only on the event number: reproducible for any number of parallel events.
+  // Event numbers start at 1, entries at 0.
+  auto data = internals->get(event.eventNumber - 1);
+  for( const auto& c : *data )   {
+    shared_ptr<DigiDepositColumns> deposits(new DigiDepositColumns(event.arena, c.name));
+    size_t num_hits = c.cellID.size();
+    deposits->reserve(num_hits);
+    for( size_t i = 0; i < num_hits; ++i )
+      deposits->push_back(c.cellID[i], c.deposit[i], c.time[i], Position(c.x[i], c.y[i], c.z[i]), c.flag[i]);
+    debug("+++ Event: %8d (DigiROOTInput) Collection %s: %ld deposits.",
+          event.eventNumber, c.name.c_str(), long(num_hits));
+    event.depositColumns[c.key.toLong()] = move(deposits);
+  }
+  debug("+++ Event: %8d (DigiROOTInput) Read %ld hit collections.",
+        event.eventNumber, data->size());
+}
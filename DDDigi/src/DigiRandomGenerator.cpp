@@ -0,0 +1,140 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDDigi/DigiRandomGenerator.h"
+
+// C/C++ include files
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+namespace {
+
+  /// Philox constants
+  constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+  constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+  constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+  constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+  /// Number of blocks evaluated per bulk iteration
+  constexpr size_t   CHUNK     = 128;
+  constexpr double   TWO_PI    = 6.283185307179586476925286766559;
+  constexpr double   TO_DOUBLE = 1.0/9007199254740992.0;  // 2**-53
+
+  /// Convert two random words to a double in the open interval (0,1)
+  inline double to_uniform(uint32_t hi, uint32_t lo)   {
+    uint64_t bits = ((uint64_t(hi) << 32) | lo) >> 11;
+    return (double(bits) + 0.5) * TO_DOUBLE;
+  }
+
+  /// Single Philox round
+  inline void philox_round(uint32_t& x0, uint32_t& x1, uint32_t& x2, uint32_t& x3,
+                           uint32_t k0, uint32_t k1)   {
+    uint64_t p0 = uint64_t(PHILOX_M0) * x0;
+    uint64_t p1 = uint64_t(PHILOX_M1) * x2;
+    uint32_t y0 = uint32_t(p1 >> 32) ^ x1 ^ k0;
+    uint32_t y1 = uint32_t(p1);
+    uint32_t y2 = uint32_t(p0 >> 32) ^ x3 ^ k1;
+    uint32_t y3 = uint32_t(p0);
+    x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+  }
+}
+
+/// Initializing constructor
+DigiRandomGenerator::DigiRandomGenerator(uint64_t seed, uint32_t event, uint32_t stream)
+  : m_event(event), m_seed(uint32_t(seed >> 32))
+{
+  m_key[0] = stream;
+  m_key[1] = uint32_t(seed);
+}
+
+/// Philox4x32-10 block function
+void DigiRandomGenerator::philox(const uint32_t key[2], const uint32_t counter[4], uint32_t result[4])   {
+  uint32_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  for( int r = 0; r < 10; ++r )   {
+    philox_round(x0, x1, x2, x3, k0, k1);
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  result[0] = x0; result[1] = x1; result[2] = x2; result[3] = x3;
+}
+
+/// Generate the words of 'num_blocks' consecutive blocks
+void DigiRandomGenerator::generate(uint32_t* words, size_t num_blocks)   {
+  // The blocks are independent: the inlined block function vectorizes
+  for( size_t i = 0; i < num_blocks; ++i )   {
+    uint64_t block = m_block + i;
+    const uint32_t counter[4] = { uint32_t(block), uint32_t(block >> 32), m_event, m_seed };
+    philox(m_key, counter, words + 4*i);
+  }
+  m_block += num_blocks;
+}
+
+/// Uniformly distributed random number in the open interval (0,1)
+double DigiRandomGenerator::uniform()   {
+  uint32_t hi = (*this)();
+  uint32_t lo = (*this)();
+  return to_uniform(hi, lo);
+}
+
+/// Gaussian distributed random number
+double DigiRandomGenerator::gaussian(double mean, double sigma)   {
+  double u1 = uniform();
+  double u2 = uniform();
+  return mean + sigma * std::sqrt(-2e0*std::log(u1)) * std::cos(TWO_PI*u2);
+}
+
+/// Bulk generation: n uniformly distributed random numbers in (0,1)
+void DigiRandomGenerator::uniform(double* result, size_t n)   {
+  uint32_t words[4*CHUNK];
+  // Bulk values start on a fresh block: the result only depends on the call sequence
+  m_used = 4;
+  for( size_t done = 0; done < n; )   {
+    size_t todo = std::min(n - done, 2*CHUNK);
+    size_t num_blocks = (todo + 1) / 2;
+    this->generate(words, num_blocks);
+    double* out = result + done;
+    for( size_t i = 0; i < todo; ++i )
+      out[i] = to_uniform(words[2*i], words[2*i+1]);
+    done += todo;
+  }
+}
+
+/// Bulk generation: n gaussian distributed random numbers
+void DigiRandomGenerator::gaussian(double* result, size_t n, double mean, double sigma)   {
+  uint32_t words[4*CHUNK];
+  double   radius[CHUNK], phi[CHUNK];
+  // Box-Muller: every block yields two gaussian values
+  m_used = 4;
+  for( size_t done = 0; done < n; )   {
+    size_t todo = std::min(n - done, 2*CHUNK);
+    size_t num_blocks = (todo + 1) / 2;
+    this->generate(words, num_blocks);
+    for( size_t i = 0; i < num_blocks; ++i )   {
+      radius[i] = sigma * std::sqrt(-2e0*std::log(to_uniform(words[4*i], words[4*i+1])));
+      phi[i]    = TWO_PI * to_uniform(words[4*i+2], words[4*i+3]);
+    }
+    double* out = result + done;
+    for( size_t i = 0; i < todo/2; ++i )   {
+      out[2*i]   = mean + radius[i] * std::cos(phi[i]);
+      out[2*i+1] = mean + radius[i] * std::sin(phi[i]);
+    }
+    if ( todo & 1 )   {
+      out[todo-1] = mean + radius[todo/2] * std::cos(phi[todo/2]);
+    }
+    done += todo;
+  }
+}
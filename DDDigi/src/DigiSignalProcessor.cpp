@@ -27,3 +27,15 @@ dd4hep::digi::DigiSignalProcessor::~DigiSignalProcessor() {
   InstanceCount::decrement(this);
 }
 
+
+/// Process the signals of whole columns of cells: result[i] = signal of cell i
+void dd4hep::digi::DigiSignalProcessor::process(const DigiCellColumns& cells, double* result)  const   {
+  for( std::size_t i = 0; i < cells.size; ++i )   {
+    DigiCellData data;
+    data.raw_value = cells.raw_value[i];
+    data.delay     = cells.delay ? cells.delay[i] : 0e0;
+    data.kill      = cells.kill  ? cells.kill[i] != 0 : false;
+    result[i]      = (*this)(data);
+    if ( cells.kill ) cells.kill[i] = data.kill ? 1 : 0;
+  }
+}
@@ -16,6 +16,7 @@
 #include "DDDigi/DigiSignalProcessorSequence.h"
 
 // C/C++ include files
+#include <algorithm>
 #include <stdexcept>
 
 using namespace dd4hep::digi;
@@ -49,3 +50,33 @@ double DigiSignalProcessorSequence::operator()(const DigiCellData& data)  const
     result += p->operator()(data);
   return data.kill ? 0e0 : result;
 }
+
+/// Process the signals of whole columns of cells
+/** The contributions of the members are accumulated chunk by chunk
+ *  in a buffer on the stack: no memory is allocated per call and nested
+ *  sequences are safe.
+ */
+void DigiSignalProcessorSequence::process(const DigiCellColumns& cells, double* result)  const   {
+  constexpr std::size_t CHUNK_SIZE = 256;
+  double contrib[CHUNK_SIZE];
+  for( std::size_t start = 0; start < cells.size; start += CHUNK_SIZE )   {
+    DigiCellColumns chunk;
+    chunk.size      = std::min(CHUNK_SIZE, cells.size - start);
+    chunk.raw_value = cells.raw_value + start;
+    chunk.delay     = cells.delay ? cells.delay + start : nullptr;
+    chunk.kill      = cells.kill  ? cells.kill  + start : nullptr;
+    double* res     = result + start;
+    for( std::size_t i = 0; i < chunk.size; ++i )
+      res[i] = chunk.raw_value[i];
+    for ( const auto* p : m_actors )   {
+      p->process(chunk, contrib);
+      for( std::size_t i = 0; i < chunk.size; ++i )
+        res[i] += contrib[i];
+    }
+    if ( chunk.kill )   {
+      const unsigned char* kill = chunk.kill;
+      for( std::size_t i = 0; i < chunk.size; ++i )
+        res[i] = kill[i] ? 0e0 : res[i];
+    }
+  }
+}
@@ -0,0 +1,88 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Primitives.h"
+#include "DDDigi/DigiSlotRegistry.h"
+#include "DDDigi/DigiAction.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+/// Declare a slot read or written by an action. Returns the slot index
+size_t DigiSlotRegistry::declare(const DigiAction* action, const string& nam, int mask,
+                                 const type_info& type, bool output)
+{
+  Key key;
+  key.set(nam, mask);
+  lock_guard<mutex> lock(m_lock);
+  auto iter = m_index.find(key.toLong());
+  size_t idx = m_slots.size();
+  if ( iter == m_index.end() )   {
+    Entry entry;
+    entry.name = nam;
+    entry.key  = key;
+    entry.type = &type;
+    m_slots.emplace_back(entry);
+    m_index.emplace(key.toLong(), idx);
+  }
+  else   {
+    idx = iter->second;
+    const Entry& e = m_slots[idx];
+    if ( e.name != nam )   {
+      except("DigiSlotRegistry","+++ Slot key collision: %s and %s [mask:%d]",
+             e.name.c_str(), nam.c_str(), mask);
+    }
+    if ( *e.type != type )   {
+      except("DigiSlotRegistry","+++ Slot %s [mask:%d] is declared with type %s and %s",
+             nam.c_str(), mask, typeName(*e.type).c_str(), typeName(type).c_str());
+    }
+  }
+  Entry& e = m_slots[idx];
+  if ( action ) (output ? e.producers : e.consumers).emplace_back(action);
+  return idx;
+}
+
+/// Number of declared slots
+size_t DigiSlotRegistry::size()  const   {
+  lock_guard<mutex> lock(m_lock);
+  return m_slots.size();
+}
+
+/// Find a slot by name and mask. Returns size_t(-1) if not declared
+size_t DigiSlotRegistry::find(const string& nam, int mask)  const   {
+  Key key;
+  key.set(nam, mask);
+  lock_guard<mutex> lock(m_lock);
+  auto iter = m_index.find(key.toLong());
+  return iter == m_index.end() ? size_t(-1) : iter->second;
+}
+
+/// Copy of the slot descriptions. To be used after initialization
+vector<DigiSlotRegistry::Entry> DigiSlotRegistry::entries()  const   {
+  lock_guard<mutex> lock(m_lock);
+  return m_slots;
+}
+
+/// Print the slot declarations
+void DigiSlotRegistry::print()  const   {
+  lock_guard<mutex> lock(m_lock);
+  for( size_t i = 0; i < m_slots.size(); ++i )   {
+    const Entry& e = m_slots[i];
+    printout(INFO,"DigiSlotRegistry","+++ Slot %3ld: %-24s mask:%3d %ld producer(s) %ld consumer(s) [%s]",
+             i, e.name.c_str(), int(e.key.values.mask), e.producers.size(), e.consumers.size(),
+             typeName(*e.type).c_str());
+  }
+}
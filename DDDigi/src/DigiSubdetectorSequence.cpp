@@ -51,6 +51,7 @@ void DigiSubdetectorSequence::initialize()   {
   m_sensDet      = sensitiveDetector(m_detectorName);
   m_parallelVid.clear();
   m_parallelDet.clear();
+  m_cells.clear();
   if ( m_detector.isValid() && m_sensDet.isValid() )   {
     m_idDesc       = m_sensDet.readout().idSpec();
     m_segmentation = m_sensDet.readout().segmentation();
@@ -59,8 +60,18 @@ void DigiSubdetectorSequence::initialize()   {
     VolumeID      msk = m_idDesc.get_mask(ids);
     scan_detector(m_detector, vid, msk);
   }
+  for( const auto& d : m_parallelVid )   {
+    const Context& c = d.second;
+    string id_desc   = m_idDesc.str(c.detector_id);
+    info("  Order:%-64s    vid:%s %s %s  %ld sensitive placements",
+         c.detector.path().c_str(), volumeID(d.first).c_str(),
+         volumeID(c.detector_id).c_str(), id_desc.c_str(), c.num_cells);
+  }
+  info("Compiled %ld parallelization contexts with %ld sensitive placements.",
+       m_parallelVid.size(), m_cells.size());
 }
 
+/// Collect the sensitive placements below a parallelization context into the cell plan
 void DigiSubdetectorSequence::scan_sensitive(PlacedVolume pv, VolumeID vid, VolumeID mask)   {
   Volume vol = pv.volume();
   if ( vol.isSensitive() )    {
@@ -70,6 +81,8 @@ void DigiSubdetectorSequence::scan_sensitive(PlacedVolume pv, VolumeID vid, Volu
     if ( is == m_scanners.end() )  {
       is = m_scanners.insert(make_pair(key, create_cell_scanner(sol, m_segmentation))).first;
     }
+    m_cells.emplace_back(Cell{pv, vid, mask, is->second.get()});
+    return;
   }
   for (int idau = 0, ndau = pv->GetNdaughters(); idau < ndau; ++idau) {
     PlacedVolume  p(pv->GetDaughter(idau));
@@ -94,9 +107,14 @@ void DigiSubdetectorSequence::scan_detector(DetElement de, VolumeID vid, VolumeI
     for (const auto& id : new_ids)   {
       if ( id.first == m_segmentName )   {
         VolumeID rid = detail::reverseBits<VolumeID>(new_vid);
-        m_parallelVid.emplace(make_pair(rid, Context(de, new_vid, rid, new_msk)));
-        m_parallelDet.emplace(make_pair(de, new_vid));
-        scan_sensitive(de.placement(), new_vid, new_msk);
+        auto ret = m_parallelVid.emplace(make_pair(rid, Context(de, new_vid, rid, new_msk)));
+        if ( ret.second )   {
+          Context& c = ret.first->second;
+          m_parallelDet.emplace(make_pair(de, new_vid));
+          c.first_cell = m_cells.size();
+          scan_sensitive(de.placement(), new_vid, new_msk);
+          c.num_cells  = m_cells.size() - c.first_cell;
+        }
         return;
       }
     }
@@ -120,46 +138,21 @@ void DigiSubdetectorSequence::process_cell(const DigiCellScanner& , const CellDa
   }
 }
 
-void DigiSubdetectorSequence::process_context(const Context& c, PlacedVolume pv, VolumeID vid, VolumeID mask)   const  {
-  Volume vol = pv.volume();
-  if ( vol.isSensitive() )    {
-    auto key = make_pair(vol->GetShape()->IsA(), m_segmentation);
-    auto is  = m_scanners.find(key);
-    if ( is == m_scanners.end() )   {
-      except("Fatal error in process_context: Invalid cell scanner. vid: %016X",vid);
-    }
-    (*(is->second))(pv, vid, m_cellHandler);
-    return;
-  }
-  for (int idau = 0, ndau = pv->GetNdaughters(); idau < ndau; ++idau) {
-    PlacedVolume p(pv->GetDaughter(idau));
-    const VolIDs& new_ids = p.volIDs();
-    if ( !new_ids.empty() )
-      process_context(c, p, vid | m_idDesc.encode(new_ids), mask | m_idDesc.get_mask(new_ids));
-    else
-      process_context(c, p, vid, mask);
-  }
+/// Process all sensitive placements of a parallelization context
+void DigiSubdetectorSequence::process_context(const Context& c)   const  {
+  const Cell* cell = m_cells.data() + c.first_cell;
+  for( const Cell* end = cell + c.num_cells; cell != end; ++cell )
+    (*cell->scanner)(cell->placement, cell->volume_id, m_cellHandler);
 }
 
 /// Pre-track action callback
 void DigiSubdetectorSequence::execute(DigiContext& context)  const   {
-  //static bool first = true;
-  //if ( first )    {
-    for( const auto& d : m_parallelVid )   {
-      const Context& c = d.second;
-      auto vid = c.detector_id;
-      auto det = c.detector;
-      string id_desc   = m_idDesc.str(vid);
-      info("  Order:%-64s    vid:%s %s %s",
-           det.path().c_str(), volumeID(d.first).c_str(), volumeID(vid).c_str(), id_desc.c_str());
-      process_context(c, c.detector.placement(), c.detector_id, c.detector_mask);
-    }
-    //}
-  
+  for( const auto& d : m_parallelVid )
+    process_context(d.second);
+
   this->DigiSynchronize::execute(context);
   debug("+++ Event: %8d (DigiSubdetectorSequence) Parallel: %s Done.",
         context.event().eventNumber, yes_no(m_parallel));
-  //m_end(&context);
 }
 
 /// Access subdetector from the detector description
@@ -0,0 +1,70 @@
+"""
+
+dd4hep simulation example setup using the python configuration
+
+Check of the memory mapped, indexed HepMC reader against the stream reader.
+
+The input file is read once with Geant4EventReaderHepMC and once with
+Geant4EventReaderHepMCIndexed using readHEPMC.py. The primary vertices
+and particles of every event must be identical.
+
+Usage: python compareHEPMC.py <input file>
+
+@author  M.Frank
+@version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import logging
+import subprocess
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+
+def primaries(input_file, reader):
+  script = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'readHEPMC.py')
+  proc = subprocess.Popen([sys.executable, script, input_file, reader],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  output = proc.communicate()[0]
+  print(output)
+  if proc.returncode != 0:
+    logger.error('+++ HepMC reader test FAILED: %s failed with status %d', reader, proc.returncode)
+    sys.exit(1)
+  events = [[]]
+  for line in output.splitlines():
+    if line.endswith(132 * '*'):
+      events.append([])
+    elif 'Mask:' in line:
+      events[-1].append(line)
+  return [e for e in events if e]
+
+
+def check(input_file):
+  stream = primaries(input_file, 'Geant4EventReaderHepMC')
+  indexed = primaries(input_file, 'Geant4EventReaderHepMCIndexed')
+  errors = 0 if stream else 1
+  if len(stream) != len(indexed):
+    logger.error('+++ Stream reader: %d events, indexed reader: %d events', len(stream), len(indexed))
+    errors = errors + 1
+  for event, (s, i) in enumerate(zip(stream, indexed)):
+    if s != i:
+      logger.error('+++ Event %d: %d lines from the stream reader, %d lines from the indexed reader',
+                   event, len(s), len(i))
+      for line in [x for x in s if x not in i] + [x for x in i if x not in s]:
+        logger.error('+++   %s', line)
+      errors = errors + 1
+  if errors:
+    logger.error('+++ HepMC reader test FAILED: %d differences', errors)
+    return 1
+  logger.info('+++ HepMC reader test PASSED: identical primaries for %d events', len(stream))
+  return 0
+
+
+if __name__ == "__main__":
+  if len(sys.argv) < 2:
+    logger.error('No input file given. Try again....')
+    sys.exit(2)  # ENOENT
+  sys.exit(check(sys.argv[1]))
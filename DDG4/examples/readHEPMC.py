@@ -14,14 +14,14 @@ logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
 logger = logging.getLogger(__name__)
 
 
-def run(input_file):
+def run(input_file, reader='Geant4EventReaderHepMC'):
   import DDG4
   from DDG4 import OutputLevel as Output
   kernel = DDG4.Kernel()
   kernel.detectorDescription()
   gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input")
   kernel.generatorAction().adopt(gen)
-  gen.Input = "Geant4EventReaderHepMC|" + input_file
+  gen.Input = reader + "|" + input_file
   gen.OutputLevel = Output.DEBUG
   gen.HaveAbort = False
   prim_vtx = DDG4.std_vector(str('dd4hep::sim::Geant4Vertex*'))()
@@ -59,6 +59,8 @@ if __name__ == "__main__":
   input_file = None
   if len(sys.argv) > 1:
     input_file = sys.argv[1]
+    if len(sys.argv) > 2:
+      sys.exit(run(input_file, sys.argv[2]))
     sys.exit(run(input_file))
   else:
     logger.error('No input file given. Try again....')
@@ -0,0 +1,141 @@
+"""
+
+dd4hep simulation example setup using the python configuration
+
+Check of the input prefetching of the Geant4InputAction in multi-threaded mode.
+
+The HepMC input is simulated in two runs by several worker threads, which
+share one input action:
+  - once with the input action called under the global lock,
+  - once with the events read ahead (property Prefetch).
+The generator particles of every event number must be identical.
+With the LCIOFileReader the LCIO output of the workers must in addition
+receive the event parameters of the input file for every event.
+
+Usage: python readHEPMC_MT.py <input file> [reader type]
+
+@author  M.Frank
+@version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import logging
+import subprocess
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+num_events = 5    # Events per run
+num_runs = 2
+
+
+def setupWorker(geant4, reader):
+  import DDG4
+  kernel = geant4.kernel()
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input", shared=True)
+  kernel.generatorAction().adopt(gen)
+  gen = DDG4.GeneratorAction(kernel, "Geant4InteractionMerger/InteractionMerger")
+  kernel.generatorAction().adopt(gen)
+  gen = DDG4.GeneratorAction(kernel, "Geant4PrimaryHandler/PrimaryHandler")
+  kernel.generatorAction().adopt(gen)
+  if reader == 'LCIOFileReader':
+    # LCIO events are only built, not written: the event parameters are checked
+    evt_lcio = DDG4.EventAction(kernel, 'Geant4Output2LCIO/LcioOutput')
+    evt_lcio.Output = ''
+    kernel.eventAction().adopt(evt_lcio)
+  return 1
+
+
+def setupMaster(geant4):
+  return 1
+
+
+def simulate(input_file, reader, prefetch):
+  import DDG4
+  from DDG4 import OutputLevel as Output
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/DDDetectors/compact/SiD.xml"))
+  DDG4.importConstants(kernel.detectorDescription(), debug=False)
+
+  kernel.NumberOfThreads = 3
+  kernel.RunManagerType = 'G4MTRunManager'
+  geant4 = DDG4.Geant4(kernel)
+  ui = geant4.setupCshUI(ui=False)
+  ui.Commands = ['/run/beamOn %d' % (num_events,) for i in range(num_runs)]
+  #
+  # The shared input action lives in the master. The workers only use it.
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input")
+  gen.Input = reader + "|" + input_file
+  gen.Prefetch = prefetch
+  gen.OutputLevel = Output.DEBUG
+  kernel.generatorAction().adopt(gen)
+
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4, reader),
+                               master=setupMaster, master_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.setupTrackingFieldMT()
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+  return 0
+
+
+def primaries(input_file, reader, prefetch):
+  proc = subprocess.Popen([sys.executable, __file__, input_file, reader, str(prefetch)],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  output = proc.communicate()[0]
+  print(output)
+  if proc.returncode != 0:
+    logger.error('+++ Prefetch test FAILED: the job with Prefetch=%d failed with status %d',
+                 prefetch, proc.returncode)
+    sys.exit(1)
+  count = re.compile(r'Event (\d+): Particle interaction with (\d+) generator particles and (\d+) vertices')
+  momentum = re.compile(r'Event (\d+): Momentum sum of the generator particles: \((\S+)\)')
+  saved = re.compile(r'Saving LCIO event (\d+) run (\d+)( with the input event parameters)?')
+  result, lcio = {}, []
+  for line in output.splitlines():
+    match = count.search(line) or momentum.search(line)
+    if match:
+      result.setdefault(int(match.group(1)), []).append(match.groups()[1:])
+      continue
+    match = saved.search(line)
+    if match:
+      lcio.append(match.groups())
+  return result, sorted(lcio)
+
+
+def check(input_file, reader):
+  locked, locked_lcio = primaries(input_file, reader, 0)
+  prefetched, prefetched_lcio = primaries(input_file, reader, 4)
+  errors = 0
+  if reader == 'LCIOFileReader':
+    # Events carry the numbers of the input file: the order of the workers does not matter
+    missing = [e for e in prefetched_lcio if not e[2]]
+    if len(prefetched_lcio) != num_events * num_runs or missing or prefetched_lcio != locked_lcio:
+      logger.error('+++ LCIO events: locked input: %s prefetched input: %s',
+                   str(locked_lcio), str(prefetched_lcio))
+      errors = errors + 1
+  for event in range(num_events * num_runs):
+    if event not in locked or locked.get(event) != prefetched.get(event):
+      logger.error('+++ Event %d: locked input: %s prefetched input: %s',
+                   event, str(locked.get(event)), str(prefetched.get(event)))
+      errors = errors + 1
+  if errors:
+    logger.error('+++ Prefetch test FAILED: %d events differ', errors)
+    return 1
+  logger.info('+++ Prefetch test PASSED: identical primaries for %d events in %d runs',
+              num_events * num_runs, num_runs)
+  return 0
+
+
+if __name__ == "__main__":
+  if len(sys.argv) < 2:
+    logger.error('No input file given. Try again....')
+    sys.exit(2)  # ENOENT
+  reader = sys.argv[2] if len(sys.argv) > 2 else 'Geant4EventReaderHepMC'
+  if len(sys.argv) > 3:
+    sys.exit(simulate(sys.argv[1], reader, int(sys.argv[3])))
+  sys.exit(check(sys.argv[1], reader))
@@ -0,0 +1,88 @@
+"""
+
+dd4hep simulation example setup using the python configuration
+
+Check of the merged ROOT output in multi-threaded mode.
+
+Every worker thread writes its events with its own Geant4Output2ROOT
+instance into memory buffers (property MergeOutput), which are merged
+into one output file. The merged EVENT tree must contain all events.
+
+Usage: python writeROOT_MT.py [number of events] [number of threads]
+
+@author  M.Frank
+@version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import logging
+import subprocess
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+output_file = 'DDG4_ROOT_merge_MT.root'
+
+
+def setupWorker(geant4):
+  from g4units import GeV
+  geant4.setupGun('Gun', particle='mu-', energy=5 * GeV, multiplicity=2)
+  output = geant4.setupROOTOutput('RootOutput', output_file, mc_truth=False, merge=True)
+  output.MergeInterval = 3
+  return 1
+
+
+def setupMaster(geant4):
+  return 1
+
+
+def simulate(num_events, num_threads):
+  import DDG4
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/DDDetectors/compact/SiD.xml"))
+  DDG4.importConstants(kernel.detectorDescription(), debug=False)
+
+  kernel.NumberOfThreads = num_threads
+  kernel.RunManagerType = 'G4MTRunManager'
+  kernel.NumEvents = num_events
+  geant4 = DDG4.Geant4(kernel)
+  geant4.setupCshUI(ui=False)
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4,),
+                               master=setupMaster, master_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.setupTrackingFieldMT()
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+  return 0
+
+
+def check(num_events, num_threads):
+  if os.path.exists(output_file):
+    os.remove(output_file)
+  proc = subprocess.Popen([sys.executable, __file__, str(num_events), str(num_threads), 'simulate'],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  print(proc.communicate()[0])
+  if proc.returncode != 0:
+    logger.error('+++ ROOT merge test FAILED: the simulation failed with status %d', proc.returncode)
+    return 1
+  import ROOT
+  root_file = ROOT.TFile.Open(output_file)
+  tree = root_file.Get('EVENT') if root_file and not root_file.IsZombie() else None
+  entries = tree.GetEntries() if tree else -1
+  if entries != num_events:
+    logger.error('+++ ROOT merge test FAILED: %d events simulated, %d entries in the merged tree',
+                 num_events, entries)
+    return 1
+  logger.info('+++ ROOT merge test PASSED: %d entries written by %d threads', entries, num_threads)
+  return 0
+
+
+if __name__ == "__main__":
+  num_events = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+  num_threads = int(sys.argv[2]) if len(sys.argv) > 2 else 3
+  if len(sys.argv) > 3:
+    sys.exit(simulate(num_events, num_threads))
+  sys.exit(check(num_events, num_threads))
@@ -40,10 +40,12 @@ namespace dd4hep {
     protected:
       /// Reference to the detector description field
       OverlayedField m_field;
+      /// Flattened magnetic field components including the conversion to Geant4 units
+      OverlayedField::Evaluator m_evaluator;
 
     public:
       /// Constructor. The sensitive detector element is identified by the detector name
-      Geant4Field(OverlayedField field) : m_field(field) {   }
+      Geant4Field(OverlayedField field);
       /// Standard destructor
       virtual ~Geant4Field() {    }
       /// Access field values at a given point
@@ -26,6 +26,7 @@ namespace dd4hep {
   namespace sim {
 
     // Forward declarations
+    class Geant4InputAction;
     class Geant4GeneratorAction;
     class Geant4SharedGeneratorAction;
     class Geant4GeneratorActionSequence;
@@ -70,6 +71,8 @@ namespace dd4hep {
      *
      * Shared action should be 'fast'. The global lock otherwise
      * inhibits the efficient use of the multiple threads.
+     * Input actions reading their events ahead (Geant4InputAction
+     * with property Prefetch > 0) are called without lock.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -79,6 +82,8 @@ namespace dd4hep {
     protected:
       /// Reference to the shared action
       Geant4GeneratorAction* m_action = 0;
+      /// Reference to the shared action if it is an input action
+      Geant4InputAction*     m_input  = 0;
       
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4SharedGeneratorAction);
@@ -24,6 +24,7 @@
 // C/C++ include files
 #include <map>
 #include <vector>
+#include <unordered_map>
 
 // Forward declarations (TGeo)
 class TGeoElement;
@@ -119,12 +120,16 @@ namespace dd4hep {
       std::map<VisAttr, G4VisAttributes*>                      g4Vis;
       std::map<LimitSet, G4UserLimits*>                        g4Limits;
       std::map<Geant4PlacementPath, VolumeID>                  g4Paths;
+      /// Hash index of g4Paths. Entries with colliding hashes are marked with a null pointer
+      std::unordered_map<unsigned long long, const std::pair<const Geant4PlacementPath, VolumeID>*> g4PathIndex;
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
       G4VPhysicalVolume*                                       m_world;
       PrintLevel                                               printLevel;
       bool                                                     valid;
+      /// Flag to reuse the last volume ID while the touchable history is unchanged
+      bool                                                     cacheTouchables = true;
     private:
       friend class Geant4Mapping;
       /// Default constructor
@@ -138,6 +143,20 @@ namespace dd4hep {
       void setWorld(const TGeoNode* node);
       /// Assemble Geant4 volume path
       static std::string placementPath(const Geant4PlacementPath& path, bool reverse=true);
+      /// Start value of the volume path hash
+      static constexpr unsigned long long placementPathHashSeed = 0xcbf29ce484222325ULL;
+      /// Hash of a Geant4 volume path (incrementally combined placement pointers)
+      static unsigned long long placementPathHash(const Geant4PlacementPath& path);
+      /// Incremental step of the volume path hash
+      static unsigned long long placementPathHash(unsigned long long hash, const G4VPhysicalVolume* pv)  {
+        unsigned long long h = (unsigned long long)pv;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return (hash ^ h) * 0x100000001b3ULL;
+      }
+      /// Register a volume path in the hash index
+      void indexPlacementPath(const std::pair<const Geant4PlacementPath, VolumeID>& entry);
     };
 
   }    // End namespace sim
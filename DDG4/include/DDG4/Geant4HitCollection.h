@@ -20,9 +20,14 @@
 #include "G4VHit.hh"
 
 // C/C++ include files
+#include <new>
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <climits>
+#include <functional>
+#include <utility>
 #include <typeinfo>
 #include <stdexcept>
 
@@ -72,8 +77,10 @@ namespace dd4hep {
         const ComponentCast& cast;
         const ComponentCast& vec_type;
 #endif
+        /// Destructor call for hits, which do not own their memory (arena allocated). Otherwise NULL
+        void (*destruct)(void*) = 0;
         /// Initializing Constructor
-        HitManipulator(const ComponentCast& c, const ComponentCast& v);
+        HitManipulator(const ComponentCast& c, const ComponentCast& v, void (*d)(void*)=0);
         /// Default destructor
         ~HitManipulator();
         /// Check pointer to be of proper type
@@ -97,10 +104,19 @@ namespace dd4hep {
             delete p;
           obj.first = 0;
         }
+        /// Static function to call the destructor of hits allocated from an arena
+        template <typename TYPE> static void destructHit(void* obj) {
+          ((TYPE*)obj)->~TYPE();
+        }
         template <typename TYPE> static HitManipulator* instance() {
           static HitManipulator hm(ComponentCast::instance<TYPE>(), ComponentCast::instance<std::vector<TYPE*> >());
           return &hm;
         }
+        /// Manipulator for hits allocated from a Geant4HitArena: memory is not freed hit by hit
+        template <typename TYPE> static HitManipulator* arenaInstance() {
+          static HitManipulator hm(ComponentCast::instance<TYPE>(), ComponentCast::instance<std::vector<TYPE*> >(), destructHit<TYPE>);
+          return &hm;
+        }
       };
 
       typedef HitManipulator::Wrapper Wrapper;
@@ -168,6 +184,138 @@ namespace dd4hep {
       }
     };
 
+    /// Open addressing hash index mapping hit keys to hit positions in a collection
+    /**
+     *  Flat replacement of std::map<VolumeID,size_t> for large collections.
+     *  Slots are stored contiguously and probed linearly. The table keeps
+     *  a load factor below 50 percent and is rebuilt with twice the size
+     *  when this limit is exceeded.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4HitIndex  {
+    public:
+      /// Value returned by find() if the key is not present
+      static constexpr size_t npos = ~size_t(0);
+    protected:
+      /// Table slot
+      struct Slot  {
+        VolumeID key;
+        size_t   index;
+      };
+      /// Table slots. Empty slots have index == npos
+      std::vector<Slot> m_slots;
+      /// Number of occupied slots
+      size_t            m_size = 0;
+      /// Hash function (64 bit finalizer of MurmurHash3)
+      static size_t hash(VolumeID key)   {
+        unsigned long long h = (unsigned long long)key;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return size_t(h);
+      }
+      /// Resize the table and re-insert all entries
+      void rehash(size_t new_size);
+    public:
+      /// Default constructor
+      Geant4HitIndex() = default;
+      /// Number of entries in the index
+      size_t size() const   {
+        return m_size;
+      }
+      /// Remove all entries. The allocated table is kept
+      void clear();
+      /// Insert new key. Returns false if the key is already present
+      bool insert(VolumeID key, size_t index)   {
+        if ( 2*(m_size+1) > m_slots.size() )
+          rehash(m_slots.empty() ? 256 : 2*m_slots.size());
+        size_t mask = m_slots.size()-1;
+        for( size_t i = hash(key)&mask; ; i = (i+1)&mask )  {
+          Slot& s = m_slots[i];
+          if ( s.index == npos )  {
+            s.key = key;
+            s.index = index;
+            ++m_size;
+            return true;
+          }
+          else if ( s.key == key )  {
+            return false;
+          }
+        }
+      }
+      /// Access the hit position of a given key. Returns npos if not present
+      size_t find(VolumeID key) const   {
+        if ( m_size )  {
+          size_t mask = m_slots.size()-1;
+          for( size_t i = hash(key)&mask; ; i = (i+1)&mask )  {
+            const Slot& s = m_slots[i];
+            if ( s.index == npos ) return npos;
+            if ( s.key == key ) return s.index;
+          }
+        }
+        return npos;
+      }
+    };
+
+    /// Memory arena for hit objects of one event
+    /**
+     *  Hits are allocated from large memory blocks. The memory is not
+     *  released hit by hit, but returned in one go by reset(), which
+     *  is called when the owning collection is cleared or deleted at
+     *  the end of the event. Released blocks are kept in a thread local
+     *  pool and reused by the following events.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4HitArena  {
+    public:
+      /// Default size of one memory block
+      static constexpr size_t BLOCK_SIZE = 64*1024;
+    protected:
+      /// Memory blocks in use (address, size)
+      std::vector<std::pair<char*,size_t> > m_blocks;
+      /// Current fill position in the last block
+      char*  m_current = 0;
+      /// Free bytes in the last block
+      size_t m_left = 0;
+      /// Attach new memory block large enough for 'len' bytes
+      void newBlock(size_t len);
+    public:
+      /// Default constructor
+      Geant4HitArena() = default;
+      /// Inhibit copy constructor
+      Geant4HitArena(const Geant4HitArena& copy) = delete;
+      /// Default destructor. Returns all blocks to the pool
+      ~Geant4HitArena();
+      /// Inhibit assignment
+      Geant4HitArena& operator=(const Geant4HitArena& copy) = delete;
+      /// Allocate aligned memory for one object
+      void* allocate(size_t len, size_t align)   {
+        size_t pad = (align - (size_t(m_current) & (align-1))) & (align-1);
+        if ( len+pad > m_left )  {
+          newBlock(len+align);
+          pad = (align - (size_t(m_current) & (align-1))) & (align-1);
+        }
+        char* p = m_current + pad;
+        m_current = p + len;
+        m_left   -= len + pad;
+        return p;
+      }
+      /// Number of memory blocks in use
+      size_t numBlocks() const   {
+        return m_blocks.size();
+      }
+      /// Release all memory blocks. The objects must be destructed beforehand
+      void reset();
+    };
+
     /// Generic hit container class using Geant4HitWrapper objects
     /**
      * Opaque hit collection.
@@ -193,6 +341,16 @@ namespace dd4hep {
      * This obviously only helps, if contributions to the same cell come in
      * sequence ie. from the same G4Track.
      *
+     * Collections with very many hits (e.g. calorimeter showers) may in addition use
+     *
+     *   setOptimize(OPTIMIZE_FLATLOOKUP);   Keyed access by an open addressing index
+     *   setOptimize(OPTIMIZE_ARENA);        Hits created with create<TYPE>(...) or
+     *                                       createByKey<TYPE>(key,...) are allocated
+     *                                       from a per-event memory arena
+     *
+     * Hits allocated from the arena stay owned by the collection: they may be accessed
+     * with getHits(), but not released with releaseHits().
+     *
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -225,6 +383,27 @@ namespace dd4hep {
         virtual void* operator()(const Geant4HitWrapper& w) const = 0;
       };
 
+      /// Generic class template to select hits using a hashed lookup
+      /**
+       *
+       *  Base class for hit comparisons, which in addition provide
+       *  a hash value of the searched attributes. Hits registered with
+       *  the same hash value are compared using operator().
+       *
+       * \author  M.Frank
+       * \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class HashCompare : public Compare {
+      public:
+        /// Default destructor
+        virtual ~HashCompare();
+        /// Hash value of the attributes to be compared
+        virtual size_t hash() const = 0;
+      };
+      /// Hit hash map for hashed lookup
+      typedef std::unordered_multimap<size_t, size_t>  Hashes;
+
       /// Union defining the hit collection flags for processing
       union CollectionFlags  {
         /// Full value
@@ -233,6 +412,8 @@ namespace dd4hep {
         struct BitItems  {
           unsigned           repeatedLookup:1;
           unsigned           mappedLookup:1;
+          unsigned           flatLookup:1;
+          unsigned           arena:1;
         }                    bits;
       };
 
@@ -243,10 +424,18 @@ namespace dd4hep {
       Geant4Sensitive*                 m_detector;
       /// The type of the objects in this collection. Set by the constructor
       Manip*                           m_manipulator;
+      /// The type of arena allocated objects in this collection. Set by the constructor
+      Manip*                           m_arenaManipulator;
       /// Memorize for speedup the last searched hit
       size_t                           m_lastHit;
       /// Hit key map for fast random lookup
       Keys                             m_keys;
+      /// Flat hit key index (used with OPTIMIZE_FLATLOOKUP)
+      Geant4HitIndex                   m_index;
+      /// Hit hash map for hashed lookup by attributes
+      Hashes                           m_hashes;
+      /// Memory arena for hit objects (used with OPTIMIZE_ARENA)
+      Geant4HitArena                   m_arena;
       /// Optimization flags
       CollectionFlags                  m_flags;
       
@@ -257,10 +446,18 @@ namespace dd4hep {
       void* findHit(const Compare& cmp);
       /// Find hit in a collection by comparison of the key
       Geant4HitWrapper* findHitByKey(VolumeID key);
+      /// Find hit in a collection by hashed comparison of attributes
+      void* findHitByHash(const HashCompare& cmp);
       /// Release all hits from the Geant4 container and pass ownership to the caller
       void releaseData(const ComponentCast& cast, std::vector<void*>* result);
       /// Release all hits from the Geant4 container. Ownership stays with the container
       void getData(const ComponentCast& cast, std::vector<void*>* result);
+      /// Register hit key. Throws exception if the key is already present
+      void insertKey(VolumeID key, size_t which);
+      /// Check that the hit key is not yet present. Throws exception otherwise
+      void checkKey(VolumeID key)  const;
+      /// Check if hits may be released. Throws exception for arena allocated hits
+      void checkRelease()  const;
 
     public:
       /// Enumeration for collection optimization types
@@ -268,6 +465,8 @@ namespace dd4hep {
         OPTIMIZE_NONE = 0,
         OPTIMIZE_REPEATEDLOOKUP = 1<<0,
         OPTIMIZE_MAPPEDLOOKUP   = 1<<1,
+        OPTIMIZE_FLATLOOKUP     = 1<<2,
+        OPTIMIZE_ARENA          = 1<<3,
         OPTIMIZE_LAST
       };
 
@@ -276,6 +475,7 @@ namespace dd4hep {
       Geant4HitCollection(const std::string& det, const std::string& coll, Geant4Sensitive* sd)
         : G4VHitsCollection(det, coll), m_detector(sd),
           m_manipulator(Geant4HitWrapper::manipulator<TYPE>()),
+          m_arenaManipulator(Geant4HitWrapper::HitManipulator::arenaInstance<TYPE>()),
           m_lastHit(ULONG_MAX)
       {
         newInstance();
@@ -287,6 +487,7 @@ namespace dd4hep {
       Geant4HitCollection(const std::string& det, const std::string& coll, Geant4Sensitive* sd, const TYPE*)
         : G4VHitsCollection(det, coll), m_detector(sd),
           m_manipulator(Geant4HitWrapper::manipulator<TYPE>()),
+          m_arenaManipulator(Geant4HitWrapper::HitManipulator::arenaInstance<TYPE>()),
           m_lastHit(ULONG_MAX)
       {
         newInstance();
@@ -337,25 +538,57 @@ namespace dd4hep {
       }
       /// Add a new hit with a check, that the hit is of the same type
       template <typename TYPE> void add(VolumeID key, TYPE* hit_pointer) {
+        insertKey(key, m_hits.size());
+        Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
         m_lastHit = m_hits.size();
-        std::pair<Keys::iterator,bool> ret = m_keys.emplace(key,m_lastHit);
-        if ( ret.second )  {
-          Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
-          m_hits.emplace_back(w);
-          return;
+        m_hits.emplace_back(w);
+      }
+      /// Create a new hit and add it to the collection. Uses the memory arena if enabled
+      template <typename TYPE, typename... ARGS> TYPE* create(ARGS&&... args) {
+        if ( m_flags.bits.arena && &ComponentCast::instance<TYPE>() == &m_manipulator->cast )  {
+          TYPE* hit_pointer = new(m_arena.allocate(sizeof(TYPE),alignof(TYPE))) TYPE(std::forward<ARGS>(args)...);
+          m_lastHit = m_hits.size();
+          m_hits.emplace_back(Geant4HitWrapper::Wrapper(hit_pointer, m_arenaManipulator));
+          return hit_pointer;
         }
-        throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
+        TYPE* hit_pointer = new TYPE(std::forward<ARGS>(args)...);
+        add(hit_pointer);
+        return hit_pointer;
+      }
+      /// Create a new hit and add it to the collection with a key. Uses the memory arena if enabled
+      template <typename TYPE, typename... ARGS> TYPE* createByKey(VolumeID key, ARGS&&... args) {
+        checkKey(key);
+        size_t which = m_hits.size();
+        TYPE* hit_pointer = create<TYPE>(std::forward<ARGS>(args)...);
+        insertKey(key, which);
+        return hit_pointer;
+      }
+      /// Add a new hit and register it for hashed lookup
+      template <typename TYPE> void addByHash(const HashCompare& cmp, TYPE* hit_pointer) {
+        size_t which = m_hits.size();
+        add(hit_pointer);
+        m_hashes.emplace(cmp.hash(), which);
+      }
+      /// Create a new hit and register it for hashed lookup. Uses the memory arena if enabled
+      template <typename TYPE, typename... ARGS> TYPE* createByHash(const HashCompare& cmp, ARGS&&... args) {
+        size_t which = m_hits.size();
+        TYPE* hit_pointer = create<TYPE>(std::forward<ARGS>(args)...);
+        m_hashes.emplace(cmp.hash(), which);
+        return hit_pointer;
       }
       /// Find hits in a collection by comparison of attributes
       template <typename TYPE> TYPE* find(const Compare& cmp) {
         return (TYPE*) findHit(cmp);
       }
+      /// Find hits registered with addByHash/createByHash. O(1) on average
+      template <typename TYPE> TYPE* findByHash(const HashCompare& cmp) {
+        return (TYPE*) findHitByHash(cmp);
+      }
       /// Find hits in a collection by comparison of key value
       template <typename TYPE> TYPE* findByKey(VolumeID key) {
-        Keys::const_iterator i=m_keys.find(key);
-        if ( i == m_keys.end() ) return 0;
-        m_lastHit = (*i).second;
-        TYPE* obj = m_hits.at(m_lastHit);
+        Geant4HitWrapper* w = findHitByKey(key);
+        if ( !w ) return 0;
+        TYPE* obj = *w;
         return obj;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
@@ -366,6 +599,8 @@ namespace dd4hep {
         }
         m_lastHit = ULONG_MAX;
         m_keys.clear();
+        m_index.clear();
+        m_hashes.clear();
         return vec;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
@@ -407,6 +642,46 @@ namespace dd4hep {
       return pos == h->position ? h : 0;
     }
 
+    /// Specialized hit selector based on the hit's position with hashed lookup.
+    /**
+     *  Class for hit matching using the hit position. Unlike PositionCompare,
+     *  which requires a linear scan of the collection, the hash of the position
+     *  allows to find the hit in constant time with
+     *
+     *    coll->findByHash<TYPE>(cmp)
+     *
+     *  if the hits were added with addByHash or createByHash.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    template<typename TYPE, typename POS> class PositionHashCompare : public Geant4HitCollection::HashCompare {
+    public:
+      const POS& pos;
+      /// Constructor
+      PositionHashCompare(const POS& p) : pos(p)  {      }
+      /// Hash value of the position. Equal positions (also +-0) have equal hashes
+      virtual size_t hash() const;
+      /// Comparison function
+      virtual void* operator()(const Geant4HitWrapper& w) const;
+    };
+
+    template <typename TYPE, typename POS>
+    size_t PositionHashCompare<TYPE,POS>::hash() const {
+      std::hash<double> hd;
+      size_t h = hd(pos.X()+0.0);
+      h ^= hd(pos.Y()+0.0) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+      h ^= hd(pos.Z()+0.0) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+      return h;
+    }
+
+    template <typename TYPE, typename POS>
+    void* PositionHashCompare<TYPE,POS>::operator()(const Geant4HitWrapper& w) const {
+      TYPE* h = w;
+      return pos == h->position ? h : 0;
+    }
+
     /// Specialized hit selector based on the hit's cell identifier.
     /**
      *  Class for hit matching using the hit's cell identifier.
@@ -18,9 +18,11 @@
 #include "DDG4/Geant4Vertex.h"
 #include "DDG4/Geant4Particle.h"
 #include "DDG4/Geant4GeneratorAction.h"
+#include "DD4hep/ExtensionEntry.h"
 #include "Parsers/Parsers.h"
 
 // C/C++ include files
+#include <mutex>
 #include <vector>
 #include <memory>
 
@@ -52,6 +54,7 @@ namespace dd4hep  {
       typedef Geant4Particle Particle;
       typedef std::vector<Particle*> Particles;
       typedef std::vector<Vertex*> Vertices;
+      typedef std::vector<std::pair<unsigned long long int,ExtensionEntry*> > EventExtensions;
       /// Status codes of the event reader object. Anything with NOT low-bit set is an error.
       enum EventReaderStatus {
         EVENT_READER_ERROR=0,
@@ -71,6 +74,8 @@ namespace dd4hep  {
       int  m_currEvent;
       /// The input action context
       Geant4InputAction *m_inputAction;
+      /// Extensions of the event read last, which are attached to the event by the input action
+      EventExtensions m_eventExtensions;
 
       /// transform the string parameter value into the type of parameter
       /**
@@ -98,6 +103,18 @@ namespace dd4hep  {
       Geant4Context* context() const;
       /// Set the input action
       void setInputAction(Geant4InputAction* action);
+      /// Add an extension object to the event read last. Ownership is transferred.
+      /** Readers must use this call rather than the event of the context:
+       *  with prefetching the events are read ahead by a separate thread
+       *  and only later generated on the context of a worker thread.
+       */
+      template <typename T> void addEventExtension(T* ptr)   {
+        m_eventExtensions.emplace_back(detail::typeHash64<T>(), new detail::DeleteExtension<T,T>(ptr));
+      }
+      /// Hand the extensions of the event read last over to the caller
+      void takeEventExtensions(EventExtensions& extensions);
+      /// Delete extension objects, which were not attached to an event
+      static void deleteEventExtensions(EventExtensions& extensions);
       /// File name
       const std::string& name()  const   {  return m_name;         }
       /// Flag if direct event access (by event sequence number) is supported (Default: false)
@@ -134,6 +151,16 @@ namespace dd4hep  {
      * Concrete implementation of the Geant4 generator action base class
      * populating Geant4 primaries from Geant4 and HepStd files.
      *
+     * If the property Prefetch is set to N > 0, the events are read and decoded
+     * ahead of time by a separate thread, which keeps up to N events ready.
+     * Worker threads pick up their event without taking a lock. The input event
+     * is then selected by the Geant4 event number: event n of the first run
+     * receives the input record n + Sync, independent of the thread scheduling.
+     * Every further run continues the input after the last event of the previous run.
+     * Applies to all Geant4EventReader implementations. Readers pass additional
+     * event data (e.g. the LCIO event parameters) with Geant4EventReader::addEventExtension:
+     * these extensions travel with the prefetched event to the worker context.
+     *
      *  \author  P.Kostka (main author)
      *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
      *  \version 1.0
@@ -146,6 +173,7 @@ namespace dd4hep  {
       typedef Geant4Particle Particle;
       typedef std::vector<Particle*> Particles;
       typedef std::vector<Vertex*> Vertices;
+      typedef Geant4EventReader::EventExtensions EventExtensions;
     protected:
       /// Property: input file
       std::string         m_input;
@@ -163,12 +191,35 @@ namespace dd4hep  {
       bool m_abort;
       /// Property: named parameters to configure file readers or input actions
       std::map< std::string, std::string> m_parameters;
+      /// Property: number of events to be read ahead by a separate thread (default: 0 = off)
+      int                 m_prefetch;
+      /// Queue of the events read ahead
+      class PrefetchQueue;
+      PrefetchQueue*      m_queue;
+      /// Flag to start the prefetch thread exactly once
+      std::once_flag      m_queueOnce;
+      /// Input record of the first event of the current run (prefetch only)
+      int                 m_runFirstRecord;
+      /// Input record of the first event of the next run (prefetch only)
+      int                 m_nextRunRecord;
+
+      /// Create the event reader
+      int createReader(int evid);
+      /// Read one event and its event extensions from the event reader
+      int readEvent(int evid, Vertices& vertices, Particles& particles, EventExtensions& extensions);
+      /// Begin-run action callback
+      void beginRun(const G4Run* run);
 
     public:
       /// Read an event and return a LCCollectionVec of MCParticles.
       int readParticles(int event_number,
                         Vertices&  vertices,
                         Particles& particles);
+      /// Read an event with the event extensions of the reader. The caller takes ownership
+      int readParticles(int event_number,
+                        Vertices&  vertices,
+                        Particles& particles,
+                        EventExtensions& extensions);
       /// helper to report Geant4 exceptions
       std::string issue(int i) const;
 
@@ -178,8 +229,12 @@ namespace dd4hep  {
       virtual ~Geant4InputAction();
       /// Create particle vector
       Particles* new_particles() const { return new Particles; }
+      /// Flag if the events are read ahead. If set, generate() may be called concurrently
+      bool isPrefetching() const  {  return m_prefetch > 0;  }
       /// Callback to generate primary particles
       virtual void operator()(G4Event* event);
+      /// Generate primary particles into the event of the given context
+      void generate(Geant4Context* context, G4Event* event);
     };
   }     /* End namespace sim   */
 }       /* End namespace dd4hep */
@@ -16,6 +16,9 @@
 // Framework include files
 #include "DDG4/Geant4OutputAction.h"
 
+// C/C++ include files
+#include <memory>
+
 class TFile;
 class TTree;
 class TBranch;
@@ -30,6 +33,15 @@ namespace dd4hep {
 
     /// Class to output Geant4 event data to ROOT files
     /**
+     *  In multi-threaded mode the action is normally shared and all worker
+     *  threads serialize on the output. With the property MergeOutput = true
+     *  instead every worker thread owns a separate (not shared) instance.
+     *  All instances writing to the same output file fill their events into
+     *  in-memory files obtained from a common TBufferMerger. Serialization and
+     *  compression are done by the workers in parallel. Every MergeInterval
+     *  events the buffer is passed to the merger, which writes the output file.
+     *  Merging requires ROOT 6.10 or newer.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -54,7 +66,20 @@ namespace dd4hep {
       std::vector<std::string> m_disabledCollections;
       /// Property: vector with disabled collections
       bool  m_disableParticles = false;
+      /// Property: merge the output of the worker thread instances with a TBufferMerger
+      bool  m_mergeOutput = false;
+      /// Property: number of events after which the memory buffer is passed to the merger
+      int   m_mergeInterval = 100;
+      /// Number of events in the memory buffer
+      int   m_mergeEvents = 0;
+      /// Reference to the merger shared by all instances writing to the same file
+      std::shared_ptr<void>  m_merger;
+      /// Reference to the memory file of this instance
+      std::shared_ptr<TFile> m_mergeFile;
       
+      /// Pass the memory buffer to the output merger
+      void flushBuffer();
+
     public:
       /// Standard constructor
       Geant4Output2ROOT(Geant4Context* context, const std::string& nam);
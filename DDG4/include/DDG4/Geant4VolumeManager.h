@@ -20,6 +20,7 @@
 
 // Geant4 forward declarations
 class G4VTouchable;
+class G4StepPoint;
 class G4VPhysicalVolume;
 
 
@@ -75,6 +76,8 @@ namespace dd4hep {
       VolumeID volumeID(const std::vector<const G4VPhysicalVolume*>& path) const;
       /// Access CELLID by Geant4 touchable object
       VolumeID volumeID(const G4VTouchable* touchable) const;
+      /// Access CELLID by Geant4 step point. Reuses the last result while the touchable of the track is unchanged
+      VolumeID volumeID(const G4StepPoint* point) const;
       /// Accessfully decoded volume fields  by placement path
       void volumeDescriptor(const std::vector<const G4VPhysicalVolume*>&   path,
                             std::pair<VolumeID,std::vector<std::pair<const BitFieldElement*, VolumeID> > >& volume_desc) const;
@@ -366,7 +366,8 @@ void Geant4Output2LCIO::saveEvent(OutputContext<G4Event>& ctxt)  {
     runNumber = m_runNo + runNumberOffset;
     eventNumber = ctxt.context->GetEventID() + eventNumberOffset;
   }
-  print("+++ Saving LCIO event %d run %d ....", eventNumber, runNumber);
+  print("+++ Saving LCIO event %d run %d%s ....", eventNumber, runNumber,
+        parameters ? " with the input event parameters" : "");
   e->setRunNumber(runNumber);
   e->setEventNumber(eventNumber);
   e->setDetectorName(context()->detectorDescription().header().name());
@@ -124,16 +124,10 @@ dd4hep::sim::LCIOFileReader::readParticleCollection(int /*event_number*/, EVENT:
       printout(INFO,"LCIOFileReader","read collection %s from event %d in run %d ", 
                m_collectionName.c_str(), evt->getEventNumber(), evt->getRunNumber());
       
-      // Create input event parameters context
-      try {
-        Geant4Context* ctx = context();
-        LCIOEventParameters *parameters = new LCIOEventParameters();
-        parameters->setParameters(evt->getRunNumber(), evt->getEventNumber(), evt->parameters());
-        ctx->event().addExtension<LCIOEventParameters>( parameters );        
-      }
-      catch(std::exception &) 
-      {
-      }
+      // Create input event parameters: attached to the event by the input action
+      LCIOEventParameters *parameters = new LCIOEventParameters();
+      parameters->setParameters(evt->getRunNumber(), evt->getEventNumber(), evt->parameters());
+      addEventExtension<LCIOEventParameters>( parameters );
       return EVENT_READER_OK;
     }
   }
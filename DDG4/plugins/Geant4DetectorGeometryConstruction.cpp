@@ -54,6 +54,8 @@ namespace dd4hep {
       /// Property: Flag to dump all sensitives after the conversion procedure
       bool m_printSensitives = false;
 
+      /// Property: Reuse the last volume ID while the touchable history is unchanged
+      bool m_cacheTouchables = true;
       /// Property: Printout level of info object
       int  m_geoInfoPrintLevel;
       /// Property: G4 GDML dump file name (default: empty. If non empty, dump)
@@ -126,6 +128,7 @@ Geant4DetectorGeometryConstruction::Geant4DetectorGeometryConstruction(Geant4Con
   declareProperty("PrintPlacements",   m_printPlacements);
   declareProperty("PrintSensitives",   m_printSensitives);
   declareProperty("GeoInfoPrintLevel", m_geoInfoPrintLevel = DEBUG);
+  declareProperty("CacheTouchables",   m_cacheTouchables);
 
   declareProperty("DumpHierarchy",     m_dumpHierarchy);
   declareProperty("DumpGDML",          m_dumpGDML="");
@@ -153,6 +156,7 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
 
   ctxt->geometry       = conv.create(world).detach();
   ctxt->geometry->printLevel = outputLevel();
+  ctxt->geometry->cacheTouchables = m_cacheTouchables;
   g4map.attach(ctxt->geometry);
   G4VPhysicalVolume* w = ctxt->geometry->world();
   // Save away the reference to the world volume
@@ -76,6 +76,7 @@ namespace dd4hep {
 #include "DDG4/Factories.h"
 #include "DD4hep/Printout.h"
 #include "DDG4/Geant4Primary.h"
+#include "Geant4HepMCHelpers.h"
 #include "CLHEP/Units/SystemOfUnits.h"
 #include "CLHEP/Units/PhysicalConstants.h"
 
@@ -180,7 +181,6 @@ namespace dd4hep {
       int read_heavy_ion(EventStream &, istringstream & input);
       int read_pdf(EventStream &, istringstream & input);
       Geant4Vertex* vertex(EventStream& info, int i);
-      void fix_particles(EventStream &info);
     }
   }
 }
@@ -290,66 +290,6 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
   return EVENT_READER_EOF;
 }
 
-void HepMC::fix_particles(EventStream& info)  {
-  EventStream::Particles& parts = info.particles();
-  EventStream::Vertices&  verts = info.vertices();
-  EventStream::Particles::iterator i;
-  std::set<int>::const_iterator id, ip;
-  for(i=parts.begin(); i != parts.end(); ++i)  {
-    Geant4ParticleHandle p((*i).second);
-    int end_vtx_id = p->secondaries;
-    p->secondaries = 0;
-    Geant4Vertex* v = vertex(info,end_vtx_id);
-#if defined(DD4HEP_DEBUG_HEP_MC_VERTEX)
-    if ( end_vtx_id == DD4HEP_DEBUG_HEP_MC_VERTEX )   {
-      cout << "End-vertex:" << end_vtx_id << endl;
-    }
-#endif
-    if ( v )   {
-      p->vex = v->x;
-      p->vey = v->y;
-      p->vez = v->z;
-      v->in.insert(p->id);
-      for(id=v->out.begin(); id!=v->out.end();++id)    {
-        EventStream::Particles::iterator ipp = parts.find(*id);
-        Geant4Particle* dau = ipp != parts.end() ? (*ipp).second : 0;
-        if ( !dau )
-          cout << "ERROR: Invalid daughter particle: " << *id << endl;
-        else
-          dau->parents.insert(p->id);
-        p->daughters.insert(*id);
-      }
-    }
-  }
-  for(const auto& iv : verts)   {
-    Geant4Vertex* v = iv.second;
-    for (int pout : v->out)   {
-      EventStream::Particles::iterator ipp = parts.find(pout);
-      Geant4Particle* p = (*ipp).second;
-      for (int d : v->in)   {
-        p->parents.insert(d);
-      }
-    }
-  }
-  /// Particles originating from the beam (=no parents) must be
-  /// be stripped off their parents and the status set to G4PARTICLE_GEN_DECAYED!
-  vector<Geant4Particle*> beam;
-  for(const auto& ipart : parts)   {
-    Geant4ParticleHandle p(ipart.second);
-    if ( p->parents.size() == 0 )  {
-      for(int d : p->daughters)   {
-        Geant4Particle *pp = parts[d];
-        beam.emplace_back(pp);
-      }
-    }
-  }
-  for(auto* ipp : beam)   {
-    //cout << "Clear parents of " << (*ipp)->id << endl;
-    ipp->parents.clear();
-    ipp->status = G4PARTICLE_GEN_DECAYED;
-  }
-}
-
 Geant4Vertex* HepMC::vertex(EventStream& info, int i)   {
   EventStream::Vertices::iterator it=info.vertices().find(i);
   return (it==info.vertices().end()) ? 0 : (*it).second;
@@ -822,7 +762,7 @@ bool HepMC::EventStream::read()   {
 
   if( not instream.good() ) return false;
  Done:
-  fix_particles(info);
+  fix_particles(info.particles(), info.vertices());
   detail::releaseObjects(vertices());
   return true;
 }
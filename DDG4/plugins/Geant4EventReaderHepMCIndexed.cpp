@@ -0,0 +1,599 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4InputAction.h"
+
+// C/C++ include files
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Class to populate Geant4 primaries from HepMC2 ASCII files with direct event access
+    /**
+     *  Reads the same files as Geant4EventReaderHepMC and creates the same
+     *  particles and vertices, but:
+     *  - the input file is memory mapped. Lines are tokenized in place
+     *    without stream objects and temporary strings.
+     *  - on first open the byte offsets of all events are collected in an index,
+     *    which gives direct access to any event (m_directAccess = true).
+     *    Skipping events with moveToEvent is hence free.
+     *  - optionally the index is saved next to the input file (<input>.idx) and
+     *    reused by later jobs if size and modification time of the input match.
+     *
+     *  Parameters:
+     *  - PersistIndex: if non-zero, read and write the index file (default: 0)
+     *  - IndexFile:    name of the index file (default: <input>.idx)
+     *
+     *  Only local files may be memory mapped.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4EventReaderHepMCIndexed : public Geant4EventReader  {
+    public:
+      /// Index entry of one event
+      struct Entry  {
+        /// Byte offset of the event line
+        std::uint64_t offset;
+        /// Byte offset of the end of the event
+        std::uint64_t end;
+        /// IO type of the listing and units valid for the event
+        std::uint8_t  io_type, mom_unit, pos_unit, spare[5];
+      };
+      /// Vertex lookup by HepMC barcode
+      typedef std::unordered_map<int,Geant4Vertex*> VertexMap;
+
+    protected:
+      /// Start of the mapped file
+      const char*        m_data  { nullptr };
+      /// Size of the mapped file
+      std::size_t        m_size  { 0 };
+      /// Modification time of the input file
+      long               m_mtime { 0 };
+      /// Event index
+      std::vector<Entry> m_index;
+      /// Parameter: save and reuse the index file
+      int                m_persist { 0 };
+      /// Parameter: name of the index file
+      std::string        m_indexFile;
+
+      /// Open and map the input file
+      void open();
+      /// Scan the mapped input and build the event index
+      void buildIndex();
+      /// Read the event index from file. Returns false if not present or stale
+      bool loadIndex();
+      /// Write the event index to file
+      void saveIndex()  const;
+      /// Parse one event
+      bool parseEvent(const Entry& entry, std::vector<Geant4Particle*>& particles, VertexMap& vertices);
+
+    public:
+      /// Initializing constructor
+      explicit Geant4EventReaderHepMCIndexed(const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4EventReaderHepMCIndexed();
+      /// Read an event and fill a vector of MCParticles.
+      virtual EventReaderStatus readParticles(int event_number,
+                                              Vertices& vertices,
+                                              std::vector<Particle*>& particles)  override;
+      /// Direct access: move to the indicated event number
+      virtual EventReaderStatus moveToEvent(int event_number)  override;
+      /// Direct access: skip event
+      virtual EventReaderStatus skipEvent() override;
+      /// Pass the parameters to the event reader object
+      virtual EventReaderStatus setParameters(std::map<std::string, std::string>& parameters) override;
+    };
+  }     /* End namespace sim   */
+}       /* End namespace dd4hep       */
+
+//====================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------
+//
+//====================================================================
+// #include "DDG4/Geant4EventReaderHepMCIndexed.h"
+
+// Framework include files
+#include "DDG4/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Primary.h"
+#include "Geant4HepMCHelpers.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "CLHEP/Units/PhysicalConstants.h"
+
+// C/C++ include files
+#include <set>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace CLHEP;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+typedef dd4hep::detail::ReferenceBitMask<int> PropertyMask;
+
+// Factory entry
+DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepMCIndexed)
+
+namespace {
+
+  /// The known_io enum is used to track which type of input is being read
+  enum known_io { gen=1, ascii, extascii, ascii_pdt, extascii_pdt };
+  /// Unit codes stored in the index
+  enum unit_code { UNIT_DEFAULT = 0, UNIT_KEV, UNIT_MEV, UNIT_GEV, UNIT_TEV, UNIT_MM, UNIT_CM, UNIT_M };
+  /// Magic word of the index file
+  const char INDEX_MAGIC[16] = "DD4hepHepMCIdx1";
+
+  /// Line tokenizer working directly on the mapped input
+  /*
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_SIMULATION
+   */
+  class Tokens  {
+  public:
+    const char* ptr;
+    const char* end;
+    bool        ok = true;
+
+    Tokens(const char* b, const char* e) : ptr(b), end(e) {}
+    /// Access the next blank separated token. Returns its length
+    size_t next(const char*& token)   {
+      while( ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r') ) ++ptr;
+      token = ptr;
+      while( ptr < end && *ptr != ' ' && *ptr != '\t' && *ptr != '\r' ) ++ptr;
+      size_t len = ptr - token;
+      if ( 0 == len ) ok = false;
+      return len;
+    }
+    /// Copy the next token to a null terminated buffer
+    bool next(char* buff, size_t buff_len)   {
+      const char* tok = 0;
+      size_t len = next(tok);
+      if ( 0 == len || len >= buff_len )   {
+        ok = false;
+        buff[0] = 0;
+        return false;
+      }
+      ::memcpy(buff, tok, len);
+      buff[len] = 0;
+      return true;
+    }
+    /// Parse the next token as integer number
+    long next_long()   {
+      char buff[64], *e = 0;
+      if ( !next(buff, sizeof(buff)) ) return 0;
+      long value = ::strtol(buff, &e, 10);
+      if ( e == buff ) ok = false;
+      return value;
+    }
+    /// Parse the next token as floating point number
+    double next_double()   {
+      char buff[64], *e = 0;
+      if ( !next(buff, sizeof(buff)) ) return 0e0;
+      double value = ::strtod(buff, &e);
+      if ( e == buff ) ok = false;
+      return value;
+    }
+    /// Check if the token is the next word of the line
+    bool next_is(const char* word)   {
+      const char* tok = 0;
+      size_t len = next(tok);
+      return len == ::strlen(word) && 0 == ::strncmp(tok, word, len);
+    }
+  };
+
+  /// Convert the unit word of a HepMC 'U' line to the unit code
+  uint8_t unit_code(const char* tok, size_t len)   {
+    string u(tok, len);
+    if ( u == "KEV" ) return UNIT_KEV;
+    if ( u == "MEV" ) return UNIT_MEV;
+    if ( u == "GEV" ) return UNIT_GEV;
+    if ( u == "TEV" ) return UNIT_TEV;
+    if ( u == "MM"  ) return UNIT_MM;
+    if ( u == "CM"  ) return UNIT_CM;
+    if ( u == "M"   ) return UNIT_M;
+    return UNIT_DEFAULT;
+  }
+
+  /// Convert the unit code to the CLHEP unit value
+  double unit_value(uint8_t code, double default_value)   {
+    switch(code)  {
+    case UNIT_KEV: return keV;
+    case UNIT_MEV: return MeV;
+    case UNIT_GEV: return GeV;
+    case UNIT_TEV: return TeV;
+    case UNIT_MM:  return mm;
+    case UNIT_CM:  return cm;
+    case UNIT_M:   return m;
+    default:       return default_value;
+    }
+  }
+}
+
+/// Initializing constructor
+Geant4EventReaderHepMCIndexed::Geant4EventReaderHepMCIndexed(const string& nam)
+  : Geant4EventReader(nam)
+{
+  m_directAccess = true;
+  open();
+}
+
+/// Default destructor
+Geant4EventReaderHepMCIndexed::~Geant4EventReaderHepMCIndexed()    {
+  if ( m_data ) ::munmap((void*)m_data, m_size);
+  m_data = 0;
+}
+
+/// Open and map the input file
+void Geant4EventReaderHepMCIndexed::open()   {
+  struct stat info;
+  int fd = ::open(m_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &info) != 0 )   {
+    if ( fd >= 0 ) ::close(fd);
+    except("Geant4EventReaderHepMCIndexed","+++ Failed to open input file: %s Error:%s.",
+           m_name.c_str(), ::strerror(errno));
+  }
+  m_size  = info.st_size;
+  m_mtime = info.st_mtime;
+  if ( m_size > 0 )   {
+    void* ptr = ::mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( ptr == MAP_FAILED )   {
+      ::close(fd);
+      except("Geant4EventReaderHepMCIndexed","+++ Failed to map input file: %s Error:%s.",
+             m_name.c_str(), ::strerror(errno));
+    }
+    m_data = (const char*)ptr;
+  }
+  ::close(fd);
+}
+
+/// Pass the parameters to the event reader object
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMCIndexed::setParameters(map<string, string>& parameters)   {
+  _getParameterValue(parameters, "PersistIndex", m_persist, 0);
+  _getParameterValue(parameters, "IndexFile",    m_indexFile, m_name + ".idx");
+  return EVENT_READER_OK;
+}
+
+/// Scan the mapped input and build the event index
+void Geant4EventReaderHepMCIndexed::buildIndex()   {
+  const char* beg = m_data;
+  const char* end = m_data + m_size;
+  uint8_t io_type = 0, mom_unit = UNIT_DEFAULT, pos_unit = UNIT_DEFAULT;
+  m_index.clear();
+  for( const char* line = beg; line < end; )   {
+    const char* eol = (const char*)::memchr(line, '\n', end - line);
+    if ( !eol ) eol = end;
+    switch( *line )  {
+    case 'E':
+      if ( line+1 < eol && (line[1] == ' ' || line[1] == '\t') )   {
+        if ( !m_index.empty() && m_index.back().end == 0 )
+          m_index.back().end = line - beg;
+        Entry e;
+        ::memset(&e, 0, sizeof(e));
+        e.offset   = line - beg;
+        e.io_type  = io_type;
+        e.mom_unit = mom_unit;
+        e.pos_unit = pos_unit;
+        m_index.emplace_back(e);
+      }
+      break;
+    case 'U':
+      if ( io_type == gen && !m_index.empty() )   {
+        // Units stay valid for the following events like in a sequential read
+        const char* tok = 0;
+        Tokens toks(line+1, eol);
+        size_t len = toks.next(tok);
+        mom_unit = m_index.back().mom_unit = unit_code(tok, len);
+        len = toks.next(tok);
+        pos_unit = m_index.back().pos_unit = unit_code(tok, len);
+      }
+      break;
+    case 'H':   {
+      Tokens toks(line, eol);
+      const char* tok = 0;
+      string key(tok, toks.next(tok));
+      if ( key.find("-END_EVENT_LISTING") != string::npos )   {
+        if ( !m_index.empty() && m_index.back().end == 0 )
+          m_index.back().end = line - beg;
+      }
+      else if ( key == "HepMC::IO_GenEvent-START_EVENT_LISTING" )
+        io_type = gen;
+      else if ( key == "HepMC::IO_Ascii-START_EVENT_LISTING" )
+        io_type = ascii;
+      else if ( key == "HepMC::IO_ExtendedAscii-START_EVENT_LISTING" )
+        io_type = extascii;
+      break;
+    }
+    default:
+      break;
+    }
+    line = eol + 1;
+  }
+  if ( !m_index.empty() && m_index.back().end == 0 )
+    m_index.back().end = m_size;
+}
+
+/// Read the event index from file. Returns false if not present or stale
+bool Geant4EventReaderHepMCIndexed::loadIndex()   {
+  char magic[16];
+  uint64_t hdr[3] = {0, 0, 0};
+  FILE* f = ::fopen(m_indexFile.c_str(), "rb");
+  if ( !f ) return false;
+  bool ok = ::fread(magic, sizeof(magic), 1, f) == 1 && 0 == ::memcmp(magic, INDEX_MAGIC, sizeof(magic));
+  ok = ok && ::fread(hdr, sizeof(hdr), 1, f) == 1;
+  ok = ok && hdr[0] == uint64_t(m_size) && hdr[1] == uint64_t(m_mtime);
+  if ( ok )   {
+    m_index.resize(hdr[2]);
+    ok = hdr[2] == 0 || ::fread(&m_index[0], sizeof(Entry), hdr[2], f) == hdr[2];
+  }
+  ::fclose(f);
+  if ( !ok ) m_index.clear();
+  return ok;
+}
+
+/// Write the event index to file
+void Geant4EventReaderHepMCIndexed::saveIndex()  const   {
+  uint64_t hdr[3] = { uint64_t(m_size), uint64_t(m_mtime), uint64_t(m_index.size()) };
+  string tmp = m_indexFile + ".tmp";
+  FILE* f = ::fopen(tmp.c_str(), "wb");
+  bool ok = f != 0;
+  ok = ok && ::fwrite(INDEX_MAGIC, sizeof(INDEX_MAGIC), 1, f) == 1;
+  ok = ok && ::fwrite(hdr, sizeof(hdr), 1, f) == 1;
+  ok = ok && (m_index.empty() || ::fwrite(&m_index[0], sizeof(Entry), m_index.size(), f) == m_index.size());
+  if ( f ) ok = (0 == ::fclose(f)) && ok;
+  // Atomic replacement: concurrent jobs never see a partial index
+  if ( ok && 0 == ::rename(tmp.c_str(), m_indexFile.c_str()) )   {
+    printout(INFO,"EventReaderHepMC","+++ Saved index of %ld events to %s",
+             m_index.size(), m_indexFile.c_str());
+    return;
+  }
+  ::unlink(tmp.c_str());
+  printout(WARNING,"EventReaderHepMC","+++ Failed to save event index to %s. Error:%s",
+           m_indexFile.c_str(), ::strerror(errno));
+}
+
+/// Direct access: move to the indicated event number
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMCIndexed::moveToEvent(int event_number) {
+  if ( m_index.empty() && m_size > 0 )   {
+    if ( m_indexFile.empty() ) m_indexFile = m_name + ".idx";
+    if ( !(m_persist && loadIndex()) )   {
+      buildIndex();
+      if ( m_persist ) saveIndex();
+    }
+    printout(INFO,"EventReaderHepMC","+++ Indexed %ld events of %s",
+             m_index.size(), m_name.c_str());
+  }
+  if ( event_number < 0 || size_t(event_number) >= m_index.size() )   {
+    return EVENT_READER_EOF;
+  }
+  m_currEvent = event_number;
+  printout(DEBUG,"EventReaderHepMC::moveToEvent","Current event number: %d",m_currEvent);
+  return EVENT_READER_OK;
+}
+
+/// Direct access: skip event
+Geant4EventReader::EventReaderStatus Geant4EventReaderHepMCIndexed::skipEvent()   {
+  ++m_currEvent;
+  return EVENT_READER_OK;
+}
+
+/// Parse one event
+bool Geant4EventReaderHepMCIndexed::parseEvent(const Entry& entry, vector<Geant4Particle*>& parts, VertexMap& verts)  {
+  const char* end  = m_data + entry.end;
+  double mom_unit  = unit_value(entry.mom_unit, MeV);
+  double pos_unit  = unit_value(entry.pos_unit, mm);
+  int    io_type   = entry.io_type;
+  int    event_id  = 0;
+  Geant4Vertex* v  = 0;
+  int num_orphans_in = 0;
+
+  for( const char* line = m_data + entry.offset; line < end; )   {
+    const char* eol = (const char*)::memchr(line, '\n', end - line);
+    if ( !eol ) eol = end;
+    Tokens input(line+1, eol);
+    char value = *line;
+    line = eol + 1;
+    switch( value )   {
+    case 'E':
+      event_id = int(input.next_long());
+      break;
+
+    case 'U':
+      if ( io_type == gen )   {
+        const char* tok = 0;
+        size_t len = input.next(tok);
+        mom_unit = unit_value(unit_code(tok, len), mom_unit);
+        len = input.next(tok);
+        pos_unit = unit_value(unit_code(tok, len), pos_unit);
+      }
+      break;
+
+    case 'V':   {
+      int id = int(input.next_long());
+      input.next_long();
+      v = new Geant4Vertex();
+      v->x = input.next_double() * pos_unit;
+      v->y = input.next_double() * pos_unit;
+      v->z = input.next_double() * pos_unit;
+      v->time = input.next_double();
+      num_orphans_in = int(input.next_long());
+      input.next_long();      // number of outgoing particles
+      if ( !input.ok )   {
+        delete v;
+        v = 0;
+        goto Skip;
+      }
+      verts.emplace(id, v);
+      break;
+    }
+
+    case 'P':   {
+      if ( !v )   {
+        printout(ERROR,"HepMC","streaming input: found unexpected Particle line.");
+        break;
+      }
+      Geant4Particle* p = new Geant4Particle();
+      PropertyMask status(p->status);
+      float ene = 0.;
+      int   size = 0, stat=0;
+      input.next_long();      // HepMC barcode: particles are numbered sequentially
+      p->id    = parts.size();
+      p->pdgID = int(input.next_long());
+      p->psx   = input.next_double() * mom_unit;
+      p->psy   = input.next_double() * mom_unit;
+      p->psz   = input.next_double() * mom_unit;
+      ene      = float(input.next_double());
+      ene     *= mom_unit;
+      if ( io_type != ascii )   {
+        p->mass = input.next_double() * mom_unit;
+      }
+      else   {
+        p->mass = std::sqrt(fabs(ene*ene - (p->psx*p->psx + p->psy*p->psy + p->psz*p->psz)));
+      }
+      // Reuse here the secondaries to store the end-vertex ID
+      stat           = int(input.next_long());
+      input.next_double();    // Polarization theta: not used
+      input.next_double();    // Polarization phi:   not used
+      p->secondaries = int(input.next_long());
+      size           = int(input.next_long());
+      for( int i = 0; i < size && input.ok; ++i )   {
+        p->colorFlow[0] = int(input.next_long());
+        p->colorFlow[1] = int(input.next_long());
+      }
+      if ( !input.ok )   {
+        printout(ERROR,"HepMC","++ Vertex Failed to read daughter particle!");
+        delete p;
+        goto Skip;
+      }
+      //
+      //  Generator status
+      //  Simulator status 0 until simulator acts on it
+      status.clear();
+      if ( stat == 0 )        status.set(G4PARTICLE_GEN_EMPTY);
+      else if ( stat == 0x1 ) status.set(G4PARTICLE_GEN_STABLE);
+      else if ( stat == 0x2 ) status.set(G4PARTICLE_GEN_DECAYED);
+      else if ( stat == 0x3 ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      else if ( stat == 0x4 ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      else if ( stat == 0xB ) status.set(G4PARTICLE_GEN_DOCUMENTATION);
+      else                    status.set(G4PARTICLE_GEN_OTHER);
+      /// If there is an end vertex, the particle already decayed
+      if ( p->secondaries != 0 )  {
+        status.set(G4PARTICLE_GEN_DECAYED);
+      }
+      /// Keep a copy of the full generator status
+      p->genStatus = stat&G4PARTICLE_GEN_STATUS_MASK;
+      p->pex = p->psx;
+      p->pey = p->psy;
+      p->pez = p->psz;
+      parts.emplace_back(p);
+      if ( --num_orphans_in >= 0 )   {
+        v->in.insert(p->id);
+        p->vex = v->x;
+        p->vey = v->y;
+        p->vez = v->z;
+      }
+      else   {
+        v->out.insert(p->id);
+        p->vsx = v->x;
+        p->vsy = v->y;
+        p->vsz = v->z;
+      }
+      continue;
+    }
+
+    default:            // ignore everything else
+      break;
+    }
+    v = value == 'V' ? v : 0;
+    continue;
+  Skip:
+    printout(WARNING,"HepMC::EventStream","+++ Skip event with ID: %d",event_id);
+    return false;
+  }
+  HepMC::fix_particles(parts, verts);
+  return true;
+}
+
+/// Read an event and fill a vector of MCParticles.
+Geant4EventReaderHepMCIndexed::EventReaderStatus
+Geant4EventReaderHepMCIndexed::readParticles(int /* ev_id */,
+                                             Vertices&  vertices,
+                                             Particles& output) {
+  if ( m_index.empty() || m_currEvent < 0 || size_t(m_currEvent) >= m_index.size() )  {
+    if ( EVENT_READER_OK != moveToEvent(m_currEvent) )   {
+      vertices.clear();
+      output.clear();
+      return EVENT_READER_EOF;
+    }
+  }
+  //fg: for now we create exactly one event vertex here ( as before )
+  //    this needs revisiting as HepMC allows to have more than one vertex ...
+  Geant4Vertex* primary_vertex = new Geant4Vertex ;
+  vertices.emplace_back( primary_vertex );
+  primary_vertex->x = 0;
+  primary_vertex->y = 0;
+  primary_vertex->z = 0;
+
+  VertexMap verts;
+  while( size_t(m_currEvent) < m_index.size() )   {
+    bool ok = parseEvent(m_index[m_currEvent], output, verts);
+    detail::releaseObjects(verts);
+    ++m_currEvent;
+    if ( ok ) break;
+    for( Geant4Particle* p : output ) p->release();
+    output.clear();
+  }
+  if ( output.empty() && size_t(m_currEvent) >= m_index.size() )   {
+    vertices.clear();
+    delete primary_vertex;
+    return EVENT_READER_EOF;
+  }
+  for( Geant4Particle* part : output )  {
+    Geant4ParticleHandle p(part);
+    printout(VERBOSE,m_name,
+             "+++ %s ID:%3d status:%08X typ:%9d Mom:(%+.2e,%+.2e,%+.2e)[MeV] "
+             "time: %+.2e [ns] #Dau:%3d #Par:%1d",
+             "",p->id,p->status,p->pdgID,
+             p->psx/MeV,p->psy/MeV,p->psz/MeV,p->time/ns,
+             p->daughters.size(),
+             p->parents.size());
+    //add particles to the 'primary vertex'
+    if ( p->parents.size() == 0 )  {
+      PropertyMask status(p->status);
+      if ( status.isSet(G4PARTICLE_GEN_EMPTY) || status.isSet(G4PARTICLE_GEN_DOCUMENTATION) )
+        primary_vertex->in.insert(p->id);  // Beam particles and primary quarks etc.
+      else
+        primary_vertex->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
+    }
+  }
+  return EVENT_READER_OK;
+}
@@ -0,0 +1,119 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4HEPMCHELPERS_H
+#define DD4HEP_DDG4_GEANT4HEPMCHELPERS_H
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Primary.h"
+
+// C/C++ include files
+#include <map>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// HepMC namespace declaration
+    namespace HepMC {
+
+      /// Access particle by identifier. Returns null if not present
+      inline Geant4Particle* particle(std::map<int,Geant4Particle*>& parts, int id)  {
+        auto i = parts.find(id);
+        return i == parts.end() ? 0 : i->second;
+      }
+      /// Access particle by identifier. Returns null if not present
+      inline Geant4Particle* particle(std::vector<Geant4Particle*>& parts, int id)  {
+        return id >= 0 && size_t(id) < parts.size() ? parts[id] : 0;
+      }
+      /// Access particle of a container entry
+      inline Geant4Particle* particle(const std::pair<const int,Geant4Particle*>& entry)  {
+        return entry.second;
+      }
+      /// Access particle of a container entry
+      inline Geant4Particle* particle(Geant4Particle* entry)  {
+        return entry;
+      }
+
+      /// Attach the particles of one HepMC event to their vertices and fix the beam particles
+      /**
+       *  Used by the event readers Geant4EventReaderHepMC and Geant4EventReaderHepMCIndexed.
+       *  On entry the member 'secondaries' of each particle holds the barcode of its
+       *  end vertex. The particle identifiers are the index in the event.
+       *
+       *  \author  P.Kostka (main author)
+       *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      template <typename PARTICLES, typename VERTICES>
+      void fix_particles(PARTICLES& parts, VERTICES& verts)  {
+        for( auto& entry : parts )  {
+          Geant4ParticleHandle p(particle(entry));
+          int end_vtx_id = p->secondaries;
+          p->secondaries = 0;
+          auto iv = verts.find(end_vtx_id);
+          Geant4Vertex* v = iv == verts.end() ? 0 : iv->second;
+#if defined(DD4HEP_DEBUG_HEP_MC_VERTEX)
+          if ( end_vtx_id == DD4HEP_DEBUG_HEP_MC_VERTEX )   {
+            printout(ALWAYS,"HepMC","End-vertex: %d", end_vtx_id);
+          }
+#endif
+          if ( v )   {
+            p->vex = v->x;
+            p->vey = v->y;
+            p->vez = v->z;
+            v->in.insert(p->id);
+            for( int id : v->out )    {
+              Geant4Particle* dau = particle(parts, id);
+              if ( !dau )
+                printout(ERROR,"HepMC","Invalid daughter particle: %d", id);
+              else
+                dau->parents.insert(p->id);
+              p->daughters.insert(id);
+            }
+          }
+        }
+        for( const auto& iv : verts )   {
+          Geant4Vertex* v = iv.second;
+          for( int pout : v->out )   {
+            Geant4Particle* p = particle(parts, pout);
+            if ( !p ) continue;
+            for( int d : v->in )
+              p->parents.insert(d);
+          }
+        }
+        /// Particles originating from the beam (=no parents) must be
+        /// be stripped off their parents and the status set to G4PARTICLE_GEN_DECAYED!
+        std::vector<Geant4Particle*> beam;
+        for( auto& entry : parts )   {
+          Geant4Particle* p = particle(entry);
+          if ( p->parents.size() == 0 )  {
+            for( int d : p->daughters )  {
+              Geant4Particle* dau = particle(parts, d);
+              if ( dau ) beam.emplace_back(dau);
+            }
+          }
+        }
+        for( auto* ipp : beam )   {
+          ipp->parents.clear();
+          ipp->status = G4PARTICLE_GEN_DECAYED;
+        }
+      }
+    }
+  }     /* End namespace sim   */
+}       /* End namespace dd4hep       */
+#endif  /* DD4HEP_DDG4_GEANT4HEPMCHELPERS_H */
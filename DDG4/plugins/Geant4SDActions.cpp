@@ -158,9 +158,8 @@ namespace dd4hep {
         Geant4TouchableHandler handler(step);
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
-        hit = new Hit(global);
+        hit = coll->createByKey<Hit>(cell, global);
         hit->cellID = cell;
-        coll->add(cell, hit);
         printM2("%s> CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s  [%s]",
                 c_name(),contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str(),
                 coll->GetName().c_str());
@@ -217,11 +216,11 @@ namespace dd4hep {
         Geant4HitCollection*  coll    = collection(m_collectionID);
         HitContribution contrib = Hit::extractContribution(step);
         Position        pos     = h.prePos();
-        Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
+        PositionHashCompare<Hit,Position> cmp(pos);
+        Hit* hit = coll->findByHash<Hit>(cmp);
         if ( !hit ) {
-          hit = new Hit(pos);
+          hit = coll->createByHash<Hit>(cmp, pos);
           hit->cellID = volumeID(step);
-          coll->add(hit);
           if ( 0 == hit->cellID )  {
             hit->cellID = volumeID(step);
             except("+++ Invalid CELL ID for hit!");
@@ -293,9 +292,8 @@ namespace dd4hep {
         Geant4TouchableHandler handler(step);
         DDSegmentation::Vector3D pos = m_segmentation.position(cell);
         Position global = h.localToGlobal(pos);
-        hit = new Hit(global);
+        hit = coll->createByKey<Hit>(cell, global);
         hit->cellID = cell;
-        coll->add(cell, hit);
         printM2("CREATE hit with deposit:%e MeV  Pos:%8.2f %8.2f %8.2f  %s",
                 contrib.deposit,pos.X,pos.Y,pos.Z,handler.path().c_str());
         if ( 0 == hit->cellID )  { // for debugging only!
@@ -0,0 +1,180 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H
+#define DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H
+
+// Framework include files
+#include "DDG4/Geant4SteppingAction.h"
+#include "DDG4/Geant4VolumeManager.h"
+
+// C/C++ include files
+#include <set>
+
+// Forward declarations
+class G4StepPoint;
+class G4VTouchable;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim   {
+
+    /// Class to check the placement lookups of the Geant4VolumeManager during the simulation
+    /**
+     *  For every step point inside the world volume the volume identifier is
+     *  determined three times:
+     *  - from the step point, which reuses the result of the last touchable handle,
+     *  - from the touchable, which uses the hash index of the placement paths,
+     *  - by a linear search of the placement path in the path map.
+     *  All three must agree. The result is printed at the end of the run.
+     *
+     *  The linear search is slow: the action is meant for tests with small geometries.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4VolumeManagerCheck : public Geant4SteppingAction  {
+    protected:
+      /// Property: maximal number of printed mismatches
+      long m_maxPrint = 10;
+      /// Number of checked step points
+      long m_numChecked = 0;
+      /// Number of step points with the same touchable as the previous one
+      long m_numRepeated = 0;
+      /// Number of mismatched lookups
+      long m_numBad = 0;
+      /// Touchable of the previously checked step point
+      const G4VTouchable* m_lastTouchable = 0;
+      /// Volume identifiers of all sensitive volumes seen
+      std::set<VolumeID> m_volumes;
+
+      /// Reference lookup: linear search of the placement path
+      VolumeID linearVolumeID(const Geant4VolumeManager& mgr, const G4VTouchable* touchable)  const;
+      /// Check the lookups of one step point
+      void check(const Geant4VolumeManager& mgr, const G4StepPoint* point);
+
+    public:
+      /// Standard constructor
+      Geant4VolumeManagerCheck(Geant4Context* context, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4VolumeManagerCheck();
+      /// User stepping callback
+      virtual void operator()(const G4Step* step, G4SteppingManager* mgr)  override;
+      /// End-of-run callback: print the check summary
+      void endRun(const G4Run* run);
+    };
+  }
+}
+#endif /* DD4HEP_DDG4_GEANT4VOLUMEMANAGERCHECK_H */
+
+//====================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------
+//
+//  Author     : M.Frank
+//
+//====================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4TouchableHandler.h"
+#include "DDG4/Geant4GeometryInfo.h"
+#include "DDG4/Geant4RunAction.h"
+#include "DDG4/Geant4Mapping.h"
+
+// Geant4 include files
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4VTouchable.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4VolumeManagerCheck)
+
+/// Standard constructor
+Geant4VolumeManagerCheck::Geant4VolumeManagerCheck(Geant4Context* ctxt, const string& nam)
+  : Geant4SteppingAction(ctxt,nam)
+{
+  declareProperty("MaxPrint", m_maxPrint);
+  runAction().callAtEnd(this,&Geant4VolumeManagerCheck::endRun);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4VolumeManagerCheck::~Geant4VolumeManagerCheck() {
+  InstanceCount::decrement(this);
+}
+
+/// Reference lookup: linear search of the placement path
+VolumeID
+Geant4VolumeManagerCheck::linearVolumeID(const Geant4VolumeManager& mgr, const G4VTouchable* touchable)  const  {
+  Geant4TouchableHandler handler(touchable);
+  Geant4GeometryInfo::Geant4PlacementPath path = handler.placementPath();
+  for( const auto& entry : mgr.ptr()->g4Paths )  {
+    if ( entry.first == path ) return entry.second;
+  }
+  if ( !path[0] )
+    return Geant4VolumeManager::InvalidPath;
+  else if ( !path[0]->GetLogicalVolume()->GetSensitiveDetector() )
+    return Geant4VolumeManager::Insensitive;
+  return Geant4VolumeManager::NonExisting;
+}
+
+/// Check the lookups of one step point
+void Geant4VolumeManagerCheck::check(const Geant4VolumeManager& mgr, const G4StepPoint* point)  {
+  const G4VTouchable* touchable = point->GetTouchableHandle()();
+  if ( !touchable || !touchable->GetVolume() || touchable->GetHistoryDepth() == 0 )  {
+    return;  // Outside the world volume
+  }
+  VolumeID cached = mgr.volumeID(point);
+  VolumeID hashed = mgr.volumeID(touchable);
+  VolumeID linear = linearVolumeID(mgr, touchable);
+  ++m_numChecked;
+  if ( touchable == m_lastTouchable ) ++m_numRepeated;
+  m_lastTouchable = touchable;
+  if ( linear != Geant4VolumeManager::Insensitive &&
+       linear != Geant4VolumeManager::InvalidPath &&
+       linear != Geant4VolumeManager::NonExisting )  {
+    m_volumes.insert(linear);
+  }
+  if ( cached != linear || hashed != linear )  {
+    if ( ++m_numBad <= m_maxPrint )  {
+      Geant4TouchableHandler handler(touchable);
+      error("+++ Lookup mismatch: cached:%016llX hashed:%016llX linear:%016llX path:%s",
+            (unsigned long long)cached, (unsigned long long)hashed, (unsigned long long)linear,
+            handler.path().c_str());
+    }
+  }
+}
+
+/// User stepping callback
+void Geant4VolumeManagerCheck::operator()(const G4Step* step, G4SteppingManager*) {
+  Geant4VolumeManager mgr = Geant4Mapping::instance().volumeManager();
+  check(mgr, step->GetPreStepPoint());
+  check(mgr, step->GetPostStepPoint());
+}
+
+/// End-of-run callback: print the check summary
+void Geant4VolumeManagerCheck::endRun(const G4Run* /* run */)   {
+  printout(m_numBad ? ERROR : ALWAYS, name(),
+           "+++ Checked %ld step points (%ld with repeated touchable) in %ld sensitive volumes. %ld lookups are BAD.",
+           m_numChecked, m_numRepeated, long(m_volumes.size()), m_numBad);
+}
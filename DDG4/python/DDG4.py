@@ -683,13 +683,18 @@ class Geant4:
       self.kernel().generatorAction().add(gun)
     return gun
 
-  def setupROOTOutput(self, name, output, mc_truth=True):
+  def setupROOTOutput(self, name, output, mc_truth=True, merge=False):
     """
     Configure ROOT output for the simulated events
 
+    If merge is set, the output action is not shared between worker threads:
+    every worker fills its own memory buffers, which are merged into the output file.
+    To be called from the worker setup in multi-threaded mode.
+
     \author  M.Frank
     """
-    evt_root = EventAction(self.kernel(), 'Geant4Output2ROOT/' + name, True)
+    evt_root = EventAction(self.kernel(), 'Geant4Output2ROOT/' + name, not merge)
+    evt_root.MergeOutput = merge
     evt_root.HandleMCTruth = mc_truth
     evt_root.Control = True
     if not output.endswith('.root'):
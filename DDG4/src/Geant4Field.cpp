@@ -19,18 +19,19 @@ namespace units = dd4hep;
 
 using namespace dd4hep::sim;
 
+/// Constructor. The sensitive detector element is identified by the detector name
+Geant4Field::Geant4Field(OverlayedField field)
+  : m_field(field),
+    // Convert positions from CLHEP units to tgeo units and the field from tgeo units to CLHEP units
+    m_evaluator(field.evaluator(CartesianField::MAGNETIC, units::mm/CLHEP::mm, CLHEP::tesla/units::tesla))
+{
+}
+
 G4bool Geant4Field::DoesFieldChangeEnergy() const {
   return m_field.changesEnergy();
 }
 
 void Geant4Field::GetFieldValue(const double pos[4], double *field) const {
-  static const double fac1 = units::mm/CLHEP::mm;
-  static const double fac2 = CLHEP::tesla/units::tesla;
-  double p[3] = {pos[0]*fac1, pos[1]*fac1, pos[2]*fac1}; // Convert from CLHEP units to tgeo units
-  field[0] = field[1] = field[2] = 0.0;                  // Reset field vector
-  m_field.magneticField(p, field);
-  field[0] *= fac2;                                      // Convert from tgeo units to CLHEP units
-  field[1] *= fac2;
-  field[2] *= fac2;
-  //::printf("Pos: %7.4f %7.4f %7.4f --> %9g %9g %9g\n",p[0],p[1],p[2],field[0],field[1],field[2]);
+  m_evaluator(pos, field);
+  //::printf("Pos: %7.4f %7.4f %7.4f --> %9g %9g %9g\n",pos[0],pos[1],pos[2],field[0],field[1],field[2]);
 }
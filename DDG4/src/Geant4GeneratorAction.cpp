@@ -14,6 +14,7 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4GeneratorAction.h"
+#include "DDG4/Geant4InputAction.h"
 #include "DDG4/Geant4Kernel.h"
 // Geant4 headers
 #include "G4Threading.hh"
@@ -62,6 +63,7 @@ void Geant4SharedGeneratorAction::use(Geant4GeneratorAction* action)   {
   if (action) {
     action->addRef();
     m_action = action;
+    m_input  = dynamic_cast<Geant4InputAction*>(action);
     return;
   }
   throw runtime_error("Geant4SharedGeneratorAction: Attempt to use invalid actor!");
@@ -69,7 +71,10 @@ void Geant4SharedGeneratorAction::use(Geant4GeneratorAction* action)   {
 
 /// User generator callback
 void Geant4SharedGeneratorAction::operator()(G4Event* event)  {
-  if ( m_action )  {
+  if ( m_input && m_input->isPrefetching() )  {
+    m_input->generate(context(), event);
+  }
+  else if ( m_action )  {
     G4AutoLock protection_lock(&action_mutex);    {
       ContextSwap swap(m_action,context());
       (*m_action)(event);
@@ -63,3 +63,20 @@ void Geant4GeometryInfo::setWorld(const TGeoNode* node)    {
   }
   m_world = g4;
 }
+
+/// Hash of a Geant4 volume path (incrementally combined placement pointers)
+unsigned long long Geant4GeometryInfo::placementPathHash(const Geant4PlacementPath& path)   {
+  unsigned long long hash = placementPathHashSeed;
+  for( const auto* pv : path )
+    hash = placementPathHash(hash, pv);
+  return hash;
+}
+
+/// Register a volume path in the hash index
+void Geant4GeometryInfo::indexPlacementPath(const std::pair<const Geant4PlacementPath, VolumeID>& entry)   {
+  auto ret = g4PathIndex.emplace(placementPathHash(entry.first), &entry);
+  if ( !ret.second && ret.first->second != &entry )   {
+    /// Hash collision: lookups with this hash must use the path map
+    ret.first->second = nullptr;
+  }
+}
@@ -22,12 +22,82 @@ using namespace dd4hep::sim;
 
 G4ThreadLocal G4Allocator<Geant4HitWrapper>* HitWrapperAllocator = 0;
 
+constexpr size_t Geant4HitIndex::npos;
+constexpr size_t Geant4HitArena::BLOCK_SIZE;
+
+namespace {
+  /// Thread local pool of released arena blocks of standard size
+  struct ArenaBlockPool  {
+    std::vector<char*> blocks;
+    ~ArenaBlockPool()  {
+      for( char* b : blocks ) ::operator delete(b);
+    }
+  };
+  thread_local ArenaBlockPool s_arenaBlocks;
+}
+
+/// Attach new memory block large enough for 'len' bytes
+void Geant4HitArena::newBlock(size_t len)   {
+  size_t siz = len > BLOCK_SIZE ? len : BLOCK_SIZE;
+  char*  blk = 0;
+  if ( siz == BLOCK_SIZE && !s_arenaBlocks.blocks.empty() )  {
+    blk = s_arenaBlocks.blocks.back();
+    s_arenaBlocks.blocks.pop_back();
+  }
+  else  {
+    blk = (char*)::operator new(siz);
+  }
+  m_blocks.emplace_back(blk, siz);
+  m_current = blk;
+  m_left    = siz;
+}
+
+/// Release all memory blocks. The objects must be destructed beforehand
+void Geant4HitArena::reset()   {
+  for( const auto& b : m_blocks )  {
+    if ( b.second == BLOCK_SIZE )
+      s_arenaBlocks.blocks.emplace_back(b.first);
+    else
+      ::operator delete(b.first);
+  }
+  m_blocks.clear();
+  m_current = 0;
+  m_left    = 0;
+}
+
+/// Default destructor. Returns all blocks to the pool
+Geant4HitArena::~Geant4HitArena()   {
+  reset();
+}
+
+/// Remove all entries. The allocated table is kept
+void Geant4HitIndex::clear()   {
+  if ( m_size )  {
+    for( auto& s : m_slots ) s.index = npos;
+    m_size = 0;
+  }
+}
+
+/// Resize the table and re-insert all entries
+void Geant4HitIndex::rehash(size_t new_size)   {
+  std::vector<Slot> slots(new_size, Slot{0, npos});
+  size_t mask = new_size-1;
+  for( const auto& s : m_slots )  {
+    if ( s.index != npos )  {
+      size_t i = hash(s.key)&mask;
+      while( slots[i].index != npos ) i = (i+1)&mask;
+      slots[i] = s;
+    }
+  }
+  m_slots.swap(slots);
+}
+
 Geant4HitWrapper::InvalidHit::~InvalidHit() {
 }
 
 /// Initializing Constructor
-Geant4HitWrapper::HitManipulator::HitManipulator(const ComponentCast& c, const ComponentCast& v)
-  : cast(c), vec_type(v) {
+Geant4HitWrapper::HitManipulator::HitManipulator(const ComponentCast& c, const ComponentCast& v, void (*d)(void*))
+  : cast(c), vec_type(v), destruct(d) {
   InstanceCount::increment(this);
 }
 
@@ -39,7 +109,10 @@ Geant4HitWrapper::HitManipulator::~HitManipulator() {
 /// Default destructor
 Geant4HitWrapper::~Geant4HitWrapper() {
   if (m_data.first && m_data.second) {
-    (*m_data.second->cast.destroy)(m_data.first);
+    if ( m_data.second->destruct )
+      (*m_data.second->destruct)(m_data.first);
+    else
+      (*m_data.second->cast.destroy)(m_data.first);
     m_data.first = 0;
   }
 }
@@ -77,10 +150,17 @@ Geant4HitWrapper::Wrapper Geant4HitWrapper::releaseData() {
 Geant4HitCollection::Compare::~Compare()  {
 }
 
+/// Default destructor
+Geant4HitCollection::HashCompare::~HashCompare()  {
+}
+
 /// Default destructor
 Geant4HitCollection::~Geant4HitCollection() {
   m_hits.clear();
   m_keys.clear();
+  m_index.clear();
+  m_hashes.clear();
+  m_arena.reset();
   InstanceCount::decrement(this);
 }
 
@@ -104,6 +184,37 @@ void Geant4HitCollection::clear()   {
   m_lastHit = ULONG_MAX;
   m_hits.clear();
   m_keys.clear();
+  m_index.clear();
+  m_hashes.clear();
+  m_arena.reset();
+}
+
+/// Register hit key. Throws exception if the key is already present
+void Geant4HitCollection::insertKey(VolumeID key, size_t which)   {
+  if ( m_flags.bits.flatLookup )  {
+    if ( m_index.insert(key, which) ) return;
+  }
+  else if ( m_keys.emplace(key, which).second )  {
+    return;
+  }
+  throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
+}
+
+/// Check that the hit key is not yet present. Throws exception otherwise
+void Geant4HitCollection::checkKey(VolumeID key)  const   {
+  bool present = m_flags.bits.flatLookup
+    ? m_index.find(key) != Geant4HitIndex::npos
+    : m_keys.find(key) != m_keys.end();
+  if ( present )  {
+    throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
+  }
+}
+
+/// Check if hits may be released. Throws exception for arena allocated hits
+void Geant4HitCollection::checkRelease()  const   {
+  if ( m_arena.numBlocks() > 0 )  {
+    throw std::runtime_error("Attempt to release arena allocated hits from G4 hit-collection "+GetName());
+  }
 }
 
 /// Find hit in a collection by comparison of attributes
@@ -124,14 +235,34 @@ void* Geant4HitCollection::findHit(const Compare& cmp)  {
 
 /// Find hit in a collection by comparison of the key
 Geant4HitWrapper* Geant4HitCollection::findHitByKey(VolumeID key)   {
+  if ( m_flags.bits.flatLookup )  {
+    size_t which = m_index.find(key);
+    if ( which == Geant4HitIndex::npos ) return 0;
+    m_lastHit = which;
+    return &m_hits[which];
+  }
   Keys::const_iterator i=m_keys.find(key);
   if ( i == m_keys.end() ) return 0;
   m_lastHit = (*i).second;
   return &m_hits.at(m_lastHit);
 }
 
+/// Find hit in a collection by hashed comparison of attributes
+void* Geant4HitCollection::findHitByHash(const HashCompare& cmp)  {
+  auto range = m_hashes.equal_range(cmp.hash());
+  for( auto i = range.first; i != range.second; ++i )  {
+    void* p = cmp(m_hits[(*i).second]);
+    if ( p )  {
+      m_lastHit = (*i).second;
+      return p;
+    }
+  }
+  return 0;
+}
+
 /// Release all hits from the Geant4 container and pass ownership to the caller
 void Geant4HitCollection::releaseData(const ComponentCast& cast, std::vector<void*>* result) {
+  checkRelease();
   result->reserve(m_hits.size());
   for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
     Geant4HitWrapper& w = m_hits.at(j);
@@ -143,6 +274,8 @@ void Geant4HitCollection::releaseData(const ComponentCast& cast, std::vector<voi
   }
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_index.clear();
+  m_hashes.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
@@ -160,6 +293,7 @@ void Geant4HitCollection::getData(const ComponentCast& cast, std::vector<void*>*
 
 /// Release all hits from the Geant4 container and pass ownership to the caller
 void Geant4HitCollection::releaseHitsUnchecked(std::vector<void*>& result) {
+  checkRelease();
   result.reserve(m_hits.size());
   for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
     Geant4HitWrapper& w = m_hits.at(j);
@@ -167,6 +301,8 @@ void Geant4HitCollection::releaseHitsUnchecked(std::vector<void*>& result) {
   }
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_index.clear();
+  m_hashes.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
@@ -20,8 +20,15 @@
 #include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4InputAction.h"
 
+#include "G4Run.hh"
 #include "G4Event.hh"
 
+// C/C++ include files
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <climits>
+
 using namespace std;
 using namespace dd4hep::sim;
 typedef dd4hep::detail::ReferenceBitMask<int> PropertyMask;
@@ -36,6 +43,7 @@ Geant4EventReader::Geant4EventReader(const std::string& nam)
 
 /// Default destructor
 Geant4EventReader::~Geant4EventReader()   {
+  deleteEventExtensions(m_eventExtensions);
 }
 
 /// Get the context (from the input action)
@@ -52,6 +60,21 @@ void Geant4EventReader::setInputAction(Geant4InputAction* action) {
   m_inputAction = action;
 }
 
+/// Hand the extensions of the event read last over to the caller
+void Geant4EventReader::takeEventExtensions(EventExtensions& extensions)   {
+  extensions.insert(extensions.end(), m_eventExtensions.begin(), m_eventExtensions.end());
+  m_eventExtensions.clear();
+}
+
+/// Delete extension objects, which were not attached to an event
+void Geant4EventReader::deleteEventExtensions(EventExtensions& extensions)   {
+  for( auto& e : extensions )  {
+    e.second->destruct();
+    delete e.second;
+  }
+  extensions.clear();
+}
+
 /// Skip event. To be implemented for sequential sources
 Geant4EventReader::EventReaderStatus Geant4EventReader::skipEvent()  {
   if ( hasDirectAccess() )   {
@@ -65,6 +88,7 @@ Geant4EventReader::EventReaderStatus Geant4EventReader::skipEvent()  {
   EventReaderStatus sc = readParticles(m_currEvent,vertices,particles);
   for_each(particles.begin(),particles.end(),detail::deleteObject<Particle>);
   for_each(vertices.begin(),vertices.end(),detail::deleteObject<Vertex>);
+  deleteEventExtensions(m_eventExtensions);
   return sc;
 }
 
@@ -116,9 +140,117 @@ Geant4EventReader::moveToEvent(int /* event_number */)   {
 }
 #endif
 
+/// Queue of events read ahead by a separate thread
+/**
+ *  Bounded ring buffer with fixed event positions: input record n is always
+ *  stored in slot n%N. The sequence number of each slot tells whether it
+ *  is free to receive record n (seq == n) or holds record n (seq == n+1).
+ *  There is exactly one producer and one consumer per record,
+ *  hence no locks and no compare-and-swap operations are required.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_SIMULATION
+ */
+class Geant4InputAction::PrefetchQueue  {
+public:
+  typedef Geant4InputAction::Vertices  Vertices;
+  typedef Geant4InputAction::Particles Particles;
+  typedef Geant4InputAction::EventExtensions EventExtensions;
+  /// Storage of one event
+  struct Slot  {
+    atomic<long>    seq    { 0 };
+    int             status { Geant4EventReader::EVENT_READER_OK };
+    Vertices        vertices;
+    Particles       particles;
+    EventExtensions extensions;
+  };
+  Geant4InputAction&      input;
+  size_t                  num_slots;
+  unique_ptr<Slot[]>      slots;
+  /// First record, which will not be produced (end-of-file or error)
+  atomic<long>            end  { LONG_MAX };
+  int                     end_status { Geant4EventReader::EVENT_READER_EOF };
+  atomic<bool>            stop { false };
+  thread                  producer;
+
+  /// Wait with increasing back-off
+  static void backoff(int& count)   {
+    if ( ++count < 64 ) this_thread::yield();
+    else this_thread::sleep_for(chrono::microseconds(count < 1024 ? 50 : 1000));
+  }
+  /// Initializing constructor. Starts the reader thread
+  PrefetchQueue(Geant4InputAction& in, size_t num_events)
+    : input(in), num_slots(max(num_events,size_t(2))), slots(new Slot[num_slots])
+  {
+    for( size_t i = 0; i < num_slots; ++i ) slots[i].seq = i;
+    producer = thread([this] { this->run(); });
+  }
+  /// Default destructor. Stops the reader thread and drops all unused events
+  ~PrefetchQueue()   {
+    stop = true;
+    if ( producer.joinable() ) producer.join();
+    for( size_t i = 0; i < num_slots; ++i )   {
+      for_each(slots[i].particles.begin(),slots[i].particles.end(),detail::deleteObject<Particle>);
+      for_each(slots[i].vertices.begin(),slots[i].vertices.end(),detail::deleteObject<Vertex>);
+      Geant4EventReader::deleteEventExtensions(slots[i].extensions);
+    }
+  }
+  /// Thread function: read the events in sequence
+  void run()   {
+    for( long pos = 0; !stop; ++pos )   {
+      Slot& slot = slots[pos%num_slots];
+      for( int count = 0; slot.seq.load(memory_order_acquire) != pos; backoff(count) )
+        if ( stop ) return;
+      int status = Geant4EventReader::EVENT_READER_IO_ERROR;
+      try  {
+        status = input.readEvent(int(pos) + input.m_firstEvent, slot.vertices, slot.particles, slot.extensions);
+      }
+      catch(const exception& e)  {
+        input.error("+++ Exception while reading event %ld: %s", pos, e.what());
+      }
+      slot.status = status;
+      slot.seq.store(pos+1, memory_order_release);
+      if ( status != Geant4EventReader::EVENT_READER_OK )  {
+        end_status = status;
+        end.store(pos, memory_order_release);
+        return;
+      }
+    }
+  }
+  /// Access the event with the given position. The caller takes ownership of the data
+  int get(long pos, Vertices& vertices, Particles& particles, EventExtensions& extensions)   {
+    if ( pos < 0 )  {
+      input.error("+++ Invalid input record %ld requested.", pos);
+      return Geant4EventReader::EVENT_READER_ERROR;
+    }
+    Slot& slot = slots[pos%num_slots];
+    for( int count = 0; ; backoff(count) )  {
+      long seq = slot.seq.load(memory_order_acquire);
+      if ( seq == pos+1 ) break;
+      if ( pos > end.load(memory_order_acquire) ) return end_status;
+      if ( seq > pos+1 )  {
+        input.error("+++ Input record %ld was already delivered. "
+                    "Prefetching requires ascending event numbers.", pos);
+        return Geant4EventReader::EVENT_READER_ERROR;
+      }
+    }
+    int status = slot.status;
+    vertices.insert(vertices.end(), slot.vertices.begin(), slot.vertices.end());
+    particles.insert(particles.end(), slot.particles.begin(), slot.particles.end());
+    extensions.insert(extensions.end(), slot.extensions.begin(), slot.extensions.end());
+    slot.vertices.clear();
+    slot.particles.clear();
+    slot.extensions.clear();
+    slot.seq.store(pos+num_slots, memory_order_release);
+    return status;
+  }
+};
+
 /// Standard constructor
 Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const string& nam)
-  : Geant4GeneratorAction(ctxt,nam), m_reader(0), m_currentEventNumber(0)
+  : Geant4GeneratorAction(ctxt,nam), m_reader(0), m_currentEventNumber(0), m_queue(0),
+    m_runFirstRecord(0), m_nextRunRecord(0)
 {
   declareProperty("Input",          m_input);
   declareProperty("Sync",           m_firstEvent=0);
@@ -126,11 +258,20 @@ Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const string& nam)
   declareProperty("MomentumScale",  m_momScale = 1.0);
   declareProperty("HaveAbort",      m_abort = true);
   declareProperty("Parameters",     m_parameters = {});
+  declareProperty("Prefetch",       m_prefetch = 0);
   m_needsControl = true;
+  context()->kernel().runAction().callAtBegin(this,&Geant4InputAction::beginRun);
 }
 
 /// Default destructor
 Geant4InputAction::~Geant4InputAction()   {
+  detail::deletePtr(m_queue);
+}
+
+/// Begin-run action callback: prefetched runs continue the input where the previous run stopped
+void Geant4InputAction::beginRun(const G4Run* run)   {
+  m_runFirstRecord = m_nextRunRecord;
+  m_nextRunRecord += run->GetNumberOfEventToBeProcessed();
 }
 
 /// helper to report Geant4 exceptions
@@ -140,62 +281,86 @@ string Geant4InputAction::issue(int i)  const  {
   return str.str();
 }
 
+/// Create the event reader
+int Geant4InputAction::createReader(int evid)   {
+  if ( m_input.empty() )  {
+    except("InputAction: No input file declared!");
+  }
+  string err;
+  TypeName tn = TypeName::split(m_input,"|");
+  try  {
+    m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
+    if ( 0 == m_reader )   {
+      PluginDebug dbg;
+      m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
+      abortRun(issue(evid)+"Error creating reader plugin.",
+               "Failed to create file reader of type %s. Cannot open dataset %s",
+               tn.first.c_str(),tn.second.c_str());
+      return Geant4EventReader::EVENT_READER_NO_FACTORY;
+    }
+    m_reader->setParameters( m_parameters );
+    m_reader->checkParameters( m_parameters );
+    m_reader->setInputAction( this );
+  }
+  catch(const exception& e)  {
+    err = e.what();
+  }
+  if ( !err.empty() )  {
+    abortRun(issue(evid)+err,"Error when creating reader for file %s",m_input.c_str());
+    return Geant4EventReader::EVENT_READER_NO_FACTORY;
+  }
+  return Geant4EventReader::EVENT_READER_OK;
+}
+
+/// Read one event and its event extensions from the event reader
+int Geant4InputAction::readEvent(int evid, Vertices& vertices, Particles& particles, EventExtensions& extensions)   {
+  int status = m_reader->moveToEvent(evid);
+  if ( Geant4EventReader::EVENT_READER_OK == status )  {
+    status = m_reader->readParticles(evid, vertices, particles);
+  }
+  m_reader->takeEventExtensions(extensions);
+  return status;
+}
+
 /// Read an event and return a LCCollection of MCParticles.
 int Geant4InputAction::readParticles(int evt_number,
                                      Vertices& vertices,
                                      std::vector<Particle*>& particles)
+{
+  EventExtensions extensions;
+  int status = readParticles(evt_number, vertices, particles, extensions);
+  Geant4EventReader::deleteEventExtensions(extensions);
+  return status;
+}
+
+/// Read an event with the event extensions of the reader. The caller takes ownership
+int Geant4InputAction::readParticles(int evt_number,
+                                     Vertices& vertices,
+                                     std::vector<Particle*>& particles,
+                                     EventExtensions& extensions)
 {
   int evid = evt_number + m_firstEvent;
-  if ( 0 == m_reader )  {
-    if ( m_input.empty() )  {
-      except("InputAction: No input file declared!");
-    }
-    string err;
-    TypeName tn = TypeName::split(m_input,"|");
-    try  {
-      m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
-      if ( 0 == m_reader )   {
-        PluginDebug dbg;
-        m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
-        abortRun(issue(evid)+"Error creating reader plugin.",
-                 "Failed to create file reader of type %s. Cannot open dataset %s",
-                 tn.first.c_str(),tn.second.c_str());
-        return Geant4EventReader::EVENT_READER_NO_FACTORY;
-      }
-      m_reader->setParameters( m_parameters );
-      m_reader->checkParameters( m_parameters );
-      m_reader->setInputAction( this );
-    }
-    catch(const exception& e)  {
-      err = e.what();
-    }
-    if ( !err.empty() )  {
-      abortRun(issue(evid)+err,"Error when creating reader for file %s",m_input.c_str());
+  int status = Geant4EventReader::EVENT_READER_OK;
+  if ( m_prefetch > 0 )  {
+    call_once(m_queueOnce, [this, evid, &status]  {
+        if ( 0 == m_reader ) status = this->createReader(evid);
+        if ( Geant4EventReader::EVENT_READER_OK == status )
+          m_queue = new PrefetchQueue(*this, m_prefetch);
+      });
+    if ( 0 == m_queue )  {
       return Geant4EventReader::EVENT_READER_NO_FACTORY;
     }
+    status = m_queue->get(evt_number, vertices, particles, extensions);
   }
-  int status = m_reader->moveToEvent(evid);
-  if(status == Geant4EventReader::EVENT_READER_EOF ) {
-    long nEvents = context()->kernel().property("NumEvents").value<long>();
-    if(nEvents < 0) {
-      //context()->kernel().runManager().AbortRun(true);
-      throw DD4hep_End_Of_File();
-    }
-  }
-
-  if ( Geant4EventReader::EVENT_READER_OK != status )  {
-    string msg = issue(evid)+"Error when moving to event - ";
-    if ( status == Geant4EventReader::EVENT_READER_EOF ) msg += " EOF: [end of file].";
-    else msg += " Unknown error condition";
-    if ( m_abort )  {
-      abortRun(msg,"Error when reading file %s",m_input.c_str());
-      return status;
+  else  {
+    if ( 0 == m_reader )  {
+      status = createReader(evid);
+      if ( Geant4EventReader::EVENT_READER_OK != status )  {
+        return status;
+      }
     }
-    error(msg.c_str());
-    except("Error when reading file %s.", m_input.c_str());
-    return status;
+    status = readEvent(evid, vertices, particles, extensions);
   }
-  status = m_reader->readParticles(evid, vertices, particles);
   if(status == Geant4EventReader::EVENT_READER_EOF ) {
     long nEvents = context()->kernel().property("NumEvents").value<long>();
     if(nEvents < 0) {
@@ -204,7 +369,6 @@ int Geant4InputAction::readParticles(int evt_number,
     }
   }
 
-
   if ( Geant4EventReader::EVENT_READER_OK != status )  {
     string msg = issue(evid)+"Error when moving to event - ";
     if ( status == Geant4EventReader::EVENT_READER_EOF ) msg += " EOF: [end of file].";
@@ -221,16 +385,45 @@ int Geant4InputAction::readParticles(int evt_number,
 
 /// Callback to generate primary particles
 void Geant4InputAction::operator()(G4Event* event)   {
+  generate(context(), event);
+}
+
+/// Generate primary particles into the event of the given context
+void Geant4InputAction::generate(Geant4Context* ctxt, G4Event* event)   {
   vector<Particle*>         primaries;
-  Geant4Event&              evt = context()->event();
+  Geant4Event&              evt = ctxt->event();
   Geant4PrimaryEvent*       prim = evt.extension<Geant4PrimaryEvent>();
   Vertices                  vertices ;
+  EventExtensions           extensions;
   int result;
 
-  result = readParticles(m_currentEventNumber, vertices, primaries);
+  if ( m_prefetch > 0 )  {
+    // Concurrent use: the input record is given by the Geant4 event number
+    // relative to the first record of the current run
+    int evt_number = m_runFirstRecord + event->GetEventID();
+    result = readParticles(evt_number, vertices, primaries, extensions);
+    event->SetEventID(m_firstEvent + evt_number);
+  }
+  else  {
+    result = readParticles(m_currentEventNumber, vertices, primaries, extensions);
+    event->SetEventID(m_firstEvent + m_currentEventNumber);
+    ++m_currentEventNumber;
+  }
 
-  event->SetEventID(m_firstEvent + m_currentEventNumber);
-  ++m_currentEventNumber;
+  // Attach the event data of the reader to the event of the given context.
+  // Several inputs may provide the same type: the first one is kept.
+  for( auto& e : extensions )  {
+    if ( evt.ObjectExtensions::extension(e.first, false) )  {
+      e.second->destruct();
+      delete e.second;
+      continue;
+    }
+    evt.addExtension(e.first, e.second);
+  }
+  if ( !extensions.empty() )  {
+    debug("+++ Event %d: Attached %ld event extension(s) of the input reader.",
+          event->GetEventID(), long(extensions.size()));
+  }
 
   if ( result != Geant4EventReader::EVENT_READER_OK )   {    // handle I/O error, but how?
     return;
@@ -245,8 +438,8 @@ void Geant4InputAction::operator()(G4Event* event)   {
   // check if there is at least one primary vertex
   if ( vertices.empty() ) return;
 
-  print("+++ Particle interaction with %d generator particles and %d vertices ++++++++++++++++++++++++",
-        int(primaries.size()), int(vertices.size()) );
+  print("+++ Event %d: Particle interaction with %d generator particles and %d vertices ++++++++++++++++",
+        event->GetEventID(), int(primaries.size()), int(vertices.size()) );
   
 
   for(size_t i=0; i<vertices.size(); ++i )   {
@@ -254,6 +447,7 @@ void Geant4InputAction::operator()(G4Event* event)   {
   }
 
   // build collection of MCParticles
+  double px = 0e0, py = 0e0, pz = 0e0;
   for(auto* primPart : primaries)   {
     Geant4ParticleHandle p(primPart);
     const double mom_scale = m_momScale;
@@ -272,5 +466,10 @@ void Geant4InputAction::operator()(G4Event* event)   {
 
     inter->particles.emplace(p->id,p);
     p.dumpWithMomentumAndVertex(outputLevel()-1,name(),"->");
+    px += p->psx;
+    py += p->psy;
+    pz += p->psz;
   }
+  debug("+++ Event %d: Momentum sum of the generator particles: (%.6e,%.6e,%.6e) MeV",
+        event->GetEventID(), px, py, pz);
 }
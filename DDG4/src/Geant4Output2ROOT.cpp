@@ -26,11 +26,43 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TBranch.h"
+#include "TROOT.h"
+#include "RVersion.h"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+#include "ROOT/TBufferMerger.hxx"
+#endif
+
+// C/C++ include files
+#include <mutex>
 
 using namespace dd4hep::sim;
 using namespace dd4hep;
 using namespace std;
 
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+namespace {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+  typedef ROOT::TBufferMerger BufferMerger;
+#else
+  typedef ROOT::Experimental::TBufferMerger BufferMerger;
+#endif
+
+  /// Access the output merger of a file. All instances writing the same file share the merger
+  shared_ptr<BufferMerger> output_merger(const string& output)   {
+    static mutex lock;
+    static map<string, weak_ptr<BufferMerger> > mergers;
+    lock_guard<mutex> guard(lock);
+    shared_ptr<BufferMerger> merger = mergers[output].lock();
+    if ( !merger )   {
+      ROOT::EnableThreadSafety();
+      merger = make_shared<BufferMerger>(output.c_str(), "RECREATE");
+      mergers[output] = merger;
+    }
+    return merger;
+  }
+}
+#endif
+
 /// Standard constructor
 Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const string& nam)
   : Geant4OutputAction(ctxt, nam), m_file(0), m_tree(0) {
@@ -38,13 +70,23 @@ Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const string& nam)
   declareProperty("HandleMCTruth", m_handleMCTruth = true);
   declareProperty("DisabledCollections",  m_disabledCollections);
   declareProperty("DisableParticles",     m_disableParticles);
+  declareProperty("MergeOutput",          m_mergeOutput);
+  declareProperty("MergeInterval",        m_mergeInterval);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4Output2ROOT::~Geant4Output2ROOT() {
   InstanceCount::decrement(this);
-  if (m_file) {
+  if (m_mergeFile) {
+    flushBuffer();
+    m_tree = 0;
+    m_file = 0;
+    m_mergeFile.reset();
+    // The last instance releasing the merger closes the output file
+    m_merger.reset();
+  }
+  else if (m_file) {
     TDirectory::TContext ctxt(m_file);
     m_tree->Write();
     m_file->Close();
@@ -65,9 +107,31 @@ TTree* Geant4Output2ROOT::section(const string& nam) {
   return (*i).second;
 }
 
+/// Pass the memory buffer to the output merger
+void Geant4Output2ROOT::flushBuffer() {
+  if (m_mergeFile && m_mergeEvents > 0) {
+    TDirectory::TContext ctxt(m_file);
+    m_mergeFile->Write();
+    m_mergeEvents = 0;
+  }
+}
+
 /// Callback to store the Geant4 run information
 void Geant4Output2ROOT::beginRun(const G4Run* run) {
-  if (!m_file && !m_output.empty()) {
+  if (!m_file && !m_output.empty() && m_mergeOutput) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+    TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
+    shared_ptr<BufferMerger> merger = output_merger(m_output);
+    m_mergeFile = merger->GetFile();
+    m_merger = merger;
+    m_file = m_mergeFile.get();
+    m_tree = section("EVENT");
+#else
+    except("+++ MergeOutput requires ROOT 6.10 or newer (TBufferMerger). "
+           "Cannot write output file:'%s'", m_output.c_str());
+#endif
+  }
+  else if (!m_file && !m_output.empty()) {
     TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
     m_file = TFile::Open(m_output.c_str(), "RECREATE", "dd4hep Simulation data");
     if (m_file->IsZombie()) {
@@ -136,6 +200,9 @@ void Geant4Output2ROOT::commit(OutputContext<G4Event>& ctxt) {
       }
     }
     m_tree->SetEntries(evt);
+    if (m_mergeFile && ++m_mergeEvents >= m_mergeInterval) {
+      flushBuffer();
+    }
   }
   Geant4OutputAction::commit(ctxt);
 }
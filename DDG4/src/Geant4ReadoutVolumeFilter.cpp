@@ -51,7 +51,7 @@ Geant4ReadoutVolumeFilter::~Geant4ReadoutVolumeFilter() {
 bool Geant4ReadoutVolumeFilter::operator()(const G4Step* s) const    {
   Geant4StepHandler step(s);
   Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID id = volMgr.volumeID(step.preTouchable());
+  VolumeID id = volMgr.volumeID(step.pre);
   long64 key = m_key->value(id);
   if ( m_collection->key_min <= key && m_collection->key_max >= key )
     return true;
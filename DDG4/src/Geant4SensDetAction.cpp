@@ -100,6 +100,7 @@ Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElem
     throw runtime_error(format("Geant4Sensitive", "DDG4: Detector elemnt for %s is invalid.", nam.c_str()));
   }
   declareProperty("HitCreationMode", m_hitCreationMode = SIMPLE_MODE);
+  declareProperty("CollectionOptimization", m_collectionOptimization = 0);
   m_sequence  = context()->kernel().sensitiveAction(m_detector.name());
   m_sensitive = description_ref.sensitiveDetector(det.name());
   m_readout   = m_sensitive.readout();
@@ -223,7 +224,7 @@ void Geant4Sensitive::mark(const G4Step* step) const  {
 long long int Geant4Sensitive::volumeID(const G4Step* s) {
   Geant4StepHandler step(s);
   Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID id = volMgr.volumeID(step.preTouchable());
+  VolumeID id = volMgr.volumeID(step.pre);
   return id;
 }
 
@@ -231,7 +232,7 @@ long long int Geant4Sensitive::volumeID(const G4Step* s) {
 long long int Geant4Sensitive::cellID(const G4Step* s) {
   Geant4StepHandler h(s);
   Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID volID = volMgr.volumeID(h.preTouchable());
+  VolumeID volID = volMgr.volumeID(h.pre);
   if ( m_segmentation.isValid() )  {
     G4ThreeVector global = 0.5 * ( h.prePosG4()+h.postPosG4());
     G4ThreeVector local  = h.preTouchable()->GetHistory()->GetTopTransform().TransformPoint(global);
@@ -375,6 +376,8 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
   for (size_t count = 0; count < m_collections.size(); ++count) {
     const HitCollection& cr = m_collections[count];
     Geant4HitCollection* c = (*cr.second.second)(name(), cr.first, cr.second.first);
+    if ( cr.second.first )
+      c->setOptimize(cr.second.first->collectionOptimization());
     int id = m_detector->GetCollectionID(count);
     m_hce->AddHitsCollection(id, c);
   }
@@ -188,7 +188,7 @@ void Geant4SensitiveDetector::dumpStep(G4Step* st, G4TouchableHistory* /* histor
 long long Geant4SensitiveDetector::getVolumeID(G4Step* aStep) {
   Geant4StepHandler step(aStep);
   Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID id = volMgr.volumeID(step.preTouchable());
+  VolumeID id = volMgr.volumeID(step.pre);
 
 #if 0 //  additional checks ...
   const G4VPhysicalVolume* g4v = step.volume( step.pre );
@@ -221,7 +221,7 @@ long long Geant4SensitiveDetector::getVolumeID(G4Step* aStep) {
 long long Geant4SensitiveDetector::getCellID(G4Step* step) {
   StepHandler h(step);
   Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID            volID  = volMgr.volumeID(h.preTouchable());
+  VolumeID            volID  = volMgr.volumeID(h.pre);
   Segmentation        seg    = m_readout.segmentation();
   if ( seg.isValid() )  {
     G4ThreeVector global = 0.5 * ( h.prePosG4()+h.postPosG4());
@@ -22,6 +22,8 @@
 
 // Geant4 include files
 #include "G4VTouchable.hh"
+#include "G4StepPoint.hh"
+#include "G4TouchableHandle.hh"
 #include "G4LogicalVolume.hh"
 #include "G4VPhysicalVolume.hh"
 
@@ -39,6 +41,29 @@ using namespace std;
 typedef pair<VolumeID,vector<pair<const BitFieldElement*, VolumeID> > > VolIDDescriptor;
 namespace {
 
+  /// Per-thread memory of the last resolved touchable of the current track
+  /** The touchable of a track is only replaced when the track crosses a volume
+   *  boundary. Holding a reference to it guarantees, that the address cannot be
+   *  reused by another touchable: an identical pointer means an identical history.
+   */
+  struct TouchableCache  {
+    const Geant4GeometryInfo*        info = 0;
+    G4TouchableHandle                touchable;
+    VolumeID                         volumeID = 0;
+  };
+  thread_local TouchableCache s_touchableCache;
+  /// Per-thread scratch buffer for placement paths
+  thread_local vector<const G4VPhysicalVolume*> s_path;
+
+  /// Hash lookup of a placement path. Returns null if the path is unknown or the hash is ambiguous
+  const pair<const Geant4GeometryInfo::Geant4PlacementPath, VolumeID>*
+  findPath(const Geant4GeometryInfo* info, const Geant4GeometryInfo::Geant4PlacementPath& path, unsigned long long hash)   {
+    auto i = info->g4PathIndex.find(hash);
+    if ( i != info->g4PathIndex.end() && i->second && i->second->first == path )
+      return i->second;
+    return 0;
+  }
+
   /// Helper class to populate the Geant4 volume manager
   struct Populator {
     typedef vector<const TGeoNode*> Chain;
@@ -156,7 +181,8 @@ namespace {
           printout(print_res, "Geant4VolumeManager", "+++     Map %016X to Geant4 Path:%s",
                    (void*)code, Geant4GeometryInfo::placementPath(path).c_str());
           if (m_geo.g4Paths.find(path) == m_geo.g4Paths.end()) {
-            m_geo.g4Paths[path] = code;
+            auto ret = m_geo.g4Paths.emplace(path, code);
+            m_geo.indexPlacementPath(*ret.first);
             m_entries.emplace(code,path);
             return;
           }
@@ -220,7 +246,11 @@ bool Geant4VolumeManager::checkValidity() const {
 /// Access CELLID by placement path
 VolumeID Geant4VolumeManager::volumeID(const vector<const G4VPhysicalVolume*>& path) const {
   if (!path.empty() && checkValidity()) {
-    const auto& m = ptr()->g4Paths;
+    const Geant4GeometryInfo* info = ptr();
+    const auto* entry = findPath(info, path, Geant4GeometryInfo::placementPathHash(path));
+    if ( entry )
+      return entry->second;
+    const auto& m = info->g4Paths;
     auto i = m.find(path);
     if (i != m.end())
       return (*i).second;
@@ -236,10 +266,39 @@ VolumeID Geant4VolumeManager::volumeID(const vector<const G4VPhysicalVolume*>& p
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const {
+  if ( touchable && checkValidity() )   {
+    const Geant4GeometryInfo* info = ptr();
+    unsigned long long hash = Geant4GeometryInfo::placementPathHashSeed;
+    int n = touchable->GetHistoryDepth();
+    s_path.clear();
+    for (int i=0; i < n; ++i)  {
+      const G4VPhysicalVolume* pv = touchable->GetVolume(i);
+      s_path.emplace_back(pv);
+      hash = Geant4GeometryInfo::placementPathHash(hash, pv);
+    }
+    const auto* entry = findPath(info, s_path, hash);
+    return entry ? entry->second : volumeID(s_path);
+  }
   Geant4TouchableHandler handler(touchable);
   return volumeID(handler.placementPath());
 }
 
+/// Access CELLID by Geant4 step point. Reuses the last result while the touchable of the track is unchanged
+VolumeID Geant4VolumeManager::volumeID(const G4StepPoint* point) const {
+  const G4TouchableHandle& handle = point->GetTouchableHandle();
+  if ( ptr() && ptr()->cacheTouchables && handle() )   {
+    TouchableCache& cache = s_touchableCache;
+    if ( cache.info == ptr() && cache.touchable() == handle() )
+      return cache.volumeID;
+    VolumeID vid = volumeID(handle());
+    cache.info      = ptr();
+    cache.touchable = handle;
+    cache.volumeID  = vid;
+    return vid;
+  }
+  return volumeID(point->GetTouchable());
+}
+
 /// Accessfully decoded volume fields  by placement path
 void Geant4VolumeManager::volumeDescriptor(const vector<const G4VPhysicalVolume*>& path,
                                            VolIDDescriptor& vol_desc) const
@@ -15,6 +15,8 @@
 #define XMLTOOLS_EVALUATOR_H
 
 #include <ostream>
+#include <string>
+#include <utility>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep  {
@@ -90,6 +92,18 @@ namespace dd4hep  {
        */
       double evaluate(const char * expression);
 
+      /**
+       * Thread-safe evaluation of the arithmetic expression.
+       * Expressions are compiled on first use and kept in a cache by their
+       * text: subsequent evaluations of the same text only execute the
+       * compiled code. Several threads may evaluate concurrently. The state
+       * of the evaluator (status(), error_position()) is not changed.
+       * @param  expression input expression.
+       * @param  os         stream to print the error message if the evaluation fails.
+       * @return status and result of the evaluation.
+       */
+      std::pair<int,double> evaluate(const std::string& expression, std::ostream& os) const;
+
       /**
        * Returns status of the last operation with the evaluator.
        */
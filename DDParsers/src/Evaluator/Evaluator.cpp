@@ -6,6 +6,11 @@
 
 #include <iostream>
 #include <cmath>        // for pow()
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <shared_mutex>
+#include <unordered_map>
 #include "stack.src"
 #include "string.src"
 #include "hash_map.src"
@@ -52,8 +57,20 @@ struct Item {
   explicit Item(void  *x) : what(FUNCTION),  variable(0),expression(), function(x) {}
 };
 
+/// Internal expression evaluator helper class: instruction of a compiled expression
+struct Instruction {
+  int         code;     // Operator, VALUE, LOAD or CALL
+  int         npar;     // Number of function parameters (CALL)
+  double      value;    // Constant (VALUE)
+  const Item* item;     // Dictionary entry of the variable (LOAD) or function (CALL)
+};
+
+/// Compiled expression: instructions in reverse polish notation
+typedef std::vector<Instruction> Code;
+
 typedef char * pchar;
 typedef hash_map<string,Item> dic_type;
+typedef std::unordered_map<std::string,Code> cache_type;
 
 namespace {
 
@@ -64,6 +81,10 @@ namespace {
     pchar    thePosition;
     int      theStatus;
     double   theResult;
+    /// Compiled expressions by their text. The code refers to entries of the dictionary
+    cache_type theCache;
+    /// Protection of the dictionary and the cache: shared for evaluations, exclusive for updates
+    mutable std::shared_timed_mutex theLock;
   };
 
   /// Internal expression evaluator helper union
@@ -100,13 +121,42 @@ namespace {
 
 #define EVAL_EXIT(STATUS,POSITION) endp = POSITION; return STATUS
 #define MAX_N_PAR 5
+#define MAX_N_CACHE 262144
 
 static const char sss[MAX_N_PAR+2] = "012345";
 
 enum { ENDL, LBRA, OR, AND, EQ, NE, GE, GT, LE, LT,
-       PLUS, MINUS, MULT, DIV, POW, RBRA, VALUE };
+       PLUS, MINUS, MULT, DIV, POW, RBRA, VALUE, LOAD, CALL };
+
+template <typename T>
+static int engine(pchar, pchar, T &, pchar &, const dic_type &);
+
+static int expression(const Item & item, double & result,
+                      const dic_type & dictionary)
+/***********************************************************************
+ *                                                                     *
+ * Function: Evaluates the expression assigned to a variable.          *
+ *           The engine modifies the text while parsing: work on a     *
+ *           private copy to allow concurrent evaluations.             *
+ *                                                                     *
+ ***********************************************************************/
+{
+  const char* exp = item.expression.c_str();
+  std::vector<char> text(exp, exp+strlen(exp)+1);
+  pchar exp_begin = &text[0];
+  pchar exp_end   = exp_begin + text.size() - 2;
+  if (engine(exp_begin, exp_end, result, exp_end, dictionary) == EVAL::OK)
+    return EVAL::OK;
+  return EVAL::ERROR_CALCULATION_ERROR;
+}
+
+/// Operand value for the direct evaluation
+static inline void number(double x, double & result) { result = x; }
 
-static int engine(pchar, pchar, double &, pchar &, const dic_type &);
+/// Operand value for the compilation
+static inline void number(double x, Code & result)   {
+  result.assign(1, Instruction { VALUE, 0, x, 0 });
+}
 
 static int variable(const string & name, double & result,
                     const dic_type & dictionary)
@@ -128,50 +178,44 @@ static int variable(const string & name, double & result,
   dic_type::const_iterator iter = dictionary.find(name);
   if (iter == dictionary.end())
     return EVAL::ERROR_UNKNOWN_VARIABLE;
-  Item item = iter->second;
+  const Item & item = iter->second;
   switch (item.what) {
   case Item::VARIABLE:
     result = item.variable;
     return EVAL::OK;
-  case Item::EXPRESSION: {
-    pchar exp_begin = (char *)(item.expression.c_str());
-    pchar exp_end   = exp_begin + strlen(exp_begin) - 1;
-    if (engine(exp_begin, exp_end, result, exp_end, dictionary) == EVAL::OK)
-      return EVAL::OK;
-    return EVAL::ERROR_CALCULATION_ERROR;
-  }
+  case Item::EXPRESSION:
+    return expression(item, result, dictionary);
   default:
     return EVAL::ERROR_CALCULATION_ERROR;
   }
 }
 
-static int function(const string & name, stack<double> & par,
-                    double & result, const dic_type & dictionary)
+static int variable(const string & name, Code & result,
+                    const dic_type & dictionary)
 /***********************************************************************
  *                                                                     *
- * Name: function                                    Date:    03.10.00 *
- * Author: Evgeni Chernyaev                          Revised:          *
+ * Function: Compiles the reference to the variable. The value is      *
+ *           looked up when the compiled expression is executed.       *
  *                                                                     *
- * Function: Finds value of the function.                              *
- *           This function is used by operand().                       *
+ ***********************************************************************/
+{
+  dic_type::const_iterator iter = dictionary.find(name);
+  if (iter == dictionary.end())
+    return EVAL::ERROR_UNKNOWN_VARIABLE;
+  const Item& item = iter->second;
+  if (item.what != Item::VARIABLE && item.what != Item::EXPRESSION)
+    return EVAL::ERROR_CALCULATION_ERROR;
+  result.assign(1, Instruction { LOAD, 0, 0.0, &item });
+  return EVAL::OK;
+}
+
+static int call(const Item & item, int npar, const double * pp, double & result)
+/***********************************************************************
  *                                                                     *
- * Parameters:                                                         *
- *   name   - name of the function.                                    *
- *   par    - stack of parameters.                                     *
- *   result - value of the function.                                   *
- *   dictionary - dictionary of available variables and functions.     *
+ * Function: Calls the function with the parameters in reverse order.  *
  *                                                                     *
  ***********************************************************************/
 {
-  int npar = par.size();
-  if (npar > MAX_N_PAR) return EVAL::ERROR_UNKNOWN_FUNCTION;
-
-  dic_type::const_iterator iter = dictionary.find(sss[npar]+name);
-  if (iter == dictionary.end()) return EVAL::ERROR_UNKNOWN_FUNCTION;
-  Item item = iter->second;
-
-  double pp[MAX_N_PAR];
-  for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
   errno = 0;
   if (item.function == 0)       return EVAL::ERROR_CALCULATION_ERROR;
   FCN fcn(item.function);
@@ -198,7 +242,61 @@ static int function(const string & name, stack<double> & par,
   return (errno == 0) ? EVAL::OK : EVAL::ERROR_CALCULATION_ERROR;
 }
 
-static int operand(pchar begin, pchar end, double & result,
+static int function(const string & name, stack<double> & par,
+                    double & result, const dic_type & dictionary)
+/***********************************************************************
+ *                                                                     *
+ * Name: function                                    Date:    03.10.00 *
+ * Author: Evgeni Chernyaev                          Revised:          *
+ *                                                                     *
+ * Function: Finds value of the function.                              *
+ *           This function is used by operand().                       *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   name   - name of the function.                                    *
+ *   par    - stack of parameters.                                     *
+ *   result - value of the function.                                   *
+ *   dictionary - dictionary of available variables and functions.     *
+ *                                                                     *
+ ***********************************************************************/
+{
+  int npar = par.size();
+  if (npar > MAX_N_PAR) return EVAL::ERROR_UNKNOWN_FUNCTION;
+
+  dic_type::const_iterator iter = dictionary.find(sss[npar]+name);
+  if (iter == dictionary.end()) return EVAL::ERROR_UNKNOWN_FUNCTION;
+  const Item & item = iter->second;
+
+  double pp[MAX_N_PAR];
+  for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
+  return call(item, npar, pp, result);
+}
+
+static int function(const string & name, stack<Code> & par,
+                    Code & result, const dic_type & dictionary)
+/***********************************************************************
+ *                                                                     *
+ * Function: Compiles the function call: the code of the parameters    *
+ *           followed by the call instruction.                         *
+ *                                                                     *
+ ***********************************************************************/
+{
+  int npar = par.size();
+  if (npar > MAX_N_PAR) return EVAL::ERROR_UNKNOWN_FUNCTION;
+
+  dic_type::const_iterator iter = dictionary.find(sss[npar]+name);
+  if (iter == dictionary.end()) return EVAL::ERROR_UNKNOWN_FUNCTION;
+
+  std::vector<Code> pp(npar);
+  for(int i=npar-1; i>=0; i--) { pp[i] = std::move(par.top()); par.pop(); }
+  result.clear();
+  for(const Code& c : pp) result.insert(result.end(), c.begin(), c.end());
+  result.emplace_back(Instruction { CALL, npar, 0.0, &iter->second });
+  return EVAL::OK;
+}
+
+template <typename T>
+static int operand(pchar begin, pchar end, T & result,
                    pchar & endp, const dic_type & dictionary)
 /***********************************************************************
  *                                                                     *
@@ -228,10 +326,10 @@ static int operand(pchar begin, pchar end, double & result,
     errno = 0;
 #ifdef _WIN32
     if ( pointer[0] == '0' && pointer < end && (pointer[1] == 'x' || pointer[1] == 'X') )
-      result = strtol(pointer, (char **)(&pointer), 0);
+      number(strtol(pointer, (char **)(&pointer), 0), result);
     else
 #endif
-      result = strtod(pointer, (char **)(&pointer));
+      number(strtod(pointer, (char **)(&pointer)), result);
     if (errno == 0) {
       EVAL_EXIT( EVAL::OK, --pointer );
     }else{
@@ -253,7 +351,7 @@ static int operand(pchar begin, pchar end, double & result,
 
   //   G E T   V A R I A B L E
 
-  result = 0.0;
+  number(0.0, result);
   SKIP_BLANKS;
   if (c != '(') {
     EVAL_STATUS = variable(name, result, dictionary);
@@ -263,8 +361,8 @@ static int operand(pchar begin, pchar end, double & result,
   //   G E T   F U N C T I O N
 
   stack<pchar>  pos;                // position stack
-  stack<double> par;                // parameter stack
-  double        value;
+  stack<T>      par;                // parameter stack
+  T             value;
   pchar         par_begin = pointer+1, par_end;
 
   for(;;pointer++) {
@@ -282,7 +380,7 @@ static int operand(pchar begin, pchar end, double & result,
 	  { EVAL_EXIT( EVAL::ERROR_EMPTY_PARAMETER, --par_end ); }
         if (EVAL_STATUS != EVAL::OK)
 	  { EVAL_EXIT( EVAL_STATUS, par_end ); }
-        par.push(value);
+        par.push(std::move(value));
         par_begin = pointer + 1;
       }
       break;
@@ -295,7 +393,7 @@ static int operand(pchar begin, pchar end, double & result,
         EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
         switch (EVAL_STATUS) {
         case EVAL::OK:
-          par.push(value);
+          par.push(std::move(value));
           break;
         case EVAL::WARNING_BLANK_STRING:
           if (par.size() != 0)
@@ -313,64 +411,53 @@ static int operand(pchar begin, pchar end, double & result,
 
 /***********************************************************************
  *                                                                     *
- * Name: maker                                       Date:    28.09.00 *
- * Author: Evgeni Chernyaev                          Revised:          *
- *                                                                     *
- * Function: Executes basic arithmetic operations on values in the top *
- *           of the stack. Result is placed back into the stack.       *
- *           This function is used by engine().                        *
- *                                                                     *
- * Parameters:                                                         *
- *   op  - code of the operation.                                      *
- *   val - stack of values.                                            *
+ * Function: Executes basic arithmetic operation on two values.        *
+ *           This function is used by maker() and execute().           *
  *                                                                     *
  ***********************************************************************/
-static int maker(int op, stack<double> & val)
+static int apply(int op, double val1, double val2, double & result)
 {
-  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
-  double val2 = val.top(); val.pop();
-  double val1 = val.top();
   switch (op) {
   case OR:                                // operator ||
-    val.top() = (val1 || val2) ? 1. : 0.;
+    result = (val1 || val2) ? 1. : 0.;
     return EVAL::OK;
   case AND:                               // operator &&
-    val.top() = (val1 && val2) ? 1. : 0.;
+    result = (val1 && val2) ? 1. : 0.;
     return EVAL::OK;
   case EQ:                                // operator ==
-    val.top() = (val1 == val2) ? 1. : 0.;
+    result = (val1 == val2) ? 1. : 0.;
     return EVAL::OK;
   case NE:                                // operator !=
-    val.top() = (val1 != val2) ? 1. : 0.;
+    result = (val1 != val2) ? 1. : 0.;
     return EVAL::OK;
   case GE:                                // operator >=
-    val.top() = (val1 >= val2) ? 1. : 0.;
+    result = (val1 >= val2) ? 1. : 0.;
     return EVAL::OK;
   case GT:                                // operator >
-    val.top() = (val1 >  val2) ? 1. : 0.;
+    result = (val1 >  val2) ? 1. : 0.;
     return EVAL::OK;
   case LE:                                // operator <=
-    val.top() = (val1 <= val2) ? 1. : 0.;
+    result = (val1 <= val2) ? 1. : 0.;
     return EVAL::OK;
   case LT:                                // operator <
-    val.top() = (val1 <  val2) ? 1. : 0.;
+    result = (val1 <  val2) ? 1. : 0.;
     return EVAL::OK;
   case PLUS:                              // operator '+'
-    val.top() = val1 + val2;
+    result = val1 + val2;
     return EVAL::OK;
   case MINUS:                             // operator '-'
-    val.top() = val1 - val2;
+    result = val1 - val2;
     return EVAL::OK;
   case MULT:                              // operator '*'
-    val.top() = val1 * val2;
+    result = val1 * val2;
     return EVAL::OK;
   case DIV:                               // operator '/'
     if (val2 == 0.0) return EVAL::ERROR_CALCULATION_ERROR;
-    val.top() = val1 / val2;
+    result = val1 / val2;
     return EVAL::OK;
   case POW:                               // operator '^' (or '**')
     errno = 0;
-    val.top() = pow(val1,val2);
+    result = pow(val1,val2);
     if (errno == 0) return EVAL::OK;
     ATTR_FALLTHROUGH;
   default:
@@ -378,6 +465,43 @@ static int maker(int op, stack<double> & val)
   }
 }
 
+/***********************************************************************
+ *                                                                     *
+ * Name: maker                                       Date:    28.09.00 *
+ * Author: Evgeni Chernyaev                          Revised:          *
+ *                                                                     *
+ * Function: Executes basic arithmetic operations on values in the top *
+ *           of the stack. Result is placed back into the stack.       *
+ *           This function is used by engine().                        *
+ *                                                                     *
+ * Parameters:                                                         *
+ *   op  - code of the operation.                                      *
+ *   val - stack of values.                                            *
+ *                                                                     *
+ ***********************************************************************/
+static int maker(int op, stack<double> & val)
+{
+  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
+  double val2 = val.top(); val.pop();
+  return apply(op, val.top(), val2, val.top());
+}
+
+/***********************************************************************
+ *                                                                     *
+ * Function: Compiles basic arithmetic operations: the code of the     *
+ *           operands followed by the operator.                        *
+ *                                                                     *
+ ***********************************************************************/
+static int maker(int op, stack<Code> & val)
+{
+  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
+  Code val2 = std::move(val.top()); val.pop();
+  Code& val1 = val.top();
+  val1.insert(val1.end(), val2.begin(), val2.end());
+  val1.emplace_back(Instruction { op, 0, 0.0, 0 });
+  return EVAL::OK;
+}
+
 /***********************************************************************
  *                                                                     *
  * Name: engine                                      Date:    28.09.00 *
@@ -394,7 +518,8 @@ static int maker(int op, stack<double> & val)
  *   dictionary - dictionary of available variables and functions.     *
  *                                                                     *
  ***********************************************************************/
-static int engine(pchar begin, pchar end, double & result,
+template <typename T>
+static int engine(pchar begin, pchar end, T & result,
                   pchar & endp, const dic_type & dictionary)
 {
   static const int SyntaxTable[17][17] = {
@@ -438,8 +563,8 @@ static int engine(pchar begin, pchar end, double & result,
 
   stack<int>    op;                      // operator stack
   stack<pchar>  pos;                     // position stack
-  stack<double> val;                     // value stack
-  double        value;
+  stack<T>      val;                     // value stack
+  T             value;
   pchar         pointer = begin;
   int           iWhat, iCur, iPrev = 0, iTop, EVAL_STATUS;
   char          c;
@@ -512,10 +637,11 @@ static int engine(pchar begin, pchar end, double & result,
     case 1:                             // operand: number, variable, function
       EVAL_STATUS = operand(pointer, end, value, pointer, dictionary);
       if (EVAL_STATUS != EVAL::OK) { EVAL_EXIT( EVAL_STATUS, pointer ); }
-      val.push(value);
+      val.push(std::move(value));
       continue;
     case 2:                             // unary + or unary -
-      val.push(0.0);
+      number(0.0, value);
+      val.push(std::move(value));
     case 3: default:                    // next operator
       break;
     }
@@ -562,6 +688,137 @@ static int engine(pchar begin, pchar end, double & result,
   }
 }
 
+//---------------------------------------------------------------------------
+static int execute(const Code & code, double & result,
+                   const dic_type & dictionary)
+/***********************************************************************
+ *                                                                     *
+ * Function: Executes a compiled expression. The dictionary is only    *
+ *           read: several threads may execute concurrently.           *
+ *                                                                     *
+ ***********************************************************************/
+{
+  // The stack depth is limited by the number of instructions
+  double        buffer[32], pp[MAX_N_PAR], value;
+  std::vector<double> extra(code.size() > 32 ? code.size() : 0);
+  double*       val = extra.empty() ? buffer : &extra[0];
+  int           k = 0, EVAL_STATUS;
+  for (const Instruction & i : code) {
+    switch (i.code) {
+    case VALUE:
+      val[k++] = i.value;
+      break;
+    case LOAD:
+      if (i.item->what == Item::VARIABLE) {
+        val[k++] = i.item->variable;
+        break;
+      }
+      else if (i.item->what == Item::EXPRESSION) {
+        EVAL_STATUS = expression(*i.item, val[k++], dictionary);
+        if (EVAL_STATUS != EVAL::OK) return EVAL_STATUS;
+        break;
+      }
+      return EVAL::ERROR_CALCULATION_ERROR;
+    case CALL:
+      for(int n=0; n<i.npar; n++) pp[n] = val[--k];
+      EVAL_STATUS = call(*i.item, i.npar, pp, value);
+      if (EVAL_STATUS != EVAL::OK) return EVAL_STATUS;
+      val[k++] = value;
+      break;
+    default:
+      --k;
+      EVAL_STATUS = apply(i.code, val[k-1], val[k], val[k-1]);
+      if (EVAL_STATUS != EVAL::OK) return EVAL_STATUS;
+      break;
+    }
+  }
+  result = val[0];
+  return EVAL::OK;
+}
+
+//---------------------------------------------------------------------------
+static int interpret(const char * expression, double & result,
+                     int & position, const dic_type & dictionary)
+/***********************************************************************
+ *                                                                     *
+ * Function: Evaluates the expression with the interpreter on a        *
+ *           private copy of the text.                                 *
+ *                                                                     *
+ ***********************************************************************/
+{
+  std::vector<char> text(expression, expression+strlen(expression)+1);
+  pchar begin = &text[0], endp = begin;
+  result = 0.0;
+  int EVAL_STATUS = engine(begin, begin+text.size()-2, result, endp, dictionary);
+  position = endp - begin;
+  return EVAL_STATUS;
+}
+
+//---------------------------------------------------------------------------
+static int compute(Struct * s, const std::string & expression, double & result)
+/***********************************************************************
+ *                                                                     *
+ * Function: Evaluates the expression. On first use the text is only   *
+ *           interpreted, expressions used again are compiled and the  *
+ *           code is kept in the cache. The caller must hold the       *
+ *           exclusive lock.                                           *
+ *                                                                     *
+ ***********************************************************************/
+{
+  cache_type::iterator iter = s->theCache.find(expression);
+  if (iter == s->theCache.end()) {
+    int position = 0;
+    if (s->theCache.size() < MAX_N_CACHE) s->theCache.emplace(expression, Code());
+    return interpret(expression.c_str(), result, position, s->theDictionary);
+  }
+  Code & code = iter->second;
+  if (code.empty()) {
+    std::vector<char> text(expression.c_str(), expression.c_str()+expression.length()+1);
+    pchar begin = &text[0], endp = begin;
+    int EVAL_STATUS = engine(begin, begin+text.size()-2, code, endp, s->theDictionary);
+    if (EVAL_STATUS != EVAL::OK) {
+      code.clear();
+      return EVAL_STATUS;
+    }
+  }
+  return execute(code, result, s->theDictionary);
+}
+
+//---------------------------------------------------------------------------
+static void print_error(std::ostream & os, int status, const char * position)
+{
+  static char prefix[] = "Evaluator : ";
+  const char* opt = (position ? position : "");
+  switch (status) {
+  case EVAL::ERROR_NOT_A_NAME:
+    os << prefix << "invalid name : " << opt;
+    return;
+  case EVAL::ERROR_SYNTAX_ERROR:
+    os << prefix << "systax error"        ;
+    return;
+  case EVAL::ERROR_UNPAIRED_PARENTHESIS:
+    os << prefix << "unpaired parenthesis";
+    return;
+  case EVAL::ERROR_UNEXPECTED_SYMBOL:
+    os << prefix << "unexpected symbol : " << opt;
+    return;
+  case EVAL::ERROR_UNKNOWN_VARIABLE:
+    os << prefix << "unknown variable : " << opt;
+    return;
+  case EVAL::ERROR_UNKNOWN_FUNCTION:
+    os << prefix << "unknown function : " << opt;
+    return;
+  case EVAL::ERROR_EMPTY_PARAMETER:
+    os << prefix << "empty parameter in function call: " << opt;
+    return;
+  case EVAL::ERROR_CALCULATION_ERROR:
+    os << prefix << "calculation error";
+    return;
+  default:
+    return;
+  }
+}
+
 //---------------------------------------------------------------------------
 static void setItem(const char * prefix, const char * name,
                     const Item & item, Struct * s) {
@@ -591,17 +848,24 @@ static void setItem(const char * prefix, const char * name,
 
   //   A D D   I T E M   T O   T H E   D I C T I O N A R Y
 
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
+  // Deep copy: the reference counted text may not be shared with the caller
+  Item entry;
+  entry.what     = item.what;
+  entry.variable = item.variable;
+  entry.function = item.function;
+  if (item.expression.c_str() != 0) entry.expression = item.expression.c_str();
   string item_name = prefix + string(pointer,n);
   dic_type::iterator iter = (s->theDictionary).find(item_name);
   if (iter != (s->theDictionary).end()) {
-    iter->second = item;
+    iter->second = entry;
     if (item_name == name) {
       s->theStatus = EVAL::WARNING_EXISTING_VARIABLE;
     }else{
       s->theStatus = EVAL::WARNING_EXISTING_FUNCTION;
     }
   }else{
-    (s->theDictionary)[item_name] = item;
+    (s->theDictionary)[item_name] = entry;
     s->theStatus = EVAL::OK;
   }
 }
@@ -632,6 +896,7 @@ Evaluator::~Evaluator() {
 //---------------------------------------------------------------------------
 double Evaluator::evaluate(const char * expression) {
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
   if (s->theExpression != 0) { delete[] s->theExpression; }
   s->theExpression = 0;
   s->thePosition   = 0;
@@ -640,15 +905,50 @@ double Evaluator::evaluate(const char * expression) {
   if (expression != 0) {
     s->theExpression = new char[strlen(expression)+1];
     strcpy(s->theExpression, expression);
-    s->theStatus = engine(s->theExpression,
-			  s->theExpression+strlen(expression)-1,
-			  s->theResult,
-			  s->thePosition,
-			  s->theDictionary);
+    s->theStatus = compute(s, s->theExpression, s->theResult);
+    if (s->theStatus == OK) {
+      s->thePosition = s->theExpression+strlen(expression);
+    }
+    else {
+      // Repeat with the interpreter to locate the error
+      s->theResult = 0.0;
+      s->theStatus = engine(s->theExpression,
+                            s->theExpression+strlen(expression)-1,
+                            s->theResult,
+                            s->thePosition,
+                            s->theDictionary);
+    }
   }
   return s->theResult;
 }
 
+//---------------------------------------------------------------------------
+std::pair<int,double> Evaluator::evaluate(const std::string& expression, std::ostream& os) const {
+  Struct * s = reinterpret_cast<Struct*>(p);
+  double result = 0.0;
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(s->theLock);
+    cache_type::const_iterator iter = s->theCache.find(expression);
+    if (iter != s->theCache.end() && !iter->second.empty() &&
+        execute(iter->second, result, s->theDictionary) == OK) {
+      return std::make_pair(int(OK), result);
+    }
+  }
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
+  int status = compute(s, expression, result);
+  if (status != OK) {
+    // Repeat with the interpreter to locate the error
+    int position = 0;
+    status = interpret(expression.c_str(), result, position, s->theDictionary);
+    std::stringstream str;
+    ::print_error(str, status, expression.c_str()+position);
+    if (!str.str().empty()) {
+      os << expression << ": " << str.str() << std::endl;
+    }
+  }
+  return std::make_pair(status, result);
+}
+
 //---------------------------------------------------------------------------
 int Evaluator::status() const {
   return (reinterpret_cast<Struct*>(p))->theStatus;
@@ -669,42 +969,14 @@ void Evaluator::print_error() const {
 
 //---------------------------------------------------------------------------
 void Evaluator::print_error(std::ostream& os) const {
-  static char prefix[] = "Evaluator : ";
   Struct * s = reinterpret_cast<Struct*>(p);
-  const char* opt = (s->thePosition ? s->thePosition : "");
-  switch (s->theStatus) {
-  case ERROR_NOT_A_NAME:
-    os << prefix << "invalid name : " << opt;
-    return;
-  case ERROR_SYNTAX_ERROR:
-    os << prefix << "systax error"        ;
-    return;
-  case ERROR_UNPAIRED_PARENTHESIS:
-    os << prefix << "unpaired parenthesis";
-    return;
-  case ERROR_UNEXPECTED_SYMBOL:
-    os << prefix << "unexpected symbol : " << opt;
-    return;
-  case ERROR_UNKNOWN_VARIABLE:
-    os << prefix << "unknown variable : " << opt;
-    return;
-  case ERROR_UNKNOWN_FUNCTION:
-    os << prefix << "unknown function : " << opt;
-    return;
-  case ERROR_EMPTY_PARAMETER:
-    os << prefix << "empty parameter in function call: " << opt;
-    return;
-  case ERROR_CALCULATION_ERROR:
-    os << prefix << "calculation error";
-    return;
-  default:
-    return;
-  }
+  ::print_error(os, s->theStatus, s->thePosition);
 }
 
 //---------------------------------------------------------------------------
 void Evaluator::setEnviron(const char* name, const char* value)  {
   Struct* s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
   string prefix = "${";
   string item_name = prefix + string(name) + string("}");
   dic_type::iterator iter = (s->theDictionary).find(item_name);
@@ -729,6 +1001,7 @@ void Evaluator::setEnviron(const char* name, const char* value)  {
 //---------------------------------------------------------------------------
 const char* Evaluator::getEnviron(const char* name)  {
   Struct* s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
   string item_name = name;
   //std::cout << " ++++++++++++++++++++++++++++ Try to resolve env:" << name << std::endl;
   dic_type::iterator iter = (s->theDictionary).find(item_name);
@@ -793,6 +1066,7 @@ bool Evaluator::findVariable(const char * name) const {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return false;
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::shared_lock<std::shared_timed_mutex> lock(s->theLock);
   return
     ((s->theDictionary).find(string(pointer,n)) == (s->theDictionary).end()) ?
     false : true;
@@ -805,6 +1079,7 @@ bool Evaluator::findFunction(const char * name, int npar) const {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return false;
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::shared_lock<std::shared_timed_mutex> lock(s->theLock);
   return ((s->theDictionary).find(sss[npar]+string(pointer,n)) ==
 	  (s->theDictionary).end()) ? false : true;
 }
@@ -815,6 +1090,8 @@ void Evaluator::removeVariable(const char * name) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
+  (s->theCache).clear();   // Compiled expressions refer to dictionary entries
   (s->theDictionary).erase(string(pointer,n));
 }
 
@@ -825,12 +1102,16 @@ void Evaluator::removeFunction(const char * name, int npar) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
+  (s->theCache).clear();   // Compiled expressions refer to dictionary entries
   (s->theDictionary).erase(sss[npar]+string(pointer,n));
 }
 
 //---------------------------------------------------------------------------
 void Evaluator::clear() {
   Struct * s = reinterpret_cast<Struct*>(p);
+  std::lock_guard<std::shared_timed_mutex> lock(s->theLock);
+  s->theCache.clear();
   s->theDictionary.clear();
   s->theExpression = 0;
   s->thePosition   = 0;
@@ -21,6 +21,8 @@
 
 #include <set>
 #include <string>
+#include <vector>
+#include <cstddef>
 
 
 namespace dd4hep {
@@ -68,12 +70,51 @@ namespace dd4hep {
       Position position(const CellID& cellID) const;
 
 
+      /** Hit-rate counters of the per-thread navigation cache used by cellID(Position).
+       */
+      struct NavigationCacheCounters {
+	/// Total number of queries
+	unsigned long queries{} ;
+	/// Point inside the last matched sensitive placement: no navigation needed
+	unsigned long same{} ;
+	/// Point inside a sibling of the last matched placement: mother volIDs reused
+	unsigned long siblings{} ;
+	/// Full navigation and volumeID reconstruction required
+	unsigned long misses{} ;
+      };
+
       /** Return the global cellID for the given global position.
-       *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  Every thread uses its private TGeoNavigator, which is kept in the last matched
+       *  sensitive placement. Queries inside this placement or one of its siblings avoid
+       *  the expensive parts of the lookup, hence spatially clustered queries are fast.
+       *  Note: for concurrent use TGeoManager::SetMaxThreads must have been called.
        */
       CellID cellID(const Position& global) const;
 
+      /** Access the navigation cache counters of the calling thread.
+       */
+      NavigationCacheCounters navigationCacheCounters() const ;
+
+      /** Invalidate the navigation cache of the calling thread and reset its counters.
+       */
+      void resetNavigationCache() const ;
+
+
+      /** Batched version of position(): compute the global positions of n cellIDs.
+       *  The cells are grouped by their volume manager context. Readout, segmentation
+       *  and the combined transformation to the global frame are resolved once per
+       *  group and the transformation is applied to the whole group in one loop.
+       *  The result for cells[i] is stored in out[i].
+       */
+      void positions(const CellID* cells, std::size_t n, Position* out) const;
+
+      /** Batched version of cellID(): compute the cellIDs of n global positions.
+       *  Uses the navigation cache of cellID(Position), hence spatially ordered input
+       *  is handled most efficiently.
+       *  The result for global[i] is stored in out[i].
+       */
+      void cellIDs(const Position* global, std::size_t n, CellID* out) const;
+
 
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
@@ -0,0 +1,161 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DD4HEP_DDREC_MATERIALMAP_H
+#define DD4HEP_DDREC_MATERIALMAP_H
+
+// Framework include files
+#include "DDRec/Vector3D.h"
+
+// C/C++ include files
+#include <string>
+#include <cstddef>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Forward declarations
+  class Detector;
+
+  /// Namespace for the reconstruction part of the AIDA detector description toolkit
+  namespace rec {
+
+    /// Voxelized map of averaged material properties for fast material lookups
+    /**
+     *  The map divides a cartesian (x-y-z) or cylindrical (r-phi-z) volume into
+     *  cells holding the averaged material of the cell: the inverse radiation
+     *  length, the inverse nuclear interaction length and the density.
+     *  A cylindrical map with a single phi cell is an r-z map.
+     *
+     *  The map is built once with MaterialManager scans and stored in a
+     *  file, which is memory mapped when loaded. Queries do not navigate
+     *  the geometry: the integral of the material along a straight line
+     *  costs a few operations per traversed cell, independent of the
+     *  complexity of the geometry. All queries are const and may be used
+     *  concurrently by several threads.
+     *
+     *  Units in the file and in the queries: lengths in cm, density in g/cm3.
+     *
+     *  Plugins:
+     *  - DD4hep_MaterialMapBuilder:    build the map of a detector description and write it
+     *  - DD4hep_MaterialMapLoader:     load a map and attach it to the detector description as extension
+     *  - DD4hep_MaterialMapValidation: compare map integrals against exact scans (MaterialScan)
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_REC
+     */
+    class MaterialMap  {
+    public:
+      /// Coordinate system of the grid
+      enum GridType { CARTESIAN = 0, CYLINDRICAL = 1 };
+      /// Header of the material map file
+      struct Header  {
+        char          magic[8];
+        unsigned int  version;
+        unsigned int  grid;
+        unsigned int  cells[3];
+        unsigned int  spare;
+        double        lower[3];
+        double        step[3];
+      };
+      /// Averaged material of a grid cell
+      struct Cell  {
+        /// Inverse radiation length [1/cm]
+        float inv_x0;
+        /// Inverse nuclear interaction length [1/cm]
+        float inv_lambda;
+        /// Density [g/cm3]
+        float density;
+      };
+      /// Material integrated along a straight line
+      struct Integral  {
+        /// Path length [cm]
+        double length        { 0e0 };
+        /// Path length in units of the radiation length
+        double x_over_x0     { 0e0 };
+        /// Path length in units of the nuclear interaction length
+        double x_over_lambda { 0e0 };
+        /// Integrated density [g/cm2]
+        double mass          { 0e0 };
+      };
+
+    protected:
+      /// Grid type
+      int            m_grid;
+      /// Number of cells per axis
+      unsigned int   m_cells[3];
+      /// Lower edge of the grid per axis
+      double         m_lower[3];
+      /// Cell size per axis
+      double         m_step[3];
+      /// Inverse cell size per axis
+      double         m_invStep[3];
+      /// Flag if the phi axis of a cylindrical grid covers the full circle
+      bool           m_periodic;
+      /// Cell values in natural order: (i*ny + j)*nz + k
+      const Cell*    m_values;
+      /// Memory mapped file
+      void*          m_mapping;
+      /// Size of the memory mapped file
+      std::size_t    m_mappingSize;
+
+      /// Grid coordinates (x,y,z or r,phi,z) of a position
+      void coordinates(const Vector3D& pos, double* coord)  const;
+
+    public:
+      /// Default constructor
+      MaterialMap();
+      /// No copy constructor
+      MaterialMap(const MaterialMap& copy) = delete;
+      /// Default destructor
+      virtual ~MaterialMap();
+      /// No assignment operator
+      MaterialMap& operator=(const MaterialMap& copy) = delete;
+
+      /// Load the material map from file
+      void load(const std::string& file_name);
+      /// Build the material map of a detector description and write it to file
+      /** Every row of cells along the first axis (x or r) is scanned with
+       *  samples x samples lines distributed over the cross section of the cells.
+       *  For cylindrical grids at least phi_samples lines are distributed over
+       *  the full circle: a r-z map has one single phi cell, which would
+       *  otherwise be sampled in very few directions only.
+       *  The materials found in each cell are averaged with
+       *  MaterialManager::createAveragedMaterial.
+       */
+      static void build(Detector& description,
+                        const std::string& file_name,
+                        int grid,
+                        const unsigned int cells[3],
+                        const double lower[3],
+                        const double upper[3],
+                        unsigned int samples = 2,
+                        unsigned int phi_samples = 32);
+
+      /// Access the grid type
+      int grid()  const                      {  return m_grid;         }
+      /// Number of cells along an axis
+      unsigned int cells(int axis)  const    {  return m_cells[axis];  }
+      /// Lower edge of the grid along an axis
+      double lower(int axis)  const          {  return m_lower[axis];  }
+      /// Upper edge of the grid along an axis
+      double upper(int axis)  const          {  return m_lower[axis] + m_cells[axis]*m_step[axis];  }
+      /// Access the cell containing a position. Returns 0 outside the grid
+      const Cell* cellAt(const Vector3D& pos)  const;
+      /// Integrate the material along the straight line between two points
+      /** Regions outside the grid contribute to the path length, but not to the material. */
+      Integral integrate(const Vector3D& p0, const Vector3D& p1)  const;
+    };
+  }    // End namespace rec
+}      // End namespace dd4hep
+#endif // DD4HEP_DDREC_MATERIALMAP_H
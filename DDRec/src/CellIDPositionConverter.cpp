@@ -17,6 +17,10 @@
 #include "DD4hep/detail/VolumeManagerInterna.h"
 
 #include "TGeoManager.h"
+#include "TGeoNavigator.h"
+
+#include <memory>
+#include <algorithm>
 
 namespace dd4hep {
   namespace rec {
@@ -84,47 +88,221 @@ namespace dd4hep {
 
 
 
+    namespace {
+
+      /// Per-thread navigation state used by cellID(Position)
+      /**  Every thread owns its private TGeoNavigator. The navigator stays positioned
+       *   in the last matched sensitive placement. Queries inside this placement are
+       *   served without navigation; for all other queries the navigator searches
+       *   upwards from the last placement first, i.e. siblings are found before
+       *   the search restarts from the world volume.
+       */
+      struct NavigationCache {
+	typedef CellIDPositionConverter::NavigationCacheCounters Counters ;
+
+	/// Geometry the navigator belongs to
+	TGeoManager*                   geoManager = nullptr ;
+	/// Private navigator of this thread
+	std::unique_ptr<TGeoNavigator> navigator ;
+	/// Flag if the navigator points to a valid sensitive placement
+	bool                           valid = false ;
+	/// Flag if the mother encoding below is valid
+	bool                           motherValid = false ;
+	/// Mother placements (excluding the world) of the last match
+	std::vector<const TGeoNode*>   mothers ;
+	/// Encoded volIDs of the mother placements of the last match
+	VolumeID                       motherID = 0 ;
+	/// Full volumeID of the last match
+	VolumeID                       volumeID = 0 ;
+	/// Sensitive volume of the last match
+	const TGeoVolume*              volume = nullptr ;
+	/// Readout of the last match
+	Readout                        readout ;
+	/// Segmentation of the last match
+	Segmentation                   segmentation ;
+	/// Hit-rate counters
+	Counters                       counters ;
+
+	/// Attach the cache to a geometry
+	void attach( TGeoManager* mgr ) {
+	  if( mgr != geoManager ) {
+	    geoManager = mgr ;
+	    navigator.reset( new TGeoNavigator( mgr ) ) ;
+	    navigator->BuildCache( kTRUE, kFALSE ) ;
+	    navigator->CdTop() ;
+	    invalidate() ;
+	  }
+	}
+
+	/// Invalidate the cached placement
+	void invalidate() {
+	  valid       = false ;
+	  motherValid = false ;
+	  volume      = nullptr ;
+	}
+
+	/// Locate the point and update the cached volumeID. Returns false if not in a sensitive placement
+	bool locate( const double g[3] ) {
+	  TGeoNavigator* nav = navigator.get() ;
+	  ++counters.queries ;
+
+	  if( valid && nav->IsSameLocation( g[0], g[1], g[2], kFALSE ) ) {
+	    ++counters.same ;
+	    return true ;
+	  }
+	  valid = false ;
+	  PlacedVolume pv = nav->FindNode( g[0], g[1], g[2] ) ;
+
+	  if( !( pv.isValid() && pv.volume().isSensitive() ) ) {
+	    ++counters.misses ;
+	    return false ;
+	  }
+	  if( pv.volume().ptr() != volume ) {
+	    SensitiveDetector sd = pv.volume().sensitiveDetector();
+	    volume       = pv.volume().ptr() ;
+	    readout      = sd.readout() ;
+	    segmentation = readout.segmentation() ;
+	    motherValid  = false ;  // different IDDescriptor: mother encoding must be redone
+	  }
+	  // the mother placements excluding the world: levels 1 ... level-1
+	  const int level = nav->GetLevel() ;
+	  bool siblings = motherValid && int(mothers.size()) == level - 1 ;
+	  for( int up = 1 ; siblings && up < level ; ++up )
+	    siblings = ( mothers[up-1] == nav->GetMother( up ) ) ;
+
+	  if( siblings ) {
+	    ++counters.siblings ;
+	  }
+	  else {
+	    ++counters.misses ;
+	    PlacedVolume::VolIDs volIDs ;
+	    mothers.clear() ;
+	    for( int up = 1 ; up < level ; ++up ) {
+	      PlacedVolume mPv = nav->GetMother( up ) ;
+	      mothers.emplace_back( mPv.ptr() ) ;
+	      volIDs.insert( std::end(volIDs), std::begin(mPv.volIDs()), std::end(mPv.volIDs())) ;
+	    }
+	    motherID    = readout.idSpec().encode( volIDs ) ;
+	    motherValid = true ;
+	  }
+	  volumeID = motherID | readout.idSpec().encode( pv.volIDs() ) ;
+	  valid    = true ;
+	  return true ;
+	}
+
+	/// Compute the cellID of the point located last
+	CellID cellID( const Position& global, const double g[3] ) const {
+	  double l[3] ;
+	  navigator->GetCurrentMatrix()->MasterToLocal( g, l ) ;
+	  return segmentation.cellID( Position( l[0], l[1], l[2] ) , global, volumeID ) ;
+	}
+      } ;
+
+      /// The navigation cache of the calling thread
+      thread_local NavigationCache s_navigationCache ;
+
+      /// Access the navigation cache of the calling thread attached to the given geometry
+      NavigationCache& navigationCache( const Detector* description ) {
+	NavigationCache& cache = s_navigationCache ;
+	cache.attach( description->world().volume()->GetGeoManager() ) ;
+	return cache ;
+      }
+    }
+
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
-      CellID result(0) ;
-      
-      TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
-      
-      PlacedVolume pv = geoManager->FindNode( global.x() , global.y() , global.z() ) ;
-      
-      if(  pv.isValid() && pv.volume().isSensitive() ) {
+      NavigationCache& cache = navigationCache( _description ) ;
 
-	TGeoHMatrix*  m = geoManager->GetCurrentMatrix() ;
-      
-	double g[3], l[3] ;
-	global.GetCoordinates( g ) ;
-	m->MasterToLocal( g, l );
+      double g[3] ;
+      global.GetCoordinates( g ) ;
 
-	SensitiveDetector sd = pv.volume().sensitiveDetector();
-	Readout r = sd.readout() ;
-	
-	// collect all volIDs for the current path
-	PlacedVolume::VolIDs volIDs ;
-	volIDs.insert( std::end(volIDs), std::begin(pv.volIDs()), std::end(pv.volIDs())) ;
+      if( cache.locate( g ) )
+	return cache.cellID( global, g ) ;
 
-	TGeoPhysicalNode pN( geoManager->GetPath() ) ; 
-	
-	unsigned motherCount = 0 ;
+      return CellID(0) ;
+    }
 
-	while( pN.GetMother( motherCount ) != NULL   ){
 
-	    PlacedVolume mPv = pN.GetMother( motherCount++ ) ;
-	    
-	    if( mPv.isValid() &&  pN.GetMother( motherCount ) != NULL )  // world has no volIDs
-	      volIDs.insert( std::end(volIDs), std::begin(mPv.volIDs()), std::end(mPv.volIDs())) ;
+    CellIDPositionConverter::NavigationCacheCounters
+    CellIDPositionConverter::navigationCacheCounters() const {
+      return s_navigationCache.counters ;
+    }
+
+
+    void CellIDPositionConverter::resetNavigationCache() const {
+      s_navigationCache.invalidate() ;
+      s_navigationCache.counters = NavigationCacheCounters() ;
+    }
+
+
+    void CellIDPositionConverter::positions(const CellID* cells, std::size_t n, Position* out) const {
+
+      // resolve the context of every cell and group the cells by context
+      std::vector< std::pair<const VolumeManagerContext*, std::size_t> > order( n ) ;
+      for( std::size_t i = 0 ; i < n ; ++i )
+	order[i] = std::make_pair( findContext( cells[i] ), i ) ;
+
+      std::sort( order.begin(), order.end() ) ;
+
+      std::vector<double> lx, ly, lz ;
+
+      for( std::size_t beg = 0, end = 0 ; beg < n ; beg = end ) {
+
+	const VolumeManagerContext* context = order[beg].first ;
+
+	for( end = beg + 1 ; end < n && order[end].first == context ; ++end ) ;
+
+	if( context == NULL ) {
+	  for( std::size_t k = beg ; k < end ; ++k )
+	    out[ order[k].second ] = Position() ;
+	  continue ;
 	}
-	
-	VolumeID volIDPVs = r.idSpec().encode( volIDs ) ;
-	
-	result = r.segmentation().cellID( Position( l[0], l[1], l[2] ) , global, volIDPVs  );
+
+	// per group: one readout search and one combined volume-to-global transformation
+	DetElement det = context->element ;
+	Segmentation seg = findReadout( det ).segmentation() ;
+
+	TGeoHMatrix trafo( det.nominal().worldTransformation() ) ;
+	trafo.Multiply( &context->toElement() ) ;
+	const double* rot = trafo.GetRotationMatrix() ;
+	const double* tr  = trafo.GetTranslation() ;
+
+	const std::size_t len = end - beg ;
+	lx.resize( len ) ; ly.resize( len ) ; lz.resize( len ) ;
+
+	// local positions: one segmentation call per cell
+	for( std::size_t k = 0 ; k < len ; ++k ) {
+	  Position local = seg.position( cells[ order[beg+k].second ] ) ;
+	  lx[k] = local.x() ; ly[k] = local.y() ; lz[k] = local.z() ;
+	}
+
+	// apply the transformation to the whole group in one tight loop
+	const double r0 = rot[0], r1 = rot[1], r2 = rot[2] ;
+	const double r3 = rot[3], r4 = rot[4], r5 = rot[5] ;
+	const double r6 = rot[6], r7 = rot[7], r8 = rot[8] ;
+	const double t0 = tr[0],  t1 = tr[1],  t2 = tr[2] ;
+	for( std::size_t k = 0 ; k < len ; ++k ) {
+	  const double x = lx[k], y = ly[k], z = lz[k] ;
+	  lx[k] = t0 + r0 * x + r1 * y + r2 * z ;
+	  ly[k] = t1 + r3 * x + r4 * y + r5 * z ;
+	  lz[k] = t2 + r6 * x + r7 * y + r8 * z ;
+	}
+
+	for( std::size_t k = 0 ; k < len ; ++k )
+	  out[ order[beg+k].second ] = Position( lx[k], ly[k], lz[k] ) ;
+      }
+    }
+
+
+    void CellIDPositionConverter::cellIDs(const Position* global, std::size_t n, CellID* out) const {
+
+      NavigationCache& cache = navigationCache( _description ) ;
+
+      for( std::size_t i = 0 ; i < n ; ++i ) {
+	double g[3] ;
+	global[i].GetCoordinates( g ) ;
+	out[i] = cache.locate( g ) ? cache.cellID( global[i], g ) : CellID(0) ;
       }
-	
-      return result ;
     }
 
     // CellID CellIDPositionConverter::cellID(const Position& global) const {
@@ -0,0 +1,350 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDRec/MaterialMap.h"
+#include "DDRec/MaterialManager.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+
+// C/C++ include files
+#include <cmath>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+namespace {
+  const char MATERIAL_MAP_MAGIC[8] = { 'D','D','4','h','e','p','M','M' };
+  const double TWO_PI = 2e0 * M_PI;
+  /// Per-thread buffer of the cell boundary crossings of a line (avoids allocations per query)
+  thread_local vector<double> s_crossings;
+
+  /// Add the crossings of a line with equidistant planes c = lower + b*step, b = 0...n
+  void add_planes(vector<double>& t, double c0, double dc, double lower, double step, double inv_step, unsigned int n)  {
+    if ( dc == 0e0 ) return;
+    double lo = std::min(c0, c0+dc), hi = std::max(c0, c0+dc);
+    long   b0 = std::max(0L, long(std::ceil((lo - lower) * inv_step)));
+    long   b1 = std::min(long(n), long(std::floor((hi - lower) * inv_step)));
+    for( long b = b0; b <= b1; ++b )   {
+      double tb = (lower + double(b)*step - c0) / dc;
+      if ( tb > 0e0 && tb < 1e0 ) t.push_back(tb);
+    }
+  }
+
+  /// Add the crossing of a line with the half-plane at angle phi containing the z-axis
+  void add_half_plane(vector<double>& t, const Vector3D& p0, const Vector3D& d, double phi)  {
+    double s = std::sin(phi), c = std::cos(phi);
+    double denom = d.x()*s - d.y()*c;
+    if ( denom == 0e0 ) return;
+    double tb = (p0.y()*c - p0.x()*s) / denom;
+    if ( tb > 0e0 && tb < 1e0 && (p0.x()+tb*d.x())*c + (p0.y()+tb*d.y())*s > 0e0 )
+      t.push_back(tb);
+  }
+
+  /// Write the material map file
+  void write_map(const string& file_name, int grid, const unsigned int cells[3],
+                 const double lower[3], const double step[3],
+                 const vector<MaterialMap::Cell>& values)
+  {
+    MaterialMap::Header hdr;
+    ::memset(&hdr, 0, sizeof(hdr));
+    ::memcpy(hdr.magic, MATERIAL_MAP_MAGIC, sizeof(hdr.magic));
+    hdr.version = 1;
+    hdr.grid    = grid;
+    for( int i = 0; i < 3; ++i )   {
+      hdr.cells[i] = cells[i];
+      hdr.lower[i] = lower[i];
+      hdr.step[i]  = step[i];
+    }
+    FILE* file = ::fopen(file_name.c_str(), "wb");
+    bool  ok   = file != 0;
+    ok = ok && ::fwrite(&hdr, sizeof(hdr), 1, file) == 1;
+    ok = ok && ::fwrite(&values[0], sizeof(MaterialMap::Cell), values.size(), file) == values.size();
+    if ( file ) ok = (0 == ::fclose(file)) && ok;
+    if ( !ok )   {
+      except("MaterialMap","+++ Failed to write material map %s: %s", file_name.c_str(), ::strerror(errno));
+    }
+  }
+}
+
+/// Default constructor
+MaterialMap::MaterialMap()
+  : m_grid(CARTESIAN), m_periodic(false), m_values(0), m_mapping(0), m_mappingSize(0)
+{
+  for( int i = 0; i < 3; ++i )  {
+    m_cells[i] = 0;
+    m_lower[i] = m_step[i] = m_invStep[i] = 0e0;
+  }
+}
+
+/// Default destructor
+MaterialMap::~MaterialMap()   {
+  if ( m_mapping ) ::munmap(m_mapping, m_mappingSize);
+  m_mapping = 0;
+  m_values  = 0;
+}
+
+/// Load the material map from file
+void MaterialMap::load(const string& file_name)   {
+  struct stat info;
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &info) != 0 )   {
+    if ( fd >= 0 ) ::close(fd);
+    except("MaterialMap","+++ Failed to open material map %s: %s", file_name.c_str(), ::strerror(errno));
+  }
+  size_t len = info.st_size;
+  void*  ptr = len >= sizeof(Header) ? ::mmap(0, len, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if ( ptr == MAP_FAILED )   {
+    except("MaterialMap","+++ Failed to map material map %s: %s", file_name.c_str(),
+           len < sizeof(Header) ? "File too short" : ::strerror(errno));
+  }
+  const Header* hdr = (const Header*)ptr;
+  // Number of cells in 64 bit with overflow check. Empty grids and overflows give 0
+  size_t num_cells = 1, expected = 0;
+  bool   valid_grid = true;
+  for( int i = 0; i < 3; ++i )   {
+    size_t n = hdr->cells[i];
+    valid_grid &= n > 0 && num_cells <= (SIZE_MAX - sizeof(Header)) / sizeof(Cell) / n;
+    valid_grid &= hdr->step[i] > 0e0;   // Also rejects NaN
+    num_cells  = valid_grid ? num_cells * n : 0;
+  }
+  if ( valid_grid ) expected = sizeof(Header) + num_cells * sizeof(Cell);
+  if ( ::memcmp(hdr->magic, MATERIAL_MAP_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != 1 ||
+       hdr->grid > CYLINDRICAL || !valid_grid || len != expected )   {
+    ::munmap(ptr, len);
+    except("MaterialMap","+++ Invalid material map file %s [size: %ld bytes, expected: %ld bytes]",
+           file_name.c_str(), len, expected);
+  }
+  if ( m_mapping ) ::munmap(m_mapping, m_mappingSize);
+  m_mapping     = ptr;
+  m_mappingSize = len;
+  m_grid        = hdr->grid;
+  m_values      = (const Cell*)(hdr+1);
+  for( int i = 0; i < 3; ++i )   {
+    m_cells[i]   = hdr->cells[i];
+    m_lower[i]   = hdr->lower[i];
+    m_step[i]    = hdr->step[i];
+    m_invStep[i] = 1e0 / hdr->step[i];
+  }
+  m_periodic = m_grid == CYLINDRICAL && m_cells[1]*m_step[1] >= TWO_PI*(1e0-1e-9);
+  printout(INFO,"MaterialMap","+++ Loaded %s material map %s with %u x %u x %u cells.",
+           m_grid == CYLINDRICAL ? "cylindrical" : "cartesian", file_name.c_str(),
+           m_cells[0], m_cells[1], m_cells[2]);
+}
+
+/// Grid coordinates (x,y,z or r,phi,z) of a position
+void MaterialMap::coordinates(const Vector3D& pos, double* coord)  const   {
+  if ( m_grid == CARTESIAN )   {
+    coord[0] = pos.x();
+    coord[1] = pos.y();
+  }
+  else   {
+    coord[0] = std::sqrt(pos.x()*pos.x() + pos.y()*pos.y());
+    // r-z maps: the phi coordinate is irrelevant. Save the atan2
+    coord[1] = (m_periodic && m_cells[1] == 1) ? m_lower[1] : std::atan2(pos.y(), pos.x());
+  }
+  coord[2] = pos.z();
+}
+
+/// Access the cell containing a position. Returns 0 outside the grid
+const MaterialMap::Cell* MaterialMap::cellAt(const Vector3D& pos)  const   {
+  double coord[3];
+  long   idx[3];
+  coordinates(pos, coord);
+  for( int a = 0; a < 3; ++a )   {
+    double u = std::floor((coord[a] - m_lower[a]) * m_invStep[a]);
+    if ( a == 1 && m_periodic )   {
+      u -= double(m_cells[1]) * std::floor(u / double(m_cells[1]));
+    }
+    if ( !(u >= 0e0 && u < double(m_cells[a])) ) return 0;
+    idx[a] = long(u);
+  }
+  return m_values + (size_t(idx[0])*m_cells[1] + idx[1])*m_cells[2] + idx[2];
+}
+
+/// Integrate the material along the straight line between two points
+MaterialMap::Integral MaterialMap::integrate(const Vector3D& p0, const Vector3D& p1)  const   {
+  Integral result;
+  Vector3D d = p1 - p0;
+  result.length = d.r();
+  if ( !m_values || result.length <= 0e0 ) return result;
+
+  // The cells are convex in the grid coordinates: the line is split at all cell
+  // boundaries and each piece contributes with the material of its cell.
+  vector<double>& t = s_crossings;
+  t.clear();
+  t.push_back(0e0);
+  t.push_back(1e0);
+  add_planes(t, p0.z(), d.z(), m_lower[2], m_step[2], m_invStep[2], m_cells[2]);
+  if ( m_grid == CARTESIAN )   {
+    add_planes(t, p0.x(), d.x(), m_lower[0], m_step[0], m_invStep[0], m_cells[0]);
+    add_planes(t, p0.y(), d.y(), m_lower[1], m_step[1], m_invStep[1], m_cells[1]);
+  }
+  else   {
+    // Radial boundaries: r(t)^2 = a*t^2 + b*t + c
+    double a = d.x()*d.x() + d.y()*d.y();
+    double b = 2e0*(p0.x()*d.x() + p0.y()*d.y());
+    double c = p0.x()*p0.x() + p0.y()*p0.y();
+    if ( a > 0e0 )   {
+      double t_min = std::min(std::max(-b/(2e0*a), 0e0), 1e0);
+      double r_min = std::sqrt(std::max(0e0, (a*t_min + b)*t_min + c));
+      double r_max = std::sqrt(std::max(c, a + b + c));
+      long   b0 = std::max(0L, long(std::ceil((r_min - m_lower[0]) * m_invStep[0])));
+      long   b1 = std::min(long(m_cells[0]), long(std::floor((r_max - m_lower[0]) * m_invStep[0])));
+      for( long i = b0; i <= b1; ++i )   {
+        double r = m_lower[0] + double(i)*m_step[0];
+        double disc = b*b - 4e0*a*(c - r*r);
+        if ( disc < 0e0 ) continue;
+        double sq = std::sqrt(disc);
+        double t1 = (-b - sq) / (2e0*a), t2 = (-b + sq) / (2e0*a);
+        if ( t1 > 0e0 && t1 < 1e0 ) t.push_back(t1);
+        if ( t2 > 0e0 && t2 < 1e0 ) t.push_back(t2);
+      }
+      // Closest approach to the axis: phi flips if the line crosses the axis
+      if ( t_min > 0e0 && t_min < 1e0 ) t.push_back(t_min);
+      if ( !(m_periodic && m_cells[1] == 1) )   {
+        double cross = p0.x()*d.y() - p0.y()*d.x();
+        if ( m_periodic && cross != 0e0 )   {
+          // phi changes monotonically along the line: only visit the boundaries in the swept range
+          double phi0  = std::atan2(p0.y(), p0.x());
+          double sweep = std::atan2(p1.y(), p1.x()) - phi0;
+          if ( cross > 0e0 && sweep < 0e0 ) sweep += TWO_PI;
+          if ( cross < 0e0 && sweep > 0e0 ) sweep -= TWO_PI;
+          double lo = std::min(phi0, phi0+sweep), hi = std::max(phi0, phi0+sweep);
+          long   n0 = long(std::ceil((lo - m_lower[1]) * m_invStep[1]));
+          long   n1 = long(std::floor((hi - m_lower[1]) * m_invStep[1]));
+          for( long i = n0; i <= n1; ++i )
+            add_half_plane(t, p0, d, m_lower[1] + double(i)*m_step[1]);
+        }
+        else if ( !m_periodic )   {
+          for( unsigned int i = 0; i <= m_cells[1]; ++i )
+            add_half_plane(t, p0, d, m_lower[1] + double(i)*m_step[1]);
+        }
+      }
+    }
+  }
+  std::sort(t.begin(), t.end());
+  for( size_t i = 1; i < t.size(); ++i )   {
+    double dt = t[i] - t[i-1];
+    if ( dt <= 0e0 ) continue;
+    const Cell* cell = cellAt(p0 + (0.5*(t[i] + t[i-1]))*d);
+    if ( cell )   {
+      double len = dt * result.length;
+      result.x_over_x0     += len * cell->inv_x0;
+      result.x_over_lambda += len * cell->inv_lambda;
+      result.mass          += len * cell->density;
+    }
+  }
+  return result;
+}
+
+/// Build the material map of a detector description and write it to file
+void MaterialMap::build(Detector&          description,
+                        const string&      file_name,
+                        int                grid,
+                        const unsigned int cells[3],
+                        const double       lower[3],
+                        const double       upper[3],
+                        unsigned int       samples,
+                        unsigned int       phi_samples)
+{
+  double step[3];
+  for( int i = 0; i < 3; ++i )   {
+    if ( cells[i] == 0 || !(upper[i] > lower[i]) )   {
+      except("MaterialMap","+++ Invalid material map grid: axis %d has %u cells in [%g, %g].",
+             i, cells[i], lower[i], upper[i]);
+    }
+    step[i] = (upper[i] - lower[i]) / double(cells[i]);
+  }
+  if ( grid != CARTESIAN && grid != CYLINDRICAL )   {
+    except("MaterialMap","+++ Invalid material map grid type: %d.", grid);
+  }
+  if ( grid == CYLINDRICAL && lower[0] < 0e0 )   {
+    except("MaterialMap","+++ Invalid cylindrical material map grid: negative radius %g.", lower[0]);
+  }
+  samples = std::max(samples, 1u);
+  // Scans per cell along the second axis: phi of cylindrical grids is sampled over the full circle
+  unsigned int samples_1 = samples;
+  if ( grid == CYLINDRICAL )   {
+    samples_1 = std::max(samples, (phi_samples + cells[1] - 1) / cells[1]);
+  }
+
+  MaterialManager     mgr(description.world().volume());
+  vector<Cell>        values(size_t(cells[0]) * cells[1] * cells[2]);
+  vector<MaterialVec> row(cells[0]);
+  size_t              num_lines = 0, num_failed = 0;
+
+  // Each row of cells along the first axis is scanned with a few long lines:
+  // the traversed materials are distributed to the cells along the line.
+  for( unsigned int j = 0; j < cells[1]; ++j )   {
+    for( unsigned int k = 0; k < cells[2]; ++k )   {
+      for( auto& r : row ) r.clear();
+      for( unsigned int u = 0; u < samples_1; ++u )   {
+        for( unsigned int v = 0; v < samples; ++v )   {
+          double   c1 = lower[1] + (double(j) + (double(u)+0.5)/double(samples_1)) * step[1];
+          double   c2 = lower[2] + (double(k) + (double(v)+0.5)/double(samples)) * step[2];
+          Vector3D p0(lower[0], c1, c2), p1(upper[0], c1, c2);
+          if ( grid == CYLINDRICAL )   {
+            p0 = Vector3D(lower[0]*std::cos(c1), lower[0]*std::sin(c1), c2);
+            p1 = Vector3D(upper[0]*std::cos(c1), upper[0]*std::sin(c1), c2);
+          }
+          ++num_lines;
+          try   {
+            const MaterialVec& materials = mgr.materialsBetween(p0, p1, 0e0);
+            double s = 0e0;
+            for( const auto& m : materials )   {
+              double s1 = s + m.second;
+              for( size_t i = size_t(s / step[0]); i < cells[0] && double(i)*step[0] < s1; ++i )   {
+                double overlap = std::min(s1, double(i+1)*step[0]) - std::max(s, double(i)*step[0]);
+                if ( overlap > 0e0 ) row[i].emplace_back(m.first, overlap);
+              }
+              s = s1;
+            }
+          }
+          catch(const exception& e)   {
+            printout(DEBUG,"MaterialMap","+++ Scan (%g,%g,%g) -> (%g,%g,%g) failed: %s",
+                     p0.x(), p0.y(), p0.z(), p1.x(), p1.y(), p1.z(), e.what());
+            ++num_failed;
+          }
+        }
+      }
+      for( unsigned int i = 0; i < cells[0]; ++i )   {
+        Cell& cell = values[(size_t(i)*cells[1] + j)*cells[2] + k];
+        cell.inv_x0 = cell.inv_lambda = cell.density = 0.f;
+        if ( !row[i].empty() )   {
+          MaterialData avg = mgr.createAveragedMaterial(row[i]);
+          cell.inv_x0     = float(1e0 / avg.radiationLength());
+          cell.inv_lambda = float(1e0 / avg.interactionLength());
+          cell.density    = float(avg.density());
+        }
+      }
+    }
+  }
+  write_map(file_name, grid, cells, lower, step, values);
+  printout(INFO,"MaterialMap","+++ Wrote %s material map %s with %u x %u x %u cells [%ld scans, %ld failed].",
+           grid == CYLINDRICAL ? "cylindrical" : "cartesian", file_name.c_str(),
+           cells[0], cells[1], cells[2], num_lines, num_failed);
+}
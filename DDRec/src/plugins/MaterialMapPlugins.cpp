@@ -0,0 +1,252 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDRec/MaterialMap.h"
+#include "DDRec/MaterialScan.h"
+
+// C/C++ include files
+#include <cmath>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::rec;
+
+namespace {
+  /// Check if a command line argument is a value (numbers may be negative) and not an option
+  bool is_value(const char* arg)   {
+    return arg && (arg[0] != '-' || ::isdigit(arg[1]) || arg[1] == '.');
+  }
+}
+
+/// Plugin to build the material map of the detector description and write it to file
+/**
+ *  Factory: DD4hep_MaterialMapBuilder
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    17/10/2026
+ */
+static long build_material_map(Detector& description, int argc, char** argv) {
+  string output, grid;
+  vector<string> cells, lower, upper;
+  unsigned int samples = 2, phi_samples = 32;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-output",argv[i],4) )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-grid",argv[i],4) )
+      grid = argv[++i];
+    else if ( 0 == ::strncmp("-samples",argv[i],4) )
+      samples = _toInt(argv[++i]);
+    else if ( 0 == ::strncmp("-phi_samples",argv[i],5) )
+      phi_samples = _toInt(argv[++i]);
+    else if ( 0 == ::strncmp("-cells",argv[i],4) )
+      while( i+1 < argc && is_value(argv[i+1]) ) cells.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-lower",argv[i],4) )
+      while( i+1 < argc && is_value(argv[i+1]) ) lower.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-upper",argv[i],4) )
+      while( i+1 < argc && is_value(argv[i+1]) ) upper.emplace_back(argv[++i]);
+  }
+  // xyz: 3 axes. rphiz, rz: r and z limits, phi covers the full circle
+  size_t num = grid == "xyz" ? 3 : 2;
+  bool   ok  = !output.empty() && (grid == "xyz" || grid == "rz" || grid == "rphiz") &&
+    cells.size() == (grid == "rz" ? 2 : 3) && lower.size() == num && upper.size() == num;
+  if ( !ok )   {
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_MaterialMapBuilder                       \n"
+      "     -output  <string>        Output file name.                               \n"
+      "     -grid    xyz|rz|rphiz    Grid type.                                      \n"
+      "     -cells   <n> <n> [<n>]   Number of cells: x y z | r z | r phi z          \n"
+      "     -lower   <l> <l> [<l>]   Lower grid limits: x y z | r z                  \n"
+      "     -upper   <l> <l> [<l>]   Upper grid limits: x y z | r z                  \n"
+      "     -samples <number>        Number of scans per cell and axis [default: 2]  \n"
+      "     -phi_samples <number>    Minimum number of scans over the full circle    \n"
+      "                              for rz and rphiz grids [default: 32]            \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  unsigned int n[3];
+  double lo[3], up[3];
+  if ( grid == "xyz" )   {
+    for( int i = 0; i < 3; ++i )   {
+      n[i]  = _toInt(cells[i]);
+      lo[i] = _toDouble(lower[i]);
+      up[i] = _toDouble(upper[i]);
+    }
+  }
+  else   {
+    n[0]  = _toInt(cells[0]);
+    n[1]  = grid == "rz" ? 1 : _toInt(cells[1]);
+    n[2]  = _toInt(cells.back());
+    lo[0] = _toDouble(lower[0]);
+    lo[1] = -M_PI;
+    lo[2] = _toDouble(lower[1]);
+    up[0] = _toDouble(upper[0]);
+    up[1] = M_PI;
+    up[2] = _toDouble(upper[1]);
+  }
+  MaterialMap::build(description, output, grid == "xyz" ? MaterialMap::CARTESIAN : MaterialMap::CYLINDRICAL,
+                     n, lo, up, samples, phi_samples);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_MaterialMapBuilder,build_material_map)
+
+/// Plugin to load a material map and attach it to the detector description as an extension
+/**
+ *  Factory: DD4hep_MaterialMapLoader
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    17/10/2026
+ */
+static long load_material_map(Detector& description, int argc, char** argv) {
+  string input;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+  }
+  if ( input.empty() )   {
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_MaterialMapLoader                        \n"
+      "     -input   <string>        Material map file name.                         \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  unique_ptr<MaterialMap> map(new MaterialMap());
+  map->load(input);
+  description.addExtension<MaterialMap>(map.release());
+  return 1;
+}
+DECLARE_APPLY(DD4hep_MaterialMapLoader,load_material_map)
+
+/// Plugin to validate a material map against exact material scans
+/**
+ *  Integrates the material of random straight lines inside the map volume
+ *  with the map and with MaterialScan and reports the relative deviation
+ *  of the traversed radiation and interaction lengths.
+ *
+ *  Factory: DD4hep_MaterialMapValidation
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    17/10/2026
+ */
+static long validate_material_map(Detector& description, int argc, char** argv) {
+  string input;
+  long   num_lines = 1000;
+  double tolerance = -1e0, threshold = 1e-3;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-lines",argv[i],4) )
+      num_lines = _toInt(argv[++i]);
+    else if ( 0 == ::strncmp("-tolerance",argv[i],4) )
+      tolerance = _toDouble(argv[++i]);
+    else if ( 0 == ::strncmp("-threshold",argv[i],4) )
+      threshold = _toDouble(argv[++i]);
+  }
+  if ( input.empty() || num_lines <= 0 )   {
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_MaterialMapValidation                    \n"
+      "     -input     <string>      Material map file name.                         \n"
+      "     -lines     <number>      Number of random lines to compare [1000]        \n"
+      "     -threshold <number>      Minimal X0 fraction of lines used for the       \n"
+      "                              relative errors [1e-3]                          \n"
+      "     -tolerance <number>      Maximal accepted mean relative error of X0.     \n"
+      "                              Test result printed if given.                   \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  typedef chrono::high_resolution_clock timer;
+  MaterialMap  map;
+  MaterialScan scan(description);
+  mt19937      rndm(12345);
+  uniform_real_distribution<double> flat(0e0, 1e0);
+  map.load(input);
+
+  double sum_x0 = 0e0, sum2_x0 = 0e0, max_x0 = 0e0, sum_lambda = 0e0, sum2_lambda = 0e0, max_lambda = 0e0;
+  double t_map = 0e0, t_scan = 0e0;
+  long   num_used = 0, num_failed = 0;
+  for( long n = 0; n < num_lines; ++n )   {
+    Vector3D p[2];
+    for( auto& pos : p )   {
+      double c[3];
+      for( int a = 0; a < 3; ++a ) c[a] = map.lower(a) + flat(rndm)*(map.upper(a) - map.lower(a));
+      pos = map.grid() == MaterialMap::CARTESIAN
+        ? Vector3D(c[0], c[1], c[2]) : Vector3D(c[0]*std::cos(c[1]), c[0]*std::sin(c[1]), c[2]);
+    }
+    double exact_x0 = 0e0, exact_lambda = 0e0;
+    auto   start = timer::now();
+    try  {
+      const MaterialVec& materials = scan.scan(p[0].x(), p[0].y(), p[0].z(), p[1].x(), p[1].y(), p[1].z(), 0e0);
+      for( const auto& m : materials )   {
+        exact_x0     += m.second / m.first.radLength();
+        exact_lambda += m.second / m.first.intLength();
+      }
+    }
+    catch(const exception& e)   {
+      printout(DEBUG,"MaterialMap","+++ Scan failed: %s", e.what());
+      ++num_failed;
+      continue;
+    }
+    auto middle = timer::now();
+    MaterialMap::Integral integral = map.integrate(p[0], p[1]);
+    auto stop   = timer::now();
+    t_scan += chrono::duration<double>(middle - start).count();
+    t_map  += chrono::duration<double>(stop - middle).count();
+    if ( exact_x0 < threshold ) continue;
+    double dev_x0     = (integral.x_over_x0 - exact_x0) / exact_x0;
+    double dev_lambda = (integral.x_over_lambda - exact_lambda) / exact_lambda;
+    sum_x0      += std::fabs(dev_x0);
+    sum2_x0     += dev_x0*dev_x0;
+    max_x0       = std::max(max_x0, std::fabs(dev_x0));
+    sum_lambda  += std::fabs(dev_lambda);
+    sum2_lambda += dev_lambda*dev_lambda;
+    max_lambda   = std::max(max_lambda, std::fabs(dev_lambda));
+    ++num_used;
+  }
+  long   num_scanned = num_lines - num_failed;
+  double norm = num_used > 0 ? 1e0/double(num_used) : 0e0;
+  printout(ALWAYS,"MaterialMap","+++ Compared %ld lines [%ld with X0 fraction above %g, %ld failed scans].",
+           num_lines, num_used, threshold, num_failed);
+  printout(ALWAYS,"MaterialMap","+++ Relative error X0:     mean %8.4f  rms %8.4f  max %8.4f",
+           sum_x0*norm, std::sqrt(sum2_x0*norm), max_x0);
+  printout(ALWAYS,"MaterialMap","+++ Relative error Lambda: mean %8.4f  rms %8.4f  max %8.4f",
+           sum_lambda*norm, std::sqrt(sum2_lambda*norm), max_lambda);
+  if ( num_scanned > 0 )   {
+    printout(ALWAYS,"MaterialMap","+++ Time per line: map %10.3f usec  scan %10.3f usec  [speedup %.0f]",
+             1e6*t_map/double(num_scanned), 1e6*t_scan/double(num_scanned), t_map > 0e0 ? t_scan/t_map : 0e0);
+  }
+  if ( tolerance > 0e0 )   {
+    bool passed = num_used > 0 && sum_x0*norm <= tolerance;
+    printout(ALWAYS,"MaterialMap","+++ %s Mean relative error of X0 %.4f %s tolerance %.4f",
+             passed ? "PASSED" : "FAILED", sum_x0*norm, passed ? "within" : "exceeds", tolerance);
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_MaterialMapValidation,validate_material_map)
@@ -0,0 +1,97 @@
+#include "DD4hep/DDTest.h"
+#include "DDDigi/DigiRandomGenerator.h"
+
+#include <exception>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+// this should be the first line in your test
+static DDTest test( "DigiRandomGenerator" );
+
+namespace {
+  /// Known-answer vectors of the Philox4x32-10 block function (Random123 kat_vectors)
+  struct KnownAnswer  {
+    uint32_t counter[4];
+    uint32_t key[2];
+    uint32_t result[4];
+  };
+  const KnownAnswer known_answers[] = {
+    { { 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u },
+      { 0x00000000u, 0x00000000u },
+      { 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u } },
+    { { 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu },
+      { 0xffffffffu, 0xffffffffu },
+      { 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu } },
+    { { 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u },
+      { 0xa4093822u, 0x299f31d0u },
+      { 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u } }
+  };
+}
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test Philox4x32-10 known-answer vectors" );
+
+    for( const auto& kat : known_answers )  {
+      uint32_t result[4];
+      DigiRandomGenerator::philox(kat.key, kat.counter, result);
+      for( int i = 0; i < 4; ++i )
+        test( result[i], kat.result[i], " philox4x32-10 result word " + to_string(i) );
+    }
+
+    test.log( "test the stream layout: counter = (block, event, seed high), key = (stream, seed low)" );
+
+    const uint64_t seed = 0x0123456789abcdefULL;
+    DigiRandomGenerator gen(seed, 17, 4711);
+    for( uint32_t block = 0; block < 3; ++block )  {
+      const uint32_t key[2]     = { 4711, uint32_t(seed) };
+      const uint32_t counter[4] = { block, 0, 17, uint32_t(seed >> 32) };
+      uint32_t result[4];
+      DigiRandomGenerator::philox(key, counter, result);
+      for( int i = 0; i < 4; ++i )
+        test( gen(), result[i], " stream word of block " + to_string(block) );
+    }
+
+    test.log( "test reproducibility and independence of the streams" );
+
+    DigiRandomGenerator g1(seed, 17, 4711), g2(seed, 17, 4711), g3(seed, 18, 4711);
+    vector<double> v1(1000), v2(1000), v3(1000);
+    g1.gaussian(v1.data(), v1.size());
+    g2.gaussian(v2.data(), v2.size());
+    g3.gaussian(v3.data(), v3.size());
+    test( v1 == v2, " same seed, event and stream give the same sequence " );
+    test( v1 != v3, " different events give different sequences " );
+
+    DigiRandomGenerator u1(seed, 3, 1), u2(seed, 3, 1);
+    vector<double> bulk(257);
+    u1.uniform(bulk.data(), bulk.size());
+    bool in_range = true, same = true;
+    for( size_t i = 0; i < bulk.size(); ++i )  {
+      in_range &= bulk[i] > 0e0 && bulk[i] < 1e0;
+      same &= bulk[i] == u2.uniform();
+    }
+    test( in_range, " bulk uniform values in the open interval (0,1) " );
+    test( same, " bulk and single uniform values agree " );
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -0,0 +1,109 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Detector.h"
+#include "DDDigi/DigiKernel.h"
+#include "DDDigi/DigiSignalProcessorSequence.h"
+
+#include <exception>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+// this should be the first line in your test
+static DDTest test( "DigiSignalProcessing" );
+
+namespace {
+  /// Signal processor using the single cell callback only
+  class Gain : public DigiSignalProcessor  {
+  public:
+    Gain(const DigiKernel& k) : DigiSignalProcessor(k, "Gain") {}
+    virtual double operator()(const DigiCellData& data)  const override  {
+      return 0.1 * data.raw_value;
+    }
+  };
+  /// Signal processor killing late cells
+  class TimeCut : public DigiSignalProcessor  {
+  public:
+    TimeCut(const DigiKernel& k) : DigiSignalProcessor(k, "TimeCut") {}
+    virtual double operator()(const DigiCellData& data)  const override  {
+      if ( data.delay > 50e0 ) data.kill = true;
+      return 0e0;
+    }
+  };
+  /// Signal processor with its own column loop
+  class TimeWalk : public DigiSignalProcessor  {
+  public:
+    TimeWalk(const DigiKernel& k) : DigiSignalProcessor(k, "TimeWalk") {}
+    virtual double operator()(const DigiCellData& data)  const override  {
+      return 0.01 * data.delay;
+    }
+    virtual void process(const DigiCellColumns& cells, double* result)  const override  {
+      for( size_t i = 0; i < cells.size; ++i )
+        result[i] = 0.01 * cells.delay[i];
+    }
+  };
+}
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test the column signal processing of a processor sequence" );
+
+    DigiKernel& kernel = DigiKernel::instance(Detector::getInstance());
+    DigiSignalProcessorSequence* sequence = new DigiSignalProcessorSequence(kernel, "Sequence");
+    DigiSignalProcessor* processors[] = { new Gain(kernel), new TimeCut(kernel), new TimeWalk(kernel) };
+    for( auto* p : processors )
+      sequence->adopt(p);
+
+    // More deposits than one chunk of the sequence and not a multiple of it
+    const size_t num_deposits = 1000;
+    DigiArena arena;
+    DigiDepositColumns deposits(arena, "deposits");
+    for( size_t i = 0; i < num_deposits; ++i )
+      deposits.push_back(CellID(i), 1e0 + i, 0.1 * i, Position(0e0, 0e0, double(i)));
+    test( deposits.size(), num_deposits, " number of deposits " );
+
+    vector<unsigned char> kill(num_deposits, 0);
+    vector<double> result(num_deposits, -1e0);
+    sequence->process(deposits.cellColumns(kill.data()), result.data());
+
+    bool same = true, expected = true, killed = true;
+    for( size_t i = 0; i < num_deposits; ++i )  {
+      DigiCellData data;
+      data.raw_value = deposits.deposits()[i];
+      data.delay     = deposits.times()[i];
+      double single  = (*sequence)(data);
+      bool   late    = deposits.times()[i] > 50e0;
+      double value   = late ? 0e0 : 1.1 * (1e0 + i) + 0.001 * i;
+      same     &= fabs(result[i] - single) < 1e-9;
+      expected &= fabs(result[i] - value)  < 1e-9;
+      killed   &= (kill[i] != 0) == late;
+    }
+    test( same, " column processing agrees with the single cell callback " );
+    test( expected, " column processing gives the expected signals " );
+    test( killed, " late cells are marked killed " );
+
+    sequence->release();
+    for( auto* p : processors )
+      p->release();
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
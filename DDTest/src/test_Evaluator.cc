@@ -0,0 +1,91 @@
+#include "DD4hep/DDTest.h"
+#include "Evaluator/Evaluator.h"
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cmath>
+
+using namespace std ;
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "Evaluator" ) ;
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    tools::Evaluator eval;
+    eval.setStdMath();
+    eval.setSystemOfUnits(1.e+3, 1./1.60217733e-25, 1.e+9, 1./1.60217733e-10, 1.0, 1.0, 1.0);
+    eval.setVariable("inner_radius", 12.5);
+    eval.setVariable("outer_radius", "inner_radius + 2*cm");
+
+    const char* expressions[] = {
+      "inner_radius", "-inner_radius*2 + 1", "outer_radius/2", "2^3^2", "2**3",
+      "sin(30*degree)", "pow(2, 10) - max(3, 4)", "(1 < 2) && (3 >= 3) || 0", "10*mm + 1*cm",
+      "sqrt(inner_radius*inner_radius)", "0x10"
+    };
+
+    test.log( "compiled expressions give the interpreter results" );
+    bool same = true;
+    for( const char* e : expressions )  {
+      double interpreted = eval.evaluate(e);
+      int    status      = eval.status();
+      for( int i = 0; i < 3; ++i )  {   // First call interprets, then compiled code is executed
+        stringstream os;
+        pair<int,double> result = eval.evaluate(e, os);
+        same = same && result.first == status && result.second == interpreted && os.str().empty();
+      }
+      same = same && eval.evaluate(e) == interpreted && eval.status() == status;
+    }
+    test( same, " compiled evaluation identical to interpretation " );
+
+    test.log( "cached expressions follow changes of the dictionary" );
+    eval.setVariable("inner_radius", 20.0);
+    stringstream os;
+    test( eval.evaluate("inner_radius", os).second, 20.0, " redefined variable " );
+    test( eval.evaluate("outer_radius/2", os).second, 20.0, " redefined variable in expression " );
+    eval.removeVariable("inner_radius");
+    pair<int,double> result = eval.evaluate("inner_radius", os);
+    test( result.first, int(tools::Evaluator::ERROR_UNKNOWN_VARIABLE), " removed variable " );
+    test( os.str().find("unknown variable") != string::npos, true, " error message of removed variable " );
+    eval.setVariable("inner_radius", 12.5);
+
+    test.log( "concurrent evaluation" );
+    vector<thread> threads;
+    vector<int>    failures(4, 0);
+    for( size_t t = 0; t < failures.size(); ++t )  {
+      threads.emplace_back([&eval, &failures, t]  {
+          for( int i = 0; i < 10000; ++i )  {
+            stringstream text, err;
+            text << "inner_radius*" << (i%100) << " + " << t;
+            pair<int,double> r = eval.evaluate(text.str(), err);
+            if ( r.first != tools::Evaluator::OK || std::fabs(r.second - (12.5*(i%100) + t)) > 1e-12 )
+              ++failures[t];
+          }
+        });
+    }
+    for( auto& t : threads ) t.join();
+    int num_failures = 0;
+    for( int f : failures ) num_failures += f;
+    test( num_failures, 0, " results of concurrent evaluations " );
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
+
+//=============================================================================
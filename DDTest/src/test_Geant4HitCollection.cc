@@ -0,0 +1,317 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Objects.h"
+#include "DDG4/Geant4HitCollection.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+// this should be the first line in your test
+static DDTest test( "Geant4HitCollection" );
+
+namespace {
+  /// Minimal hit type. Counts the living instances and optionally fails in the constructor
+  class TestHit  {
+  public:
+    static long instances;
+    long long int cellID;
+    Position      position;
+    double        energy;
+    TestHit(long long int id, const Position& pos, double e, bool fail = false)
+      : cellID(id), position(pos), energy(e)
+    {
+      if ( fail ) throw runtime_error("TestHit: construction failed");
+      ++instances;
+    }
+    ~TestHit()  {  --instances;  }
+  };
+  long TestHit::instances = 0;
+
+  /// Hit index with access to the slot of a key in the initial table
+  class TestIndex : public Geant4HitIndex  {
+  public:
+    static size_t slot(VolumeID key)  {  return hash(key) & 255;  }
+  };
+
+  /// Collection with the given optimization flags
+  Geant4HitCollection* collection(int flags)  {
+    Geant4HitCollection* coll = new Geant4HitCollection("det", "coll", 0, (const TestHit*)0);
+    coll->setOptimize(flags);
+    return coll;
+  }
+
+  /// Keys, which all fall into the same slot of the initial index table
+  vector<VolumeID> colliding_keys(size_t num)  {
+    vector<VolumeID> keys;
+    size_t slot = TestIndex::slot(0);
+    for( VolumeID key = 0; keys.size() < num; ++key )  {
+      if ( TestIndex::slot(key) == slot ) keys.emplace_back(key);
+    }
+    return keys;
+  }
+
+  /// Check the hit lookup by key after a failed hit construction
+  void check_failed_creation(int flags, const string& tag)  {
+    Geant4HitCollection* coll = collection(flags);
+    coll->createByKey<TestHit>(1, 1, Position(), 1e0);
+    bool thrown = false;
+    try  {
+      coll->createByKey<TestHit>(2, 2, Position(), 2e0, true);
+    }
+    catch( const exception& )  {
+      thrown = true;
+    }
+    test( thrown, tag + " failing hit constructor throws " );
+    test( coll->GetSize(), size_t(1), tag + " failed hit is not added " );
+    test( coll->findByKey<TestHit>(2) == 0, tag + " key of the failed hit is not registered " );
+
+    TestHit* hit = coll->createByKey<TestHit>(2, 3, Position(), 3e0);
+    test( coll->findByKey<TestHit>(2) == hit, tag + " key can be used after the failure " );
+    test( coll->findByKey<TestHit>(1)->cellID, 1LL, tag + " first key points to the first hit " );
+
+    thrown = false;
+    try  {
+      coll->createByKey<TestHit>(2, 4, Position(), 4e0);
+    }
+    catch( const exception& )  {
+      thrown = true;
+    }
+    test( thrown, tag + " duplicate key throws " );
+    test( coll->GetSize(), size_t(2), tag + " duplicate key does not add a hit " );
+    test( coll->findByKey<TestHit>(2) == hit, tag + " duplicate key keeps the first hit " );
+    delete coll;
+    test( TestHit::instances, 0L, tag + " all hits are destructed " );
+  }
+
+  /// Position comparison, where all positions have one of 3 hash values
+  class CollidingPositionCompare : public PositionHashCompare<TestHit,Position>  {
+  public:
+    CollidingPositionCompare(const Position& p) : PositionHashCompare<TestHit,Position>(p)  {}
+    virtual size_t hash() const override  {
+      return PositionHashCompare<TestHit,Position>::hash() % 3;
+    }
+  };
+
+  /// Merge steps into hits by position as Geant4OpticalCalorimeterAction did: linear search
+  void merge_linear(Geant4HitCollection* coll, const vector<pair<Position,double> >& steps)  {
+    for( const auto& s : steps )  {
+      TestHit* hit = coll->find<TestHit>(PositionCompare<TestHit,Position>(s.first));
+      if ( !hit )  {
+        hit = new TestHit(coll->GetSize(), s.first, 0e0);
+        coll->add(hit);
+      }
+      hit->energy += s.second;
+    }
+  }
+
+  /// Merge steps into hits by position as Geant4OpticalCalorimeterAction does: hashed lookup
+  template <typename COMPARE>
+  void merge_hashed(Geant4HitCollection* coll, const vector<pair<Position,double> >& steps)  {
+    for( const auto& s : steps )  {
+      COMPARE cmp(s.first);
+      TestHit* hit = coll->findByHash<TestHit>(cmp);
+      if ( !hit )  {
+        hit = coll->createByHash<TestHit>(cmp, coll->GetSize(), s.first, 0e0);
+      }
+      hit->energy += s.second;
+    }
+  }
+
+  /// Check that two collections contain the same hits in the same order
+  bool same_hits(Geant4HitCollection* coll, Geant4HitCollection* ref)  {
+    vector<TestHit*> hits = coll->getHits<TestHit>(), refs = ref->getHits<TestHit>();
+    if ( hits.size() != refs.size() ) return false;
+    for( size_t i = 0; i < hits.size(); ++i )  {
+      const TestHit* h = hits[i];
+      const TestHit* r = refs[i];
+      if ( h->cellID != r->cellID || !(h->position == r->position) || h->energy != r->energy )
+        return false;
+    }
+    return true;
+  }
+}
+
+//=============================================================================
+
+int main(int /* argc */, char** /* argv */ ){
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test the flat hit index with colliding keys" );
+
+    // 100 keys in one slot: found by linear probing without rehash
+    vector<VolumeID> keys = colliding_keys(100);
+    Geant4HitIndex index;
+    bool inserted = true, found = true;
+    for( size_t i = 0; i < keys.size(); ++i )
+      inserted &= index.insert(keys[i], i);
+    for( size_t i = 0; i < keys.size(); ++i )
+      found &= index.find(keys[i]) == i;
+    test( inserted, " colliding keys are inserted " );
+    test( found, " colliding keys are found " );
+    test( index.size(), keys.size(), " index size " );
+    test( !index.insert(keys[50], 1000), " duplicate key is rejected " );
+    test( index.find(keys[50]), size_t(50), " duplicate key keeps its position " );
+
+    // Colliding and non colliding keys, which are not present
+    vector<VolumeID> more = colliding_keys(110);
+    test( index.find(more[105]) == Geant4HitIndex::npos, " absent colliding key is not found " );
+    test( index.find(~VolumeID(0)) == Geant4HitIndex::npos, " absent key is not found " );
+
+    // Grow the table several times: all entries survive the rehash
+    for( size_t i = 0; i < 5000; ++i )
+      index.insert(VolumeID(1) << 40 | i, 100 + i);
+    found = true;
+    for( size_t i = 0; i < keys.size(); ++i )
+      found &= index.find(keys[i]) == i;
+    for( size_t i = 0; i < 5000; ++i )
+      found &= index.find(VolumeID(1) << 40 | i) == 100 + i;
+    test( found, " all keys are found after rehash " );
+    test( index.size(), keys.size() + 5000, " index size after rehash " );
+
+    index.clear();
+    test( index.size(), size_t(0), " index is empty after clear " );
+    test( index.find(keys[0]) == Geant4HitIndex::npos, " keys are removed by clear " );
+    test( index.insert(keys[0], 7) && index.find(keys[0]) == 7, " index can be reused after clear " );
+
+    test.log( "test the key registration of hits with failing constructors" );
+
+    check_failed_creation(Geant4HitCollection::OPTIMIZE_NONE, "map:");
+    check_failed_creation(Geant4HitCollection::OPTIMIZE_FLATLOOKUP, "flat:");
+    check_failed_creation(Geant4HitCollection::OPTIMIZE_FLATLOOKUP|Geant4HitCollection::OPTIMIZE_ARENA, "arena:");
+
+    test.log( "test keyed hits with colliding keys in a collection" );
+
+    Geant4HitCollection* coll = collection(Geant4HitCollection::OPTIMIZE_FLATLOOKUP);
+    Geant4HitCollection* ref  = collection(Geant4HitCollection::OPTIMIZE_NONE);
+    for( size_t i = 0; i < more.size(); ++i )  {
+      coll->createByKey<TestHit>(more[i], (long long int)i, Position(), 1e0);
+      ref->createByKey<TestHit>(more[i], (long long int)i, Position(), 1e0);
+    }
+    found = true;
+    for( size_t i = 0; i < more.size(); ++i )  {
+      TestHit* h = coll->findByKey<TestHit>(more[i]);
+      TestHit* r = ref->findByKey<TestHit>(more[i]);
+      found &= h && r && h->cellID == (long long int)i && r->cellID == h->cellID;
+    }
+    test( found, " flat index and key map find the same hits " );
+    delete coll;
+    delete ref;
+
+    test.log( "test the hit arena" );
+
+    {
+      Geant4HitArena arena;
+      void* first = arena.allocate(sizeof(TestHit), alignof(TestHit));
+      void* aligned = arena.allocate(3, 64);
+      test( (size_t(aligned) & 63), size_t(0), " allocation is aligned " );
+      test( arena.numBlocks(), size_t(1), " small allocations share one block " );
+      arena.reset();
+      test( arena.numBlocks(), size_t(0), " reset releases all blocks " );
+      void* again = arena.allocate(sizeof(TestHit), alignof(TestHit));
+      test( again == first, " block is reused after reset " );
+
+      void* large = arena.allocate(2*Geant4HitArena::BLOCK_SIZE, 8);
+      test( large != 0 && arena.numBlocks() == 2, " large allocation gets its own block " );
+      for( size_t i = 0; i < Geant4HitArena::BLOCK_SIZE/sizeof(TestHit); ++i )
+        arena.allocate(sizeof(TestHit), alignof(TestHit));
+      test( arena.numBlocks(), size_t(3), " full block is followed by a new block " );
+    }
+
+    test.log( "test the reuse of the hit arena over several events" );
+
+    coll = collection(Geant4HitCollection::OPTIMIZE_FLATLOOKUP|Geant4HitCollection::OPTIMIZE_ARENA);
+    vector<TestHit*> previous;
+    for( int event = 0; event < 3; ++event )  {
+      string tag = " event " + to_string(event) + ": ";
+      const size_t num_hits = 3*(Geant4HitArena::BLOCK_SIZE/sizeof(TestHit));  // Three full arena blocks
+      for( size_t i = 0; i < num_hits; ++i )
+        coll->createByKey<TestHit>(VolumeID(i), (long long int)i, Position(0e0, 0e0, double(i)), double(event));
+      test( TestHit::instances, long(num_hits), tag + "hits are created " );
+
+      vector<TestHit*> hits = coll->getHits<TestHit>();
+      found = hits.size() == num_hits;
+      for( size_t i = 0; found && i < num_hits; ++i )  {
+        TestHit* h = coll->findByKey<TestHit>(VolumeID(i));
+        found &= h == hits[i] && h->cellID == (long long int)i && h->energy == double(event);
+        found &= (size_t(h) & (alignof(TestHit)-1)) == 0;
+      }
+      test( found, tag + "arena hits are found by key " );
+      // Blocks are taken back from the pool in reverse order: compare the sets of addresses
+      sort(hits.begin(), hits.end());
+      if ( !previous.empty() )  {
+        test( hits == previous, tag + "hits reuse the memory of the previous event " );
+      }
+
+      bool thrown = false;
+      try  {
+        coll->releaseHits<TestHit>();
+      }
+      catch( const exception& )  {
+        thrown = true;
+      }
+      test( thrown, tag + "arena hits cannot be released " );
+      test( coll->GetSize(), num_hits, tag + "arena hits stay in the collection " );
+
+      previous = hits;
+      coll->clear();  // End of event
+      test( TestHit::instances, 0L, tag + "hits are destructed at the end of the event " );
+      test( coll->findByKey<TestHit>(0) == 0, tag + "keys are removed at the end of the event " );
+    }
+    delete coll;
+
+    test.log( "test the hashed position merging against the linear search" );
+
+    // Steps on a 20x20 grid with repeated positions. Zero coordinates are given as +0 and -0
+    vector<pair<Position,double> > steps;
+    unsigned int seed = 12345;
+    for( size_t i = 0; i < 20000; ++i )  {
+      seed = seed * 1103515245 + 12345;
+      double x = double((seed >> 8) % 20) - 10e0;
+      double y = double((seed >> 16) % 20) - 10e0;
+      double z = (seed & 1) ? 0e0 : -0e0;
+      if ( x == 0e0 && (seed & 2) ) x = -0e0;
+      steps.emplace_back(Position(x, y, z), 1e-3 * double(i % 7 + 1));
+    }
+    Geant4HitCollection* linear = collection(Geant4HitCollection::OPTIMIZE_REPEATEDLOOKUP);
+    merge_linear(linear, steps);
+    test( linear->GetSize(), size_t(400), " linear search merges the steps into one hit per position " );
+
+    const int hash_flags[] = { Geant4HitCollection::OPTIMIZE_NONE, Geant4HitCollection::OPTIMIZE_ARENA };
+    for( int flags : hash_flags )  {
+      string tag = flags ? " arena:" : " heap:";
+      coll = collection(flags);
+      merge_hashed<PositionHashCompare<TestHit,Position> >(coll, steps);
+      test( same_hits(coll, linear), tag + " hashed merging gives the same hits as the linear search " );
+      delete coll;
+
+      coll = collection(flags);
+      merge_hashed<CollidingPositionCompare>(coll, steps);
+      test( same_hits(coll, linear), tag + " hashed merging with colliding hashes gives the same hits " );
+      delete coll;
+    }
+    for( TestHit* h : linear->releaseHits<TestHit>() )
+      delete h;
+    delete linear;
+    test( TestHit::instances, 0L, " all merged hits are destructed " );
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
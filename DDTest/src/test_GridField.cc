@@ -0,0 +1,165 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/FieldTypes.h"
+#include "DD4hep/DD4hepUnits.h"
+
+#include <exception>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+
+using namespace std ;
+using namespace dd4hep ;
+
+// this should be the first line in your test
+static DDTest test( "GridField" ) ;
+
+//=============================================================================
+
+namespace {
+  /// Field used to fill the maps: linear in all coordinates, reproduced exactly by the interpolation
+  void linear_field(double x, double y, double z, double* b)  {
+    b[0] = 0.5 + 0.01 * x;
+    b[1] = -0.02 * y;
+    b[2] = 2.0 + 0.001 * x - 0.003 * z;
+  }
+  bool same(double a, double b)  {
+    return std::fabs(a - b) < 1e-5 * (1.0 + std::fabs(b));
+  }
+}
+
+int main(int /* argc */, char** /* argv */ ){
+
+  const string cartesian_map   = "test_GridField_cartesian.map";
+  const string cylindrical_map = "test_GridField_cylindrical.map";
+  const string periodic_map    = "test_GridField_periodic.map";
+
+  try{
+
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test cartesian grid field" );
+
+    // Grid with a number of points, which is not a multiple of the brick size
+    unsigned int points[3] = { 9, 6, 11 };
+    double lower[3] = { -40.0, -25.0, -100.0 };   // [mm]
+    double step[3]  = {  10.0,  10.0,   20.0 };   // [mm]
+    vector<float> values;
+    for( unsigned int i = 0; i < points[0]; ++i )  {
+      for( unsigned int j = 0; j < points[1]; ++j )  {
+        for( unsigned int k = 0; k < points[2]; ++k )  {
+          double b[3];
+          linear_field(lower[0]+i*step[0], lower[1]+j*step[1], lower[2]+k*step[2], b);
+          values.push_back(float(b[0]));
+          values.push_back(float(b[1]));
+          values.push_back(float(b[2]));
+        }
+      }
+    }
+    GridField::write(cartesian_map, GridField::CARTESIAN, points, lower, step, values);
+
+    GridField field;
+    field.load(cartesian_map);
+
+    const double pos_mm[4][3] = { { 0.0, 0.0, 0.0 }, { -40.0, -25.0, -100.0 }, { 33.3, 17.1, -3.7 }, { 40.0, 25.0, 100.0 } };
+    for( const auto& p : pos_mm )  {
+      double pos[3] = { p[0]*dd4hep::mm, p[1]*dd4hep::mm, p[2]*dd4hep::mm };
+      double b[3] = { 0.0, 0.0, 0.0 }, expected[3];
+      linear_field(p[0], p[1], p[2], expected);
+      field.fieldComponents(pos, b);
+      test( same(b[0]/dd4hep::tesla, expected[0]) &&
+            same(b[1]/dd4hep::tesla, expected[1]) &&
+            same(b[2]/dd4hep::tesla, expected[2]), " cartesian map interpolation inside the grid " );
+    }
+
+    double outside[3] = { 41.0*dd4hep::mm, 0.0, 0.0 }, b_out[3] = { 1.0, 2.0, 3.0 };
+    field.fieldComponents(outside, b_out);
+    test( b_out[0] == 1.0 && b_out[1] == 2.0 && b_out[2] == 3.0, " no contribution outside the grid " );
+
+    double batch_pos[6] = { 0.0, 0.0, 0.0, 1.0*dd4hep::cm, -1.0*dd4hep::cm, 2.0*dd4hep::cm }, batch_b[6] = { 0 }, single_b[3] = { 0 };
+    field.fieldComponents(2, batch_pos, batch_b);
+    field.fieldComponents(batch_pos+3, single_b);
+    test( batch_b[3] == single_b[0] && batch_b[4] == single_b[1] && batch_b[5] == single_b[2], " batched access " );
+
+    GridField cached_field;
+    cached_field.cache_cell = true;
+    cached_field.load(cartesian_map);
+    bool identical = true;
+    for( int n = 0; n < 200; ++n )  {
+      // Walk through the grid in small steps: several consecutive points per cell
+      double pos[3] = { (-45.0 + 0.45*n)*dd4hep::mm, (-20.0 + 0.2*n)*dd4hep::mm, (90.0 - 0.9*n)*dd4hep::mm };
+      double b[3] = { 0, 0, 0 }, b_cached[3] = { 0, 0, 0 };
+      field.fieldComponents(pos, b);
+      cached_field.fieldComponents(pos, b_cached);
+      identical = identical && b[0] == b_cached[0] && b[1] == b_cached[1] && b[2] == b_cached[2];
+    }
+    test( identical, " cell cache gives identical field values " );
+
+    test.log( "test cylindrical r-z grid field" );
+
+    // r-z map: Br = 0.01 * r [tesla/mm], Bphi = 0, Bz = 3.5 tesla
+    unsigned int rz_points[3] = { 21, 1, 5 };
+    double rz_lower[3] = { 0.0, 0.0, -200.0 };
+    double rz_step[3]  = { 5.0, 0.0,  100.0 };
+    vector<float> rz_values;
+    for( unsigned int i = 0; i < rz_points[0]; ++i )  {
+      for( unsigned int k = 0; k < rz_points[2]; ++k )  {
+        rz_values.push_back(float(0.01 * i * rz_step[0]));
+        rz_values.push_back(0.f);
+        rz_values.push_back(3.5f);
+      }
+    }
+    GridField::write(cylindrical_map, GridField::CYLINDRICAL, rz_points, rz_lower, rz_step, rz_values);
+
+    GridField rz_field;
+    rz_field.load(cylindrical_map);
+    double rz_pos[3] = { 30.0*dd4hep::mm, -40.0*dd4hep::mm, 55.0*dd4hep::mm }, rz_b[3] = { 0, 0, 0 };
+    rz_field.fieldComponents(rz_pos, rz_b);
+    test( same(rz_b[0]/dd4hep::tesla, 0.3) && same(rz_b[1]/dd4hep::tesla, -0.4) && same(rz_b[2]/dd4hep::tesla, 3.5),
+          " cylindrical map converted to cartesian components " );
+    test( rz_field.file, cylindrical_map, " field map file name is kept " );
+
+    test.log( "test cylindrical grid field with full phi range" );
+
+    // 8 phi points cover the full circle: Bz = phi point index, Br = Bphi = 0
+    unsigned int phi_points[3] = { 3, 8, 2 };
+    double phi_lower[3] = { 0.0, 0.0, -100.0 };
+    double phi_step[3]  = { 50.0, 2.0*M_PI/8.0, 200.0 };
+    vector<float> phi_values;
+    for( unsigned int i = 0; i < phi_points[0]; ++i )  {
+      for( unsigned int j = 0; j < phi_points[1]; ++j )  {
+        for( unsigned int k = 0; k < phi_points[2]; ++k )  {
+          phi_values.push_back(0.f);
+          phi_values.push_back(0.f);
+          phi_values.push_back(float(j));
+        }
+      }
+    }
+    GridField::write(periodic_map, GridField::CYLINDRICAL, phi_points, phi_lower, phi_step, phi_values);
+
+    GridField phi_field;
+    phi_field.load(periodic_map);
+    // Half way between the last phi point (7/8 of the circle) and the first one: (7 + 0) / 2
+    double phi = 2.0*M_PI * 15.0/16.0;
+    double phi_pos[3] = { 50.0*cos(phi)*dd4hep::mm, 50.0*sin(phi)*dd4hep::mm, 0.0 }, phi_b[3] = { 0, 0, 0 };
+    phi_field.fieldComponents(phi_pos, phi_b);
+    test( same(phi_b[2]/dd4hep::tesla, 3.5), " last phi cell closes the circle " );
+    // Inside the grid the interpolation is unchanged: between phi points 2 and 3
+    phi = 2.0*M_PI * 5.0/16.0;
+    double mid_pos[3] = { 50.0*cos(phi)*dd4hep::mm, 50.0*sin(phi)*dd4hep::mm, 0.0 }, mid_b[3] = { 0, 0, 0 };
+    phi_field.fieldComponents(mid_pos, mid_b);
+    test( same(mid_b[2]/dd4hep::tesla, 2.5), " interpolation between inner phi points " );
+
+    // --------------------------------------------------------------------
+
+  } catch( exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  ::remove(cartesian_map.c_str());
+  ::remove(cylindrical_map.c_str());
+  ::remove(periodic_map.c_str());
+  return 0;
+}
+
+//=============================================================================
@@ -66,6 +66,66 @@ int main(int /* argc */, char** /* argv */ ){
     test( bf2.get( field, bf2.index( "y")),    -16710 , " acces field value: y" );
 
 
+    // ----- light-weight handles with resolved constants
+    test( bf2.handle( "layer" ).value( field ),  373 , " handle field value: layer" );
+    test( bf2.handle( "module").value( field ),  254 , " handle field value: module" );
+    test( bf2.handle( "sensor").value( field ),  202 , " handle field value: sensor" );
+    test( bf2.handle( "side"  ).value( field ),  1   , " handle field value: side" );
+    test( bf2.handle( "system").value( field ),  30  , " handle field value: system" );
+    test( bf2.handle( "x"     ).value( field ), -310 , " handle field value: x" );
+    test( bf2.handle( "y"     ).value( field ), -16710 , " handle field value: y" );
+
+    long64 field2 = 0 ;
+    for( size_t i = 0 ; i < bf2.size() ; ++i )
+      bf2.handle( i ).set( field2, bf2.get( field, i ) ) ;
+    test( field2 , field , " same value from handle initialization " ); 
+
+    // ----- accessors by name of a coder copied from a destroyed coder
+    BitFieldCoder bf3 ;
+    {
+      BitFieldCoder tmp( bf2 ) ;
+      bf3 = tmp ;
+    }
+    long64 field3 = 0 ;
+    for( const auto& f : bf3.fields() )
+      bf3.set( field3, f.name(), bf2.get( field, f.name() ) ) ;
+    test( field3 , field , " same value from copied coder by name " ); 
+
+    bool unknown = false ;
+    try  {
+      bf3.get( field3, "nofield" ) ;
+    }
+    catch( const exception& )  {
+      unknown = true ;
+    }
+    test( unknown , true , " unknown field name throws " ); 
+
+    // ----- decoders with constants fixed at compile time
+    constexpr const char spec[] = "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16" ;
+    static_assert( bitFieldSpec( spec, "layer" ).offset == 7,  "layer offset" ) ;
+    static_assert( bitFieldSpec( spec, "x" ).offset     == 32, "x offset" ) ;
+    static_assert( bitFieldSpec( spec, "y" ).width      == 16, "y width" ) ;
+    static_assert( bitFieldSpec( spec, "y" ).isSigned,         "y signed" ) ;
+    static_assert( !bitFieldSpec( spec, "lay" ).found,         "no field lay" ) ;
+
+    typedef FixedBitFieldElement<bitFieldSpec(spec,"layer").offset,
+                                 bitFieldSpec(spec,"layer").width,
+                                 bitFieldSpec(spec,"layer").isSigned>  FixedLayer ;
+    typedef FixedBitFieldElement<bitFieldSpec(spec,"x").offset,
+                                 bitFieldSpec(spec,"x").width,
+                                 bitFieldSpec(spec,"x").isSigned>      FixedX ;
+    typedef FixedBitFieldElement<bitFieldSpec(spec,"y").offset,
+                                 bitFieldSpec(spec,"y").width,
+                                 bitFieldSpec(spec,"y").isSigned>      FixedY ;
+
+    test( FixedLayer::value( field ),  373   , " fixed field value: layer" );
+    test( FixedX::value( field ),     -310   , " fixed field value: x" );
+    test( FixedY::value( field ),     -16710 , " fixed field value: y" );
+    test( FixedY::set( FixedX::set( field, -311 ), 42 ), 
+          long64( ( field & 0xffffffffULL ) | ( 42ULL << 48 ) | ( ( -311LL & 0xffffULL ) << 32 ) ),
+          " fixed field set: x,y" );
+
+
     // --------------------------------------------------------------------
 
 
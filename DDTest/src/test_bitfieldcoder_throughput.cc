@@ -0,0 +1,90 @@
+#include "DD4hep/DDTest.h"
+#include <exception>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+#include "DDSegmentation/BitFieldCoder.h"
+
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace DDSegmentation ;
+
+// this should be the first line in your test
+static DDTest test( "bitfieldcoder_throughput" ) ; 
+
+//=============================================================================
+
+namespace {
+
+  constexpr const char spec[] = "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16" ;
+
+  typedef FixedBitFieldElement<bitFieldSpec(spec,"layer").offset,
+                               bitFieldSpec(spec,"layer").width,
+                               bitFieldSpec(spec,"layer").isSigned>  FixedLayer ;
+  typedef FixedBitFieldElement<bitFieldSpec(spec,"x").offset,
+                               bitFieldSpec(spec,"x").width,
+                               bitFieldSpec(spec,"x").isSigned>      FixedX ;
+  typedef FixedBitFieldElement<bitFieldSpec(spec,"y").offset,
+                               bitFieldSpec(spec,"y").width,
+                               bitFieldSpec(spec,"y").isSigned>      FixedY ;
+
+  /// Decode layer, x and y of all cells and report the throughput
+  template <typename DECODE> long64 measure( const char* tag, const vector<long64>& cells, DECODE decode ) {
+    long64 sum = 0 ;
+    auto start = chrono::high_resolution_clock::now() ;
+    for( long64 c : cells ) sum += decode( c ) ;
+    auto stop  = chrono::high_resolution_clock::now() ;
+    double secs = chrono::duration<double>( stop - start ).count() ;
+    ::printf( "[bitfieldcoder_throughput] %-24s %10ld cells in %8.4f seconds: %8.1f Mcells/second\n",
+              tag, long(cells.size()), secs, secs > 0 ? 1e-6*double(cells.size())/secs : 0e0 ) ;
+    return sum ;
+  }
+}
+
+int main(int /* argc */, char** /* argv */ ){
+    
+  try{
+    
+    // ----- write your tests in here -------------------------------------
+
+    test.log( "test bitfieldcoder decode throughput" );
+
+    const BitFieldCoder bf( spec ) ;
+    const size_t iLayer = bf.index( "layer" ), iX = bf.index( "x" ), iY = bf.index( "y" ) ;
+    const BitFieldHandle hLayer = bf.handle( "layer" ), hX = bf.handle( "x" ), hY = bf.handle( "y" ) ;
+
+    vector<long64> cells( 2000000 ) ;
+    mt19937_64 rndm( 12345 ) ;
+    for( auto& c : cells ) c = long64( rndm() ) ;
+
+    long64 s_name  = measure( "get(bitfield,name)",  cells, [&]( long64 c ) {
+        return bf.get( c, "layer" ) + bf.get( c, "x" ) + bf.get( c, "y" ) ;  } ) ;
+    long64 s_index = measure( "get(bitfield,index)", cells, [&]( long64 c ) {
+        return bf.get( c, iLayer ) + bf.get( c, iX ) + bf.get( c, iY ) ;  } ) ;
+    long64 s_hdl   = measure( "BitFieldHandle",      cells, [&]( long64 c ) {
+        return hLayer.value( c ) + hX.value( c ) + hY.value( c ) ;  } ) ;
+    long64 s_fixed = measure( "FixedBitFieldElement", cells, []( long64 c ) {
+        return FixedLayer::value( c ) + FixedX::value( c ) + FixedY::value( c ) ;  } ) ;
+
+    test( s_index, s_name,  " same decoded values: index access" );
+    test( s_hdl,   s_name,  " same decoded values: handle access" );
+    test( s_fixed, s_name,  " same decoded values: compile-time decoder" );
+
+    // --------------------------------------------------------------------
+
+
+  } catch( exception &e ){
+    //} catch( ... ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
+
+//=============================================================================
@@ -26,6 +26,7 @@
 #include "EVENT/SimCalorimeterHit.h"
 
 #include <sstream>
+#include <vector>
 
 using namespace std ;
 using namespace dd4hep ;
@@ -128,6 +129,10 @@ int main_wrapper(int argc, char** argv ){
       dd4hep::BitFieldCoder idDecoder1( cellIDEcoding ) ;
 
       int nHit = std::min( col->getNumberOfElements(), maxHit )  ;
+
+      // collect the input of the batched conversions
+      std::vector<CellID>   batchIDs ;
+      std::vector<Position> batchPoints ;
      
       
       for(int i=0 ; i< nHit ; ++i){
@@ -157,6 +162,9 @@ int main_wrapper(int argc, char** argv ){
 	else
 	  tMap[ colNames[icol] ].cellid.failed++ ;
 	  
+	batchIDs.emplace_back( id ) ;
+	batchPoints.emplace_back( point ) ;
+
 	Position pointFromDecoder = idposConv.position( id ) ;
 
 	double d = dist(pointFromDecoder, point)  ;
@@ -172,6 +180,24 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].position.failed++ ;
 
       }
+
+      // ====== the batched conversions must agree with the single cell conversions ==========
+      std::vector<Position> batchPositions( batchIDs.size() ) ;
+      std::vector<CellID>   batchCellIDs( batchPoints.size() ) ;
+
+      idposConv.positions( batchIDs.data(), batchIDs.size(), batchPositions.data() ) ;
+      idposConv.cellIDs( batchPoints.data(), batchPoints.size(), batchCellIDs.data() ) ;
+
+      for( std::size_t i = 0 ; i < batchIDs.size() ; ++i ){
+
+	std::stringstream sst ;
+	sst << " batched position of " << idDecoder0.valueString( batchIDs[i] ) ;
+	test( dist( batchPositions[i], idposConv.position( batchIDs[i] ) ) < epsilon , true , sst.str() ) ;
+
+	std::stringstream sst1 ;
+	sst1 << " batched cellID at ( " << batchPoints[i] << " ) " ;
+	test( batchCellIDs[i], idposConv.cellID( batchPoints[i] ), sst1.str() ) ;
+      }
     }
     
   }
@@ -195,6 +221,10 @@ int main_wrapper(int argc, char** argv ){
   }
   std::cout << "\n -------------------------------------------------------- " << std::endl ;
 
+  CellIDPositionConverter::NavigationCacheCounters cnt = idposConv.navigationCacheCounters() ;
+  printf(" navigation cache: queries: %lu  same volume: %lu  siblings: %lu  misses: %lu \n",
+	 cnt.queries, cnt.same, cnt.siblings, cnt.misses ) ;
+
   
   return 0;
 }
@@ -0,0 +1,49 @@
+from __future__ import absolute_import, unicode_literals
+import sys
+import DDG4
+import MiniTelSetup
+from DDG4 import OutputLevel as Output
+#
+#
+"""
+
+   dd4hep example setup using the python configuration
+
+   Check of the Geant4VolumeManager placement lookups during the simulation:
+   the volume identifiers from the touchable cache and from the hash index
+   must be identical to the linear search of the placement path.
+
+   Usage: python MiniTelVolumeManager.py [batch] [nocache]
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def run():
+  m = MiniTelSetup.Setup()
+  if 'batch' in sys.argv:
+    m.kernel.NumEvents = 100
+    m.kernel.UI = ''
+    DDG4.setPrintLevel(Output.WARNING)
+
+  if 'nocache' in sys.argv:
+    seq, act = m.geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+    act.CacheTouchables = False
+    seq, act = m.geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+
+  m.configure()
+  m.setupGun()
+  m.setupGenerator()
+  # This is the actual test:
+  check = DDG4.SteppingAction(m.kernel, 'Geant4VolumeManagerCheck/VolumeManagerCheck')
+  m.kernel.steppingAction().adopt(check)
+  # Setup physics
+  m.setupPhysics()
+  # ... and run
+  m.geant4.execute()
+
+
+if __name__ == "__main__":
+  run()
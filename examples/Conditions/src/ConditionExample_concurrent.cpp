@@ -0,0 +1,289 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_concurrent \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -threads 8 [-compute 4]
+
+   Stress test for the concurrent preparation of conditions slices:
+   Populate the conditions store by hand for a set of IOVs.
+   Then N threads prepare their own slices for the same, overlapping
+   IOVs in random order. Each thread hence competes with the others
+   to compute the derived conditions of the same IOV pools.
+   At the end the result of every preparation is compared to a
+   single threaded reference.
+   With -compute the derived conditions of each slice are in addition
+   computed in parallel by the dependency handler.
+   With -bulk some of these callbacks insert conditions to the user pool
+   while others scan it with bulk accesses (by item and by detector element).
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsManagerObject.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Result of one slice preparation
+  struct PrepareResult  {
+    long iov_value;
+    ConditionsManager::Result result;
+  };
+
+  /// Derived condition callback inserting an additional condition to the user pool
+  class BulkWriter : public ConditionUpdateCall  {
+  public:
+    std::atomic<long> counter { 0 };
+    virtual Condition operator()(const ConditionKey& key, ConditionUpdateContext& context) override  {
+      ConditionKey::KeyMaker km(key.hash);
+      ConditionKey::KeyMaker extra_key(km.values.det_key,
+                                       ConditionKey::itemCode("derived_data/extra_"+to_string(++counter)));
+      Condition extra(extra_key.hash);
+      extra.bind<int>() = 1;
+      context.registerMany(context.requiredValidity(), vector<Condition>(1, extra));
+      Condition target(key.hash);
+      target.bind<int>() = 1;
+      return target;
+    }
+  };
+
+  /// Derived condition callback using bulk accesses to the user pool at resolve time
+  class BulkReader : public ConditionUpdateCall  {
+  public:
+    size_t num_detectors;
+    BulkReader(size_t n) : num_detectors(n) {}
+    virtual Condition operator()(const ConditionKey& key, ConditionUpdateContext&) override  {
+      Condition target(key.hash);
+      target.bind<vector<int> >();
+      return target;
+    }
+    virtual void resolve(Condition target, ConditionUpdateContext& context) override  {
+      ConditionKey::KeyMaker km(target->hash);
+      vector<Condition> by_item = context.getByItem(ConditionKey::itemCode("derived_data"));
+      vector<Condition> by_det  = context.conditions(km.values.det_key);
+      if ( by_item.size() != num_detectors || by_det.size() < 5 )  {
+        printout(ERROR,"BulkReader","+  Bulk access found %ld conditions by item (expected %ld) "
+                 "and %ld by detector (expected at least 5).",
+                 by_item.size(), num_detectors, by_det.size());
+      }
+      vector<int>& data = target.get<vector<int> >();
+      data.push_back(int(by_item.size()));
+      data.push_back(int(by_det.size()));
+    }
+  };
+
+  /// Derived condition callback depending on the bulk reader: forces its resolution in the parallel pass
+  class BulkUser : public ConditionUpdateCall  {
+  public:
+    virtual Condition operator()(const ConditionKey& key, ConditionUpdateContext&) override  {
+      Condition target(key.hash);
+      target.bind<vector<int> >();
+      return target;
+    }
+    virtual void resolve(Condition target, ConditionUpdateContext& context) override  {
+      target.get<vector<int> >() = context.get<vector<int> >(context.key(0));
+    }
+  };
+
+  /// Add the dependencies of the bulk access callbacks for every detector element
+  struct BulkDependencyCreator  {
+    ConditionsContent&                   content;
+    std::shared_ptr<ConditionUpdateCall> writer, reader, user;
+    int operator()(DetElement de, int)  const  {
+      ConditionKey      key(de,"derived_data");
+      ConditionKey      target_writer(de,"derived_data/bulk_writer");
+      ConditionKey      target_reader(de,"derived_data/bulk_reader");
+      ConditionKey      target_user(de,"derived_data/bulk_user");
+      DependencyBuilder build_writer(de, target_writer.item_key(), writer);
+      DependencyBuilder build_reader(de, target_reader.item_key(), reader);
+      DependencyBuilder build_user(de, target_user.item_key(), user);
+      build_writer.add(key);
+      build_reader.add(key);
+      build_user.add(target_reader);
+      content.addDependency(build_writer.release());
+      content.addDependency(build_reader.release());
+      content.addDependency(build_user.release());
+      return 1;
+    }
+  };
+
+  /// Worker thread preparing slices for a random sequence of IOVs
+  class Worker  {
+  public:
+    ConditionsManager     manager;
+    const IOVType*        iovTyp;
+    ConditionsSlice       slice;
+    vector<long>          iovs;
+    vector<PrepareResult> results;
+
+    Worker(ConditionsManager m, const IOVType* typ, const ConditionsSlice& s, const vector<long>& v, int seed)
+      : manager(m), iovTyp(typ), slice(s), iovs(v)
+    {
+      mt19937 generator(seed);
+      shuffle(iovs.begin(), iovs.end(), generator);
+    }
+    void run()  {
+      for( long iov_val : iovs )  {
+        IOV iov(iovTyp, iov_val);
+        ConditionsManager::Result res = manager.prepare(iov, slice);
+        results.emplace_back(PrepareResult{iov_val, res});
+      }
+    }
+  };
+}
+
+/// Plugin function: Stress test for concurrent conditions slice preparation
+/**
+ *  Factory: DD4hep_ConditionExample_concurrent
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    17/10/2026
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 10, num_threads = 4, num_turns = 3, num_compute = 0;
+  bool   arg_error = false, bulk = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-turns",argv[i],4) )
+      num_turns = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-compute",argv[i],4) )
+      num_compute = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-bulk",argv[i],4) )
+      bulk = true;
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_concurrent              \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of IOV pools to be populated.            \n"
+      "     -threads <number>        Number of execution threads.                    \n"
+      "     -turns   <number>        Number of preparations per IOV pool and thread. \n"
+      "     -compute <number>        Number of threads to compute derived conditions.\n"
+      "     -bulk                    Add callbacks with bulk accesses to the user pool.\n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  manager["ComputeThreads"] = num_compute;
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  int num_det = Scanner().scan(ConditionsDependencyCreator(*content,DEBUG),description.world());
+  if ( bulk )  {
+    BulkDependencyCreator creator { *content, make_shared<BulkWriter>(),
+                                    make_shared<BulkReader>(num_det), make_shared<BulkUser>() };
+    Scanner().scan(creator,description.world());
+  }
+
+  /******************** Populate the conditions store *********************/
+  // Have e.g. 10 run-slices [1,10], [11,20] .... [91,100]
+  // Every thread prepares slices for 'num_turns' different runs of each slice.
+  vector<long> iovs;
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* pool = manager.registerIOV(*iov.iovType, iov.key());
+    int count = Scanner().scan(ConditionsCreator(*slice, *pool, DEBUG),description.world());
+    printout(INFO,"Example", "Setup %ld conditions for IOV:%s", count, iov.str().c_str());
+    for(int j=0; j<num_turns; ++j)
+      iovs.push_back(1+i*10+(j%10));
+  }
+
+  // ++++++++++++++++++++++++ Now prepare the slices concurrently
+  TTimeStamp start;
+  vector<Worker*> workers;
+  vector<thread*> threads;
+  for(int i=0; i<num_threads; ++i)  {
+    Worker* w = new Worker(manager, iov_typ, *slice, iovs, i+1);
+    workers.push_back(w);
+    threads.push_back(new thread([w]{ w->run(); }));
+  }
+  for(thread* t : threads)  {
+    t->join();
+    delete t;
+  }
+  TTimeStamp stop;
+  printout(INFO,"Statistics","+  %d threads prepared %ld slices each in %8.3f seconds",
+           num_threads, iovs.size(), stop.AsDouble()-start.AsDouble());
+
+  // ++++++++++++++++++++++++ Single threaded reference: all derived conditions exist now
+  map<long,ConditionsManager::Result> reference;
+  for( long iov_val : iovs )  {
+    if ( reference.find(iov_val) == reference.end() )  {
+      ConditionsSlice ref_slice(*slice);
+      reference[iov_val] = manager.prepare(IOV(iov_typ, iov_val), ref_slice);
+    }
+  }
+  size_t num_errors = 0, num_computed = 0;
+  for( const Worker* w : workers )  {
+    for( const auto& r : w->results )  {
+      const ConditionsManager::Result& ref = reference[r.iov_value];
+      num_computed += r.result.computed;
+      if ( r.result.missing != 0 || r.result.total() != ref.total() )  {
+        printout(ERROR,"Concurrent","+  IOV %4ld: Total %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld) "
+                 "Expected: %ld conditions", r.iov_value, r.result.total(), r.result.selected,
+                 r.result.loaded, r.result.computed, r.result.missing, ref.total());
+        ++num_errors;
+      }
+    }
+    delete w;
+  }
+  printout(INFO,"Statistics","+  Computed %ld derived conditions for %ld IOV pools.",
+           num_computed, size_t(num_iov));
+  if ( num_errors == 0 )  {
+    printout(INFO,"Statistics","+  PASSED: All %ld concurrent slice preparations are consistent.",
+             size_t(num_threads)*iovs.size());
+  }
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_concurrent,condition_example)
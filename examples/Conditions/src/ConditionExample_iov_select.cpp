@@ -0,0 +1,159 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -print WARNING -destroy -plugin DD4hep_ConditionExample_iov_select \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -iovs 5000 -selects 100000
+
+   Benchmark of the IOV pool selection:
+   Register a large number of run-by-run IOV pools plus some pools
+   spanning many runs. Then select the pools matching random runs
+   using the indexed selection of the IOV pool and compare the result
+   and the timing with a linear scan of all pools.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+
+#include <random>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+/// Plugin function: Benchmark the selection of IOV pools
+/**
+ *  Factory: DD4hep_ConditionExample_iov_select
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    17/10/2026
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  typedef ConditionsIOVPool::Element Element;
+  string input;
+  int    num_iov = 5000, num_select = 100000;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-selects",argv[i],4) )
+      num_select = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_iov <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_iov_select              \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of run IOV pools to be registered.       \n"
+      "     -selects <number>        Number of random IOV selections.                \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Register the IOV pools ****************************/
+  // Run pools [1,10], [11,20] .... and every 100 runs a pool spanning 5000 runs
+  size_t num_pools = 0;
+  for(int i=0; i<num_iov; ++i)  {
+    manager.registerIOV(*iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ++num_pools;
+    if ( 0 == i%100 )  {
+      manager.registerIOV(*iov_typ, IOV::Key(1+i*10,i*10+5000));
+      ++num_pools;
+    }
+  }
+  ConditionsIOVPool* pool = manager.iovPool(*iov_typ);
+  mt19937 generator(12345);
+  uniform_int_distribution<long> runs(1, num_iov*10);
+  vector<long> iovs;
+  iovs.reserve(num_select);
+  for(int i=0; i<num_select; ++i)
+    iovs.push_back(runs(generator));
+
+  // ++++++++++++++++++++++++ Indexed selection
+  size_t num_indexed = 0, num_linear = 0, num_errors = 0;
+  vector<Element> indexed, linear;
+  TTimeStamp start_index;
+  for( long run : iovs )  {
+    indexed.clear();
+    num_indexed += pool->select(IOV(iov_typ, run), indexed);
+  }
+  TTimeStamp stop_index;
+
+  // ++++++++++++++++++++++++ Linear scan of all pools
+  TTimeStamp start_linear;
+  for( long run : iovs )  {
+    const IOV::Key req_key(run, run);
+    linear.clear();
+    for( const auto& e : pool->elements )  {
+      if ( IOV::key_contains_range(e.first, req_key) )  {
+        linear.emplace_back(e.second);
+        ++num_linear;
+      }
+    }
+  }
+  TTimeStamp stop_linear;
+
+  // ++++++++++++++++++++++++ Check both give identical results
+  for( long run : iovs )  {
+    const IOV::Key req_key(run, run);
+    indexed.clear();
+    linear.clear();
+    pool->select(IOV(iov_typ, run), indexed);
+    for( const auto& e : pool->elements )  {
+      if ( IOV::key_contains_range(e.first, req_key) )
+        linear.emplace_back(e.second);
+    }
+    if ( indexed != linear )  {
+      printout(ERROR,"IOVSelect","+  Run %ld: Indexed selection found %ld pools. Expected: %ld pools",
+               run, indexed.size(), linear.size());
+      ++num_errors;
+    }
+  }
+  double t_index  = stop_index.AsDouble()-start_index.AsDouble();
+  double t_linear = stop_linear.AsDouble()-start_linear.AsDouble();
+  printout(ALWAYS,"Statistics","+  %ld pools: %d indexed selections found %ld pools in %8.3f seconds",
+           num_pools, num_select, num_indexed, t_index);
+  printout(ALWAYS,"Statistics","+  %ld pools: %d linear   selections found %ld pools in %8.3f seconds",
+           num_pools, num_select, num_linear, t_linear);
+  if ( num_errors == 0 && num_indexed == num_linear )  {
+    printout(ALWAYS,"Statistics","+  PASSED: %d indexed IOV selections are consistent. Speedup: %.1f",
+             num_select, t_index > 0e0 ? t_linear/t_index : 0e0);
+  }
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_iov_select,condition_example)
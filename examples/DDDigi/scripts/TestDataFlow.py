@@ -0,0 +1,51 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import DDDigi
+
+
+def make_action(kernel, name, sleep, inputs, outputs):
+  action = DDDigi.TestAction(kernel, name, sleep)
+  action.inputs = inputs
+  action.outputs = outputs
+  return action
+
+
+def run():
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+  kernel.printProperties()
+
+  # The actions are adopted in arbitrary order: the scheduler orders them by the data flow
+  scheduler = DDDigi.Synchronize(kernel, 'DigiDataFlowScheduler/DataFlow', True)
+  scheduler.adopt(make_action(kernel, 'merge', 50, ['calo_digits', 'tracker_digits'], ['event_digits']))
+  scheduler.adopt(make_action(kernel, 'calo_digi', 100, ['calo_deposits'], ['calo_digits']))
+  scheduler.adopt(make_action(kernel, 'tracker_digi', 150, ['tracker_deposits'], ['tracker_digits']))
+  scheduler.adopt(make_action(kernel, 'noise', 100, [], []))
+  scheduler.adopt(make_action(kernel, 'deposits', 50, [], ['calo_deposits', 'tracker_deposits']))
+  kernel.eventAction().adopt(scheduler)
+  output = make_action(kernel, 'output', 50, ['event_digits'], [])
+  kernel.outputAction().adopt(output)
+
+  DDDigi.setPrintLevel(DDDigi.OutputLevel.DEBUG)
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = 10
+  kernel.maxEventsParallel = 3
+  kernel.run()
+  DDDigi.setPrintLevel(DDDigi.OutputLevel.INFO)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,142 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Check of the DDDigi pile-up overlay.
+#
+#  Signal and background files with the layout of TestROOTInputCounts.py
+#  are written. The background is loaded into the pool of a
+#  DigiPileupOverlay action and overlaid to the signal events:
+#  - the number of overlaid events must follow a Poisson distribution
+#    with the requested mean,
+#  - every signal container must contain its own deposits plus the
+#    deposits of the same container of all overlaid background events.
+#  The signal is read with a non-default mask: the background must be
+#  merged into the signal containers and not into new containers.
+#
+#  Usage: python TestPileupOverlay.py [number of events] [parallel events]
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import math
+import subprocess
+import TestROOTInputCounts
+
+signal_file = 'DDDigi_Pileup_signal.root'
+background_file = 'DDDigi_Pileup_background.root'
+num_background = 10
+mean = 3.0
+
+
+def run(num_events, num_parallel):
+  import DDDigi
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+
+  signal = DDDigi.EventAction(kernel, 'DigiROOTInput/signal')
+  signal.Input = [str(signal_file)]
+  signal.Mask = 1
+  kernel.inputAction().adopt(signal)
+
+  pileup = DDDigi.Synchronize(kernel, 'DigiPileupOverlay/pileup')
+  background = DDDigi.EventAction(kernel, 'DigiROOTInput/background')
+  background.Input = [str(background_file)]
+  pileup.adopt(background)
+  pileup.PoolSize = num_background
+  pileup.Mean = mean
+  pileup.FirstCrossing = -2
+  pileup.LastCrossing = 2
+  pileup.OutputLevel = DDDigi.OutputLevel.DEBUG
+  kernel.eventAction().adopt(pileup)
+
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  kernel.run()
+
+
+def check(num_events, num_parallel):
+  TestROOTInputCounts.input_file = background_file
+  TestROOTInputCounts.write(num_background)
+  TestROOTInputCounts.input_file = signal_file
+  TestROOTInputCounts.write(num_events)
+  proc = subprocess.Popen([sys.executable, __file__, str(num_events), str(num_parallel), 'run'],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  output = proc.communicate()[0]
+  print(output)
+  if proc.returncode != 0:
+    print('+++ Pile-up test FAILED: the job failed with status %d' % (proc.returncode,))
+    sys.exit(1)
+  overlay = re.compile(r'Event:\s+(\d+) \(DigiPileupOverlay\) Overlay background event (\d+)')
+  collection = re.compile(r'Event:\s+(\d+) \(DigiPileupOverlay\) Collection (\w+): (\d+) deposits')
+  summary = re.compile(r'Event:\s+(\d+) \(DigiPileupOverlay\) Overlaid (\d+) events')
+  overlays, found, multiplicity = {}, {}, {}
+  errors = 0
+  for line in output.splitlines():
+    match = overlay.search(line)
+    if match:
+      overlays.setdefault(int(match.group(1)), []).append(int(match.group(2)))
+      continue
+    match = collection.search(line)
+    if match:
+      key = (int(match.group(1)), match.group(2))
+      if key in found:
+        print('+++ Event %d collection %s: found more than once' % key)
+        errors += 1
+      found[key] = int(match.group(3))
+      continue
+    match = summary.search(line)
+    if match:
+      multiplicity[int(match.group(1))] = int(match.group(2))
+
+  # Merged deposit counts. Signal and background events are numbered from 1: event N is entry N-1
+  counts = TestROOTInputCounts.hit_counts
+  for event in range(1, num_events + 1):
+    for name, count in counts(event - 1).items():
+      expected = count + sum([counts(b - 1)[name] for b in overlays.get(event, [])])
+      if found.get((event, name)) != expected:
+        print('+++ Event %d collection %s: expected %d deposits, found %s' %
+              (event, name, expected, found.get((event, name))))
+        errors += 1
+    if multiplicity.get(event) != len(overlays.get(event, [])):
+      print('+++ Event %d: %s overlaid events, %d background events listed' %
+            (event, multiplicity.get(event), len(overlays.get(event, []))))
+      errors += 1
+
+  # Poisson multiplicity: mean and variance agree with the requested mean
+  overlaid = [multiplicity.get(event, 0) for event in range(1, num_events + 1)]
+  sample_mean = float(sum(overlaid)) / num_events
+  sample_var = sum([(c - sample_mean)**2 for c in overlaid]) / (num_events - 1)
+  if abs(sample_mean - mean) > 4.0 * math.sqrt(mean / num_events):
+    print('+++ Mean number of overlaid events %.3f differs from %.3f' % (sample_mean, mean))
+    errors += 1
+  if abs(sample_var - mean) > 4.0 * math.sqrt((mean + 2.0 * mean * mean) / num_events):
+    print('+++ Variance of the number of overlaid events %.3f differs from %.3f' % (sample_var, mean))
+    errors += 1
+  if errors:
+    print('+++ Pile-up test FAILED: %d mismatches' % (errors,))
+    sys.exit(1)
+  print('+++ Pile-up test PASSED: %d events with mean %.3f and variance %.3f of overlaid events' %
+        (num_events, sample_mean, sample_var))
+
+
+if __name__ == '__main__':
+  num_events = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+  num_parallel = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+  if len(sys.argv) > 3:
+    run(num_events, num_parallel)
+  else:
+    check(num_events, num_parallel)
@@ -0,0 +1,63 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Throughput benchmark of the DDDigi ROOT input reading DDG4 output files.
+#
+#  Usage: python TestROOTInput.py <input.root> [number of events] [parallel events]
+#
+#  Without the number of parallel events the benchmark is executed for
+#  1, 4 and 16 events processed in parallel, each in a separate process.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import time
+import subprocess
+import DDDigi
+
+
+def run(input_file, num_events, num_parallel):
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+
+  reader = DDDigi.EventAction(kernel, 'DigiROOTInput/input_01')
+  reader.Input = [str(input_file)]
+  reader.Prefetch = max(8, 2 * num_parallel)
+  kernel.inputAction().adopt(reader)
+
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  start = time.time()
+  kernel.run()
+  stop = time.time()
+  print('+++ ROOT input: %4d parallel events: %6d events in %8.3f seconds: %10.1f events/s' %
+        (num_parallel, num_events, stop - start, num_events / (stop - start)))
+
+
+def benchmark(input_file, num_events):
+  for num_parallel in (1, 4, 16):
+    subprocess.check_call([sys.executable, __file__, input_file, str(num_events), str(num_parallel)])
+
+
+if __name__ == '__main__':
+  if len(sys.argv) < 2:
+    print('Usage: python %s <input.root> [number of events] [parallel events]' % (sys.argv[0],))
+    sys.exit(1)
+  num_events = int(sys.argv[2]) if len(sys.argv) > 2 else 100
+  if len(sys.argv) > 3:
+    run(sys.argv[1], num_events, int(sys.argv[3]))
+  else:
+    benchmark(sys.argv[1], num_events)
@@ -0,0 +1,126 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Check of the DDDigi ROOT input reading DDG4 output files.
+#
+#  A file with the layout of the DDG4 Geant4Output2ROOT event tree is
+#  written with a known number of tracker and calorimeter hits per event.
+#  The file is then read with several events processed in parallel and
+#  the number of deposits of every event is compared to the written hits.
+#
+#  Usage: python TestROOTInputCounts.py [number of events] [parallel events]
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import subprocess
+
+input_file = 'DDDigi_ROOTInput_counts.root'
+
+
+def hit_counts(event):
+  # Hits per collection of the input entry 'event'
+  return {'SiTracker': event % 7 + 1, 'EcalBarrel': 3 * (event % 5)}
+
+
+def write(num_events):
+  import DDG4  # noqa: F401  Loads the dictionaries of the DDG4 hit classes
+  import ROOT
+  sim = ROOT.dd4hep.sim
+  output = ROOT.TFile.Open(input_file, 'RECREATE')
+  tree = ROOT.TTree('EVENT', 'Geant4 Event')
+  trackers = ROOT.std.vector('dd4hep::sim::Geant4Tracker::Hit*')()
+  calos = ROOT.std.vector('dd4hep::sim::Geant4Calorimeter::Hit*')()
+  tree.Branch('SiTracker', trackers)
+  tree.Branch('EcalBarrel', calos)
+  hits = []
+  for event in range(num_events):
+    counts = hit_counts(event)
+    trackers.clear()
+    calos.clear()
+    for i in range(counts['SiTracker']):
+      hit = sim.Geant4Tracker.Hit()
+      hit.cellID = 1000 * event + i
+      hit.energyDeposit = 0.001 * (i + 1)
+      hit.position = ROOT.Math.XYZVector(i, event, 0.)
+      hit.truth.time = 0.5 * i
+      trackers.push_back(hit)
+      hits.append(hit)
+    for i in range(counts['EcalBarrel']):
+      hit = sim.Geant4Calorimeter.Hit()
+      hit.cellID = 1000 * event + i
+      hit.energyDeposit = 0.01 * (i + 1)
+      hit.position = ROOT.Math.XYZVector(event, i, 0.)
+      calos.push_back(hit)
+      hits.append(hit)
+    tree.Fill()
+  output.Write()
+  output.Close()
+
+
+def run(num_events, num_parallel):
+  import DDDigi
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+
+  reader = DDDigi.EventAction(kernel, 'DigiROOTInput/input_01')
+  reader.Input = [str(input_file)]
+  reader.Prefetch = 2
+  reader.OutputLevel = DDDigi.OutputLevel.DEBUG
+  kernel.inputAction().adopt(reader)
+
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  kernel.run()
+
+
+def check(num_events, num_parallel):
+  write(num_events)
+  proc = subprocess.Popen([sys.executable, __file__, str(num_events), str(num_parallel), 'read'],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  output = proc.communicate()[0]
+  print(output)
+  if proc.returncode != 0:
+    print('+++ ROOT input test FAILED: the reader job failed with status %d' % (proc.returncode,))
+    sys.exit(1)
+  pattern = re.compile(r'Event:\s+(\d+) \(DigiROOTInput\) Collection (\w+): (\d+) deposits')
+  found = {}
+  for line in output.splitlines():
+    match = pattern.search(line)
+    if match:
+      found[(int(match.group(1)), match.group(2))] = int(match.group(3))
+  errors = 0
+  # The kernel numbers the events from 1: event N reads the input entry N-1
+  for event in range(1, num_events + 1):
+    for name, count in hit_counts(event - 1).items():
+      if found.get((event, name)) != count:
+        print('+++ Event %d collection %s: expected %d deposits, found %s' %
+              (event, name, count, found.get((event, name))))
+        errors += 1
+  if errors:
+    print('+++ ROOT input test FAILED: %d mismatches' % (errors,))
+    sys.exit(1)
+  print('+++ ROOT input test PASSED: deposits of %d events with %d parallel events' % (num_events, num_parallel))
+
+
+if __name__ == '__main__':
+  num_events = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+  num_parallel = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+  if len(sys.argv) > 3:
+    run(num_events, num_parallel)
+  else:
+    check(num_events, num_parallel)
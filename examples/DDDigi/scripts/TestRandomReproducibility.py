@@ -0,0 +1,101 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Check of the reproducible per-event random streams of DDDigi.
+#
+#  The input file of TestROOTInputCounts.py is read and random noise is
+#  added to all deposits. The job is run once with one event at a time
+#  and once with several events processed in parallel. The noisy energy
+#  sums of every event and collection must be identical.
+#
+#  Usage: python TestRandomReproducibility.py [number of events] [parallel events]
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import subprocess
+import TestROOTInputCounts
+
+# Separate input file: the tests may run concurrently
+TestROOTInputCounts.input_file = 'DDDigi_RandomStreams.root'
+
+
+def run(num_events, num_parallel):
+  import DDDigi
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+
+  reader = DDDigi.EventAction(kernel, 'DigiROOTInput/input_01')
+  reader.Input = [str(TestROOTInputCounts.input_file)]
+  kernel.inputAction().adopt(reader)
+
+  noise = DDDigi.EventAction(kernel, 'DigiRandomNoise/noise')
+  noise.Probability = 0.5
+  noise.Amplitude = 0.001
+  noise.OutputLevel = DDDigi.OutputLevel.DEBUG
+  kernel.eventAction().adopt(noise)
+
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  kernel.run()
+
+
+def energy_sums(num_events, num_parallel):
+  proc = subprocess.Popen([sys.executable, __file__, str(num_events), str(num_parallel), 'run'],
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  output = proc.communicate()[0]
+  print(output)
+  if proc.returncode != 0:
+    print('+++ Random stream test FAILED: the job with %d parallel events failed with status %d' %
+          (num_parallel, proc.returncode))
+    sys.exit(1)
+  pattern = re.compile(r'Event:\s+(\d+) \(DigiRandomNoise\) Collection (\w+): (\d+) deposits, energy sum: (\S+)')
+  sums = {}
+  for line in output.splitlines():
+    match = pattern.search(line)
+    if match:
+      sums[(int(match.group(1)), match.group(2))] = (int(match.group(3)), match.group(4))
+  return sums
+
+
+def check(num_events, num_parallel):
+  TestROOTInputCounts.write(num_events)
+  sequential = energy_sums(num_events, 1)
+  parallel = energy_sums(num_events, num_parallel)
+  errors = 0 if sequential else 1
+  # The kernel numbers the events from 1: event N reads the input entry N-1
+  for event in range(1, num_events + 1):
+    for name in TestROOTInputCounts.hit_counts(event - 1).keys():
+      key = (event, name)
+      if sequential.get(key) != parallel.get(key):
+        print('+++ Event %d collection %s: sequential: %s parallel: %s' %
+              (event, name, str(sequential.get(key)), str(parallel.get(key))))
+        errors += 1
+  if errors:
+    print('+++ Random stream test FAILED: %d mismatches' % (errors,))
+    sys.exit(1)
+  print('+++ Random stream test PASSED: identical noise of %d events with 1 and %d parallel events' %
+        (num_events, num_parallel))
+
+
+if __name__ == '__main__':
+  num_events = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+  num_parallel = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+  if len(sys.argv) > 3:
+    run(num_events, num_parallel)
+  else:
+    check(num_events, num_parallel)
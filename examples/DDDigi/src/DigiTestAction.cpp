@@ -39,6 +39,14 @@ namespace dd4hep {
     protected:
       /// Sleep period to fake execution [milliseconds]
       int m_sleep = 0;
+      /// Names of the event data items required by the action
+      std::vector<std::string> m_inputs;
+      /// Names of the event data items produced by the action
+      std::vector<std::string> m_outputs;
+      /// Slots of the required data items
+      std::vector<DigiSlot<int> > m_inputSlots;
+      /// Slots of the produced data items
+      std::vector<DigiSlot<int> > m_outputSlots;
     protected:
       /// Define standard assignments and constructors
       DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiTestAction);
@@ -48,6 +56,8 @@ namespace dd4hep {
       DigiTestAction(const DigiKernel& kernel, const std::string& nam);
       /// Default destructor
       virtual ~DigiTestAction();
+      /// Declare the event data slots
+      virtual void initialize()  override;
       /// Callback to read event input
       virtual void execute(DigiContext& context)  const override;
     };
@@ -91,7 +101,9 @@ DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiTestAction)
 DigiTestAction::DigiTestAction(const DigiKernel& kernel, const string& nam)
   : DigiEventAction(kernel, nam)
 {
-  declareProperty("sleep", m_sleep = 0);
+  declareProperty("sleep",   m_sleep = 0);
+  declareProperty("inputs",  m_inputs);
+  declareProperty("outputs", m_outputs);
   InstanceCount::increment(this);
 }
 
@@ -100,9 +112,26 @@ DigiTestAction::~DigiTestAction() {
   InstanceCount::decrement(this);
 }
 
+/// Declare the event data slots
+void DigiTestAction::initialize()   {
+  m_inputSlots.clear();
+  m_outputSlots.clear();
+  for( const auto& n : m_inputs )
+    m_inputSlots.emplace_back(declareInput<int>(n));
+  for( const auto& n : m_outputs )
+    m_outputSlots.emplace_back(declareOutput<int>(n));
+}
+
 /// Pre-track action callback
 void DigiTestAction::execute(DigiContext& context)  const   {
+  DigiEvent& event = context.event();
   debug("+++ Event: %8d (DigiTestAction)  %d msec",
-       context.event().eventNumber, m_sleep);
+       event.eventNumber, m_sleep);
+  for( size_t i = 0; i < m_inputSlots.size(); ++i )   {
+    if ( !event.contains(m_inputSlots[i]) || event.get(m_inputSlots[i]) != event.eventNumber )
+      except("+++ Event: %8d Input %s is not present.", event.eventNumber, m_inputs[i].c_str());
+  }
   if ( m_sleep > 0 ) ::usleep(1000*m_sleep);
+  for( const auto& slot : m_outputSlots )
+    event.put(slot, int(event.eventNumber));
 }
@@ -0,0 +1,94 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/*
+   Plugin invocation:
+   ==================
+   The plugin DD4hep_PersistencyExample_add_extension is called from the
+   <plugins> section of the compact description while it is built.
+   It attaches a calorimeter data extension to the detector element
+   given as argument.
+
+   The check is invoked like a main program:
+
+   geoPluginRun -input <compact file> \
+                -plugin DD4hep_PersistencyExample_check_extension <detector name>
+
+   Test that extensions with ROOT dictionary are restored together
+   with a detector description loaded from the geometry cache.
+
+*/
+// Framework include files
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+#include "DDRec/DetectorData.h"
+
+using namespace std;
+using namespace dd4hep;
+
+namespace {
+  /// Layer distance of layer i of the test extension
+  double layer_distance(size_t i)   {   return 100e0 + 10e0*i;   }
+  /// Name of the detector element from the plugin arguments
+  DetElement detector(Detector& description, int argc, char** argv)  {
+    if ( argc < 1 || !argv[0] )  {
+      except("Example","+++ No detector name given.");
+    }
+    return description.detector(argv[0]);
+  }
+}
+
+/// Plugin function: attach a calorimeter data extension to a detector element
+/**
+ *  Factory: DD4hep_PersistencyExample_add_extension
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    18/10/2026
+ */
+static int add_extension (Detector& description, int argc, char** argv)  {
+  DetElement de = detector(description, argc, argv);
+  rec::LayeredCalorimeterData* data = new rec::LayeredCalorimeterData;
+  data->layoutType = rec::LayeredCalorimeterData::BarrelLayout;
+  for( size_t i = 0; i < 5; ++i )   {
+    rec::LayeredCalorimeterData::Layer layer;
+    layer.distance = layer_distance(i);
+    data->layers.push_back(layer);
+  }
+  de.addExtension<rec::LayeredCalorimeterData>(data);
+  printout(INFO,"Example","+++ Added calorimeter data with %ld layers to %s.",
+           data->layers.size(), de.path().c_str());
+  return 1;
+}
+
+/// Plugin function: check the calorimeter data extension of a detector element
+/**
+ *  Factory: DD4hep_PersistencyExample_check_extension
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    18/10/2026
+ */
+static int check_extension (Detector& description, int argc, char** argv)  {
+  DetElement de = detector(description, argc, argv);
+  const rec::LayeredCalorimeterData* data = de.extension<rec::LayeredCalorimeterData>(false);
+  bool ok = data && data->layoutType == rec::LayeredCalorimeterData::BarrelLayout && data->layers.size() == 5;
+  for( size_t i = 0; ok && i < data->layers.size(); ++i )
+    ok = data->layers[i].distance == layer_distance(i);
+  printout(ALWAYS,"Example","+++ %s Calorimeter data extension of %s.",
+           ok ? "PASSED" : "FAILED", de.path().c_str());
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_PersistencyExample_add_extension,add_extension)
+DECLARE_APPLY(DD4hep_PersistencyExample_check_extension,check_extension)